@@ -0,0 +1,303 @@
+/**
+ * @file Benchmark.hpp
+ * @author fugu133
+ * @brief ベンチマーク用の簡易ハーネス
+ * @details Google Benchmark に近い書き方で計測ループを記述できる最小限の実装.
+ *          反復回数は最小計測時間に達するまで自動で増やす
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace satfind::bench {
+
+/**
+ * @brief 最適化による計算の除去を防ぐ
+ *
+ * @param value 保持する値
+ */
+template <class T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void* sink;
+	sink = &value;
+#endif
+}
+
+/**
+ * @brief 計測ループの状態
+ * @note for (auto _ : state) { ... } の形で使用する
+ */
+class State {
+  public:
+	explicit State(std::int64_t iterations) : m_iterations(iterations), m_items(0), m_bytes(0) {}
+
+	class Iterator {
+	  public:
+		/**
+		 * @brief 反復ごとの値 (使用しない)
+		 * @note for (auto _ : state) の _ が未使用変数の警告にならないよう, 型に [[maybe_unused]] を付け構築子を定義する
+		 */
+		struct [[maybe_unused]] Value {
+			Value() {}
+		};
+
+		explicit Iterator(std::int64_t remaining) : m_remaining(remaining) {}
+		auto operator*() const -> Value { return Value(); }
+		auto operator++() -> Iterator& {
+			m_remaining--;
+			return *this;
+		}
+		auto operator!=(const Iterator&) const -> bool { return m_remaining > 0; }
+
+	  private:
+		std::int64_t m_remaining;
+	};
+
+	auto begin() -> Iterator {
+		m_start = std::chrono::steady_clock::now();
+		return Iterator(m_iterations);
+	}
+
+	auto end() -> Iterator {
+		m_stop_pending = true;
+		return Iterator(0);
+	}
+
+	auto iterations() const -> std::int64_t { return m_iterations; }
+
+	/**
+	 * @brief 1反復あたりではなく総処理件数を設定する (items/s の算出に使用)
+	 */
+	void setItemsProcessed(std::int64_t items) { m_items = items; }
+
+	/**
+	 * @brief 総処理バイト数を設定する (bytes/s の算出に使用)
+	 */
+	void setBytesProcessed(std::int64_t bytes) { m_bytes = bytes; }
+
+	auto itemsProcessed() const -> std::int64_t { return m_items; }
+	auto bytesProcessed() const -> std::int64_t { return m_bytes; }
+
+	void startTimer() { m_start = std::chrono::steady_clock::now(); }
+
+	void stopTimer() { m_elapsed += std::chrono::steady_clock::now() - m_start; }
+
+	/**
+	 * @brief 計測時間 [s]
+	 * @note 範囲for文を抜けた後に呼ぶこと
+	 */
+	auto elapsed() -> double {
+		if (m_stop_pending) {
+			stopTimer();
+			m_stop_pending = false;
+		}
+		return std::chrono::duration<double>(m_elapsed).count();
+	}
+
+  private:
+	std::int64_t m_iterations;
+	std::int64_t m_items;
+	std::int64_t m_bytes;
+	bool m_stop_pending = false;
+	std::chrono::steady_clock::time_point m_start;
+	std::chrono::steady_clock::duration m_elapsed{};
+};
+
+/**
+ * @brief 計測結果
+ *
+ */
+struct Result {
+	std::string name;
+	std::int64_t iterations;
+	double seconds;
+	double ns_per_iteration;
+	double items_per_second;
+	double bytes_per_second;
+};
+
+/**
+ * @brief ベンチマークの登録と実行
+ *
+ */
+class Registry {
+  public:
+	using Function = std::function<void(State&)>;
+
+	static auto instance() -> Registry& {
+		static Registry registry;
+		return registry;
+	}
+
+	auto add(std::string name, Function function) -> int {
+		m_entries.push_back({std::move(name), std::move(function)});
+		return 0;
+	}
+
+	/**
+	 * @brief コマンドライン引数を解釈して登録済みのベンチマークを実行する
+	 * @note --benchmark_filter=<部分文字列>, --benchmark_format=<console|json>, --benchmark_min_time=<秒>,
+	 *       --benchmark_out=<パス> (結果を JSON でファイルにも書き込む)
+	 *
+	 * @return int 終了コード
+	 */
+	auto run(int argc, char** argv) -> int {
+		std::string_view filter;
+		bool json = false;
+		double min_time = 0.5;
+		std::string out_path;
+
+		for (int i = 1; i < argc; i++) {
+			const std::string_view arg = argv[i];
+			if (startsWith(arg, "--benchmark_filter=")) {
+				filter = arg.substr(std::strlen("--benchmark_filter="));
+			} else if (arg == "--benchmark_format=json") {
+				json = true;
+			} else if (arg == "--benchmark_format=console") {
+				json = false;
+			} else if (startsWith(arg, "--benchmark_min_time=")) {
+				min_time = std::stod(std::string(arg.substr(std::strlen("--benchmark_min_time="))));
+			} else if (startsWith(arg, "--benchmark_out=")) {
+				out_path = arg.substr(std::strlen("--benchmark_out="));
+			} else {
+				std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+				return 1;
+			}
+		}
+
+		std::vector<Result> results;
+		for (const auto& entry : m_entries) {
+			if (!filter.empty() && entry.name.find(filter) == std::string::npos) {
+				continue;
+			}
+			results.push_back(measure(entry, min_time));
+			if (!json) {
+				printConsole(results.back());
+			}
+		}
+
+		if (json) {
+			printJson(stdout, argv[0], results);
+		}
+		if (!out_path.empty()) {
+			FILE* out = std::fopen(out_path.c_str(), "w");
+			if (out == nullptr) {
+				std::fprintf(stderr, "Cannot open file: %s\n", out_path.c_str());
+				return 1;
+			}
+			printJson(out, argv[0], results);
+			std::fclose(out);
+		}
+		return 0;
+	}
+
+  private:
+	struct Entry {
+		std::string name;
+		Function function;
+	};
+
+	std::vector<Entry> m_entries;
+
+	static auto startsWith(std::string_view str, std::string_view prefix) -> bool { return str.substr(0, prefix.size()) == prefix; }
+
+	static auto measure(const Entry& entry, double min_time) -> Result {
+		std::int64_t iterations = 1;
+		while (true) {
+			State state(iterations);
+			entry.function(state);
+			const double seconds = state.elapsed();
+
+			if (seconds >= min_time || iterations >= (std::int64_t{1} << 40)) {
+				Result result;
+				result.name = entry.name;
+				result.iterations = iterations;
+				result.seconds = seconds;
+				result.ns_per_iteration = seconds * 1e9 / static_cast<double>(iterations);
+				result.items_per_second = seconds > 0.0 ? static_cast<double>(state.itemsProcessed()) / seconds : 0.0;
+				result.bytes_per_second = seconds > 0.0 ? static_cast<double>(state.bytesProcessed()) / seconds : 0.0;
+				return result;
+			}
+
+			// 目標時間に届くよう反復回数を見積もる (一度に増やしすぎない)
+			const double scale = seconds > 0.0 ? std::min(min_time * 1.4 / seconds, 10.0) : 10.0;
+			iterations = std::max(iterations + 1, static_cast<std::int64_t>(static_cast<double>(iterations) * scale));
+		}
+	}
+
+	static void printConsole(const Result& r) {
+		std::printf("%-48s %14.1f ns %12lld", r.name.c_str(), r.ns_per_iteration, static_cast<long long>(r.iterations));
+		if (r.items_per_second > 0.0) {
+			std::printf(" %12.3f M items/s", r.items_per_second * 1e-6);
+		}
+		if (r.bytes_per_second > 0.0) {
+			std::printf(" %10.3f MB/s", r.bytes_per_second * 1e-6);
+		}
+		std::printf("\n");
+	}
+
+	/**
+	 * @brief Google Benchmark の JSON 出力と同じ形式で結果を書き込む
+	 * @note 比較ツールで回帰を追跡できるよう, 実行日時・CPU数・ビルド種別を context に含める
+	 */
+	static void printJson(FILE* out, const char* executable, const std::vector<Result>& results) {
+		char date[32];
+		const std::time_t now = std::time(nullptr);
+		std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+#ifdef NDEBUG
+		const char* build_type = "release";
+#else
+		const char* build_type = "debug";
+#endif
+		std::fprintf(out,
+					 "{\n  \"context\": {\"date\": \"%s\", \"executable\": \"%s\", \"num_cpus\": %u, \"library_build_type\": \"%s\"},\n",
+					 date, executable, std::thread::hardware_concurrency(), build_type);
+		std::fprintf(out, "  \"benchmarks\": [\n");
+		for (std::size_t i = 0; i < results.size(); i++) {
+			const auto& r = results[i];
+			std::fprintf(out, "    {\"name\": \"%s\", \"iterations\": %lld, \"real_time\": %.3f, \"time_unit\": \"ns\", "
+						 "\"items_per_second\": %.3f, \"bytes_per_second\": %.3f}%s\n",
+						 r.name.c_str(), static_cast<long long>(r.iterations), r.ns_per_iteration, r.items_per_second, r.bytes_per_second,
+						 i + 1 < results.size() ? "," : "");
+		}
+		std::fprintf(out, "  ]\n}\n");
+	}
+};
+
+} // namespace satfind::bench
+
+#define SATFIND_BENCH_CONCAT_IMPL(a, b) a##b
+#define SATFIND_BENCH_CONCAT(a, b) SATFIND_BENCH_CONCAT_IMPL(a, b)
+
+/**
+ * @brief ベンチマーク関数を登録する
+ * @note void func(satfind::bench::State&) を登録する
+ */
+#define SATFIND_BENCHMARK(func)                                                                                  \
+	[[maybe_unused]] static const int SATFIND_BENCH_CONCAT(satfind_bench_registered_, __LINE__) = \
+	  ::satfind::bench::Registry::instance().add(#func, func)
+
+/**
+ * @brief 登録済みのベンチマークを実行する main 関数を定義する
+ */
+#define SATFIND_BENCHMARK_MAIN()                                                                      \
+	int main(int argc, char** argv) { return ::satfind::bench::Registry::instance().run(argc, argv); }
@@ -0,0 +1,201 @@
+/**
+ * @file Core.cpp
+ * @author fugu133
+ * @brief 基本処理のベンチマーク
+ * @details TLE の解析, 軌道要素の変換, 伝搬器の初期化, SGP4/SDP4 の1回あたりの伝搬, 座標変換, 観測方向, 太陽・月の位置, および
+ *          IssObserve と同じ総当たりのパス計算を計測する. 最適化の効果と性能の退行を追跡するため, 入力は Vallado らの検証用 TLE
+ *          (sgp4-ver.tle) の一部に固定する. --benchmark_format=json または --benchmark_out=<パス> で JSON を出力する
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <SatFind/Core>
+
+#include "Benchmark.hpp"
+
+using namespace satfind;
+
+namespace {
+
+/**
+ * @brief 検証用の TLE
+ * @ref Vallado, D. A., et al., Revisiting Spacetrack Report #3, AIAA 2006-6753, 2006.
+ */
+struct ReferenceTle {
+	const char* name;
+	const char* line1;
+	const char* line2;
+};
+
+/* 低軌道 (SGP4), 離心率 0.186 */
+constexpr ReferenceTle near_earth = {"00005", "1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753",
+									 "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667"};
+
+/* 低軌道 (SGP4), 近地点高度が低く大気抵抗の高次項を省略する */
+constexpr ReferenceTle low_perigee = {"06251", "1 06251U 62025E   06176.82412014  .00008885  00000-0  12808-3 0  3985",
+									  "2 06251  58.0579  54.0425 0030035 139.1568 221.1854 15.56387291  6774"};
+
+/* 深宇宙 (SDP4), 共鳴なし (GPS) */
+constexpr ReferenceTle non_resonant = {"28129", "1 28129U 03058A   06175.57071136 -.00000104  00000-0  10000-3 0   459",
+									   "2 28129  54.7298 324.8098 0048506 266.2640  93.1663  2.00562768 18443"};
+
+/* 深宇宙 (SDP4), 半日周期の共鳴 (モルニア) */
+constexpr ReferenceTle half_day_resonant = {"08195", "1 08195U 75081A   06176.33215444  .00000099  00000-0  11873-3 0   813",
+											"2 08195  64.1586 279.0717 6877146 264.7651  20.2257  2.00491383225656"};
+
+/* 深宇宙 (SDP4), 1日周期の共鳴 (静止軌道) */
+constexpr ReferenceTle synchronous = {"28626", "1 28626U 05008A   06176.46683397 -.00000205  00000-0  10000-3 0  2190",
+									  "2 28626   0.0019 286.9433 0000335  13.7918  55.6504  1.00270176  4891"};
+
+auto makeTle(const ReferenceTle& tle) -> Tle { return Tle::parse(tle.name, tle.line1, tle.line2); }
+
+const Tle iss("ISS (ZARYA)", "1 25544U 98067A   24018.43698023  .00021385  00000+0  38757-3 0  9991",
+			  "2 25544  51.6427 342.3169 0004949 101.3994  45.6784 15.49554946435174");
+
+const GroundObserver observer(Wgs84Position{Dms{138, 21, 8}, Dms{36, 8, 28}, 1612.75}); // IssObserve と同じ地上局
+
+constexpr int minutes_per_week = 7 * 1440;
+
+/**
+ * @brief 元期から1分ずつ1週間分の時刻で伝搬する
+ * @note 深宇宙の共鳴軌道は前回の積分結果から続けて積分するため, 時刻を単調に進めて実際の使い方に近づける
+ */
+auto propagateEachMinute(bench::State& state, const ReferenceTle& reference) -> void {
+	const Tle tle = makeTle(reference);
+	OrbitalPropagator propagator(tle);
+	int minute = 0;
+	for (auto _ : state) {
+		bench::doNotOptimize(propagator.trackFlightObject(Minutes(minute)));
+		minute = minute + 1 < minutes_per_week ? minute + 1 : 0;
+	}
+	state.setItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+void BM_Tle_Parse(bench::State& state) {
+	for (auto _ : state) {
+		bench::doNotOptimize(makeTle(near_earth));
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Tle_Parse);
+
+void BM_OrbitalElements_FromTle(bench::State& state) {
+	const Tle tle = makeTle(near_earth);
+	for (auto _ : state) {
+		OrbitalElements elements(tle);
+		bench::doNotOptimize(elements);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_OrbitalElements_FromTle);
+
+void BM_Propagator_Construct_Sgp4(bench::State& state) {
+	const Tle tle = makeTle(near_earth);
+	for (auto _ : state) {
+		OrbitalPropagator propagator(tle);
+		bench::doNotOptimize(propagator);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Propagator_Construct_Sgp4);
+
+void BM_Propagator_Construct_Sdp4(bench::State& state) {
+	const Tle tle = makeTle(half_day_resonant);
+	for (auto _ : state) {
+		OrbitalPropagator propagator(tle);
+		bench::doNotOptimize(propagator);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Propagator_Construct_Sdp4);
+
+void BM_Sgp4_NearEarth(bench::State& state) { propagateEachMinute(state, near_earth); }
+SATFIND_BENCHMARK(BM_Sgp4_NearEarth);
+
+void BM_Sgp4_LowPerigee(bench::State& state) { propagateEachMinute(state, low_perigee); }
+SATFIND_BENCHMARK(BM_Sgp4_LowPerigee);
+
+void BM_Sdp4_NonResonant(bench::State& state) { propagateEachMinute(state, non_resonant); }
+SATFIND_BENCHMARK(BM_Sdp4_NonResonant);
+
+void BM_Sdp4_HalfDayResonant(bench::State& state) { propagateEachMinute(state, half_day_resonant); }
+SATFIND_BENCHMARK(BM_Sdp4_HalfDayResonant);
+
+void BM_Sdp4_Synchronous(bench::State& state) { propagateEachMinute(state, synchronous); }
+SATFIND_BENCHMARK(BM_Sdp4_Synchronous);
+
+void BM_Eci_ToWgs84(bench::State& state) {
+	const auto states = OrbitalPropagator(iss).trackFlightObject(TimeGrid(iss.epoch(), Minutes(1), 1440));
+	std::size_t i = 0;
+	for (auto _ : state) {
+		const Eci eci(DateTime(states[i].ticks), states[i].position);
+		bench::doNotOptimize(eci.toWgs84());
+		i = i + 1 < states.size() ? i + 1 : 0;
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Eci_ToWgs84);
+
+void BM_GroundObserver_LookUpPosition(bench::State& state) {
+	const auto states = OrbitalPropagator(iss).trackFlightObject(TimeGrid(iss.epoch(), Minutes(1), 1440));
+	std::size_t i = 0;
+	for (auto _ : state) {
+		const Eci eci(DateTime(states[i].ticks), states[i].position);
+		bench::doNotOptimize(observer.lookUpPosition(eci));
+		i = i + 1 < states.size() ? i + 1 : 0;
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_GroundObserver_LookUpPosition);
+
+void BM_SunPosition(bench::State& state) {
+	DateTime dt = iss.epoch();
+	for (auto _ : state) {
+		SunPosition sun(dt);
+		bench::doNotOptimize(sun);
+		dt += Minutes(1);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_SunPosition);
+
+void BM_MoonPosition(bench::State& state) {
+	DateTime dt = iss.epoch();
+	for (auto _ : state) {
+		MoonPosition moon(dt);
+		bench::doNotOptimize(moon);
+		dt += Minutes(1);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_MoonPosition);
+
+/* IssObserve と同じ総当たりのパス計算 (1秒刻みで1日分) */
+void BM_IssObserve_PassLoop(bench::State& state) {
+	constexpr int seconds_per_day = 86400;
+	const auto min_elevation = Degree{15};
+	const auto max_elevation = Degree{80};
+
+	OrbitalPropagator propagator(iss);
+	int passes = 0;
+	for (auto _ : state) {
+		bool in_pass = false;
+		const DateTime end = iss.epoch() + Days(1);
+		for (auto dt = iss.epoch(); dt < end; dt += Seconds(1)) {
+			const auto view = observer.lookUpPosition(propagator.trackFlightObject(dt).position);
+			const bool visible = view.elevation() >= min_elevation && view.elevation() <= max_elevation;
+			passes += !in_pass && visible;
+			in_pass = visible;
+		}
+		bench::doNotOptimize(passes);
+	}
+	state.setItemsProcessed(state.iterations() * seconds_per_day);
+}
+SATFIND_BENCHMARK(BM_IssObserve_PassLoop);
+
+SATFIND_BENCHMARK_MAIN();
@@ -0,0 +1,306 @@
+/**
+ * @file DateTimeIo.cpp
+ * @author fugu133
+ * @brief DateTime の ISO8601 入出力のベンチマーク
+ * @details DateTime::parse / DateTime::format と, 従来の stringstream / substr を用いた実装を比較する
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <SatFind/Core>
+
+#include "Benchmark.hpp"
+
+using namespace satfind;
+
+namespace legacy {
+
+/**
+ * @brief 比較用: 従来の DateTime の文字列入出力 (stringstream / substr)
+ * @note 以前の DateTime の initialize(const std::string&), iso8601BlocktoInt, iso8601BlocktoDecimal, pushDate, toString を
+ *       そのまま写したもの. 日時の検証とティック数の計算は現在の DateTime の構築子で行う
+ */
+class DateTimeText {
+  public:
+	DateTimeText(const std::string& date_time) { initialize(date_time); }
+
+	DateTimeText(std::int64_t ticks) : m_ticks(ticks) {}
+
+	auto ticks() const -> std::int64_t { return m_ticks; }
+
+	int hour() const { return static_cast<int>(m_ticks % constant::ticks_per_day / constant::ticks_per_hour); }
+
+	int minute() const { return static_cast<int>(m_ticks % constant::ticks_per_hour / constant::ticks_per_minute); }
+
+	int second() const { return static_cast<int>(m_ticks % constant::ticks_per_minute / constant::ticks_per_second); }
+
+	int microsecond() const { return static_cast<int>(m_ticks % constant::ticks_per_second / constant::ticks_per_microsecond); }
+
+	auto toString() const -> std::string {
+		std::stringstream ss;
+		int year, month, day;
+		pushDate(year, month, day);
+		ss << std::setfill('0') << std::setw(4) << year << "-" << std::setw(2) << month << "-" << std::setw(2) << day << "T" << std::setw(2)
+		   << hour() << ":" << std::setw(2) << minute() << ":" << std::setw(2) << second() << "." << std::setw(6) << microsecond() << "Z";
+		return ss.str();
+	}
+
+	auto pushDate(int& year, int& month, int& day) const -> void {
+		int total_days = static_cast<int>(m_ticks / constant::ticks_per_day);
+
+		// 年
+		{
+			// 4世紀単位の数
+			int num_4cent = total_days / 146097;
+			total_days -= num_4cent * 146097;
+
+			// 1世紀単位の数
+			int num_1cent = total_days / 36524;
+			if (num_1cent == 4) {
+				// 閏世紀末日
+				num_1cent = 3;
+			}
+			total_days -= num_1cent * 36524;
+
+			// 4年単位の数
+			int num_4year = total_days / 1461;
+			total_days -= num_4year * 1461;
+
+			// 1年単位の数
+			int num_year = total_days / 365;
+			if (num_year == 4) {
+				/*
+				 * 閏年末日
+				 */
+				num_year = 3;
+			}
+			total_days -= num_year * 365;
+
+			year = (num_4cent * 400) + (num_1cent * 100) + (num_4year * 4) + num_year + 1;
+		}
+
+		// 月
+		{
+			const auto& dyas_in_mounth = constant::dyas_in_mounth[isLeapYear(year)];
+			month = 1;
+			while (total_days >= dyas_in_mounth[month] && month <= 12) {
+				total_days -= dyas_in_mounth[month++];
+			}
+		}
+
+		// 日
+		day = total_days + 1;
+	}
+
+  private:
+	std::int64_t m_ticks;
+
+	auto isLeapYear(int year) const -> bool { return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0; }
+
+	auto initialize(int year, int month, int day, int hour, int minute, int second, int microsecond) -> void {
+		m_ticks = DateTime(year, month, day, hour, minute, second, microsecond).ticks();
+	}
+
+	auto initialize(const std::string& date_time) -> void {
+		std::int32_t year, month, day, hour, minute, second, microsecond;
+		year = iso8601BlocktoInt(date_time, 0, 4);
+		month = iso8601BlocktoInt(date_time, 5, 7);
+		day = iso8601BlocktoInt(date_time, 8, 10);
+		if (date_time.length() <= 10) {
+			initialize(year, month, day, 0, 0, 0, 0);
+		} else {
+			hour = iso8601BlocktoInt(date_time, 11, 13);
+			minute = iso8601BlocktoInt(date_time, 14, 16);
+
+			std::string sec_tz = date_time.substr(17);
+
+			// タイムゾーンの位置を探す
+			std::size_t tz_pos = 0;
+			while (tz_pos < sec_tz.length()) {
+				if (sec_tz[tz_pos] == 'Z' || sec_tz[tz_pos] == '+' || sec_tz[tz_pos] == '-') {
+					break;
+				}
+				tz_pos++;
+			}
+
+			iso8601BlocktoDecimal(sec_tz, 0, tz_pos - 1, second, microsecond);
+
+			if (tz_pos == sec_tz.length()) {
+				initialize(year, month, day, hour, minute, second, microsecond);
+			} else {
+				std::string tz = sec_tz.substr(tz_pos);
+				if (tz[0] == 'Z' || tz == "+00:00" || tz == "-00:00" || tz == "UTC" || tz == "GMT") {
+					initialize(year, month, day, hour, minute, second, microsecond);
+				} else {
+					int tz_hour = iso8601BlocktoInt(tz, 1, 3);
+					int tz_minute = iso8601BlocktoInt(tz, 4, 6);
+					initialize(year, month, day, hour, minute, second, microsecond);
+					if (tz[0] == '-') {
+						m_ticks += TimeSpan(tz_hour, tz_minute, 0).ticks();
+					} else {
+						m_ticks -= TimeSpan(tz_hour, tz_minute, 0).ticks();
+					}
+				}
+			}
+		}
+	}
+
+	auto iso8601BlocktoInt(const std::string& str, int begin, int end) const -> int {
+		int value = 0;
+		for (int i = begin; i < end; i++) {
+			if (str[i] < '0' || str[i] > '9') {
+				throw DateTimeException("Invalid integer string", DateTimeException::InvalidIso8601Format);
+			}
+			value = value * 10 + (str[i] - '0');
+		}
+		return value;
+	}
+
+	auto iso8601BlocktoDecimal(const std::string& str, int begin, int end, int& integer, int& decimal) const -> double {
+		double ret = 0;
+		std::int32_t div = 1;
+		std::int32_t decimal_point_pos = begin;
+
+		while (decimal_point_pos <= end) {
+			if (str[decimal_point_pos] == '.') {
+				break;
+			}
+			decimal_point_pos++;
+		}
+
+		integer = iso8601BlocktoInt(str, begin, decimal_point_pos);
+		decimal = 0;
+
+		if (decimal_point_pos < end) {
+			decimal = iso8601BlocktoInt(str, decimal_point_pos + 1, end + 1);
+			for (int i = decimal_point_pos + 1; i <= end; i++) {
+				div *= 10;
+			}
+		}
+
+		ret = static_cast<double>(integer) + static_cast<double>(decimal) / static_cast<double>(div);
+
+		decimal = decimal * (1000'000 / div);
+
+		return ret;
+	}
+};
+
+auto parse(const std::string& date_time) -> DateTime { return DateTime(DateTimeText(date_time).ticks()); }
+
+auto toString(const DateTime& dt) -> std::string { return DateTimeText(dt.ticks()).toString(); }
+
+auto pushDate(const DateTime& dt, int& year, int& month, int& day) -> void { DateTimeText(dt.ticks()).pushDate(year, month, day); }
+
+} // namespace legacy
+
+namespace {
+
+constexpr std::size_t sample_count = 4096;
+
+auto makeSamples() -> std::vector<DateTime> {
+	std::vector<DateTime> samples;
+	samples.reserve(sample_count);
+	auto dt = DateTime(2024, 1, 1, 0, 0, 0, 0);
+	for (std::size_t i = 0; i < sample_count; i++) {
+		samples.push_back(dt);
+		dt += TimeSpan(0, 3, 17, 23, 123457);
+	}
+	return samples;
+}
+
+auto makeStrings() -> std::vector<std::string> {
+	std::vector<std::string> strings;
+	for (const auto& dt : makeSamples()) {
+		char buf[DateTime::iso8601_length];
+		strings.emplace_back(buf, dt.format(buf));
+	}
+	return strings;
+}
+
+const auto samples = makeSamples();
+const auto strings = makeStrings();
+
+} // namespace
+
+void BM_Format_Legacy(bench::State& state) {
+	std::size_t i = 0;
+	for (auto _ : state) {
+		auto str = legacy::toString(samples[i++ % sample_count]);
+		bench::doNotOptimize(str);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Format_Legacy);
+
+void BM_Format_ToString(bench::State& state) {
+	std::size_t i = 0;
+	for (auto _ : state) {
+		auto str = samples[i++ % sample_count].toString();
+		bench::doNotOptimize(str);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Format_ToString);
+
+void BM_Format_Buffer(bench::State& state) {
+	char buf[DateTime::iso8601_length];
+	std::size_t i = 0;
+	for (auto _ : state) {
+		samples[i++ % sample_count].format(buf);
+		bench::doNotOptimize(buf);
+	}
+	state.setItemsProcessed(state.iterations());
+	state.setBytesProcessed(state.iterations() * DateTime::iso8601_length);
+}
+SATFIND_BENCHMARK(BM_Format_Buffer);
+
+void BM_Parse_Legacy(bench::State& state) {
+	std::size_t i = 0;
+	for (auto _ : state) {
+		auto dt = legacy::parse(strings[i++ % sample_count]);
+		bench::doNotOptimize(dt);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Parse_Legacy);
+
+void BM_Parse_StringView(bench::State& state) {
+	std::size_t i = 0;
+	for (auto _ : state) {
+		auto dt = DateTime::parse(strings[i++ % sample_count]);
+		bench::doNotOptimize(dt);
+	}
+	state.setItemsProcessed(state.iterations());
+	state.setBytesProcessed(state.iterations() * DateTime::iso8601_length);
+}
+SATFIND_BENCHMARK(BM_Parse_StringView);
+
+void BM_Calendar_Legacy(bench::State& state) {
+	std::size_t i = 0;
+	int year, month, day;
+	for (auto _ : state) {
+		legacy::pushDate(samples[i++ % sample_count], year, month, day);
+		bench::doNotOptimize(year);
+		bench::doNotOptimize(month);
+		bench::doNotOptimize(day);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Calendar_Legacy);
+
+void BM_Calendar_CivilFromDays(bench::State& state) {
+	std::size_t i = 0;
+	for (auto _ : state) {
+		const auto& dt = samples[i++ % sample_count];
+		const int day = dt.day();
+		bench::doNotOptimize(day);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Calendar_CivilFromDays);
+
+SATFIND_BENCHMARK_MAIN();
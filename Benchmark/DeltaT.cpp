@@ -0,0 +1,69 @@
+/**
+ * @file DeltaT.cpp
+ * @author fugu133
+ * @brief ΔT の取得のベンチマーク
+ * @details 表の補間 (DateTime::deltaT) と, 年月を求めて多項式を評価する従来の方法を比較する
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <SatFind/Core>
+
+#include "Benchmark.hpp"
+
+using namespace satfind;
+
+namespace {
+
+constexpr std::size_t sample_count = 4096;
+
+auto makeSamples() -> std::vector<DateTime> {
+	std::vector<DateTime> samples;
+	samples.reserve(sample_count);
+	auto dt = DateTime(1950, 1, 1, 0, 0, 0, 0);
+	for (std::size_t i = 0; i < sample_count; i++) {
+		samples.push_back(dt);
+		dt += TimeSpan(3, 7, 11, 13);
+	}
+	return samples;
+}
+
+const auto samples = makeSamples();
+
+} // namespace
+
+void BM_DeltaT_Polynomial(bench::State& state) {
+	std::size_t i = 0;
+	for (auto _ : state) {
+		const auto& dt = samples[i++ % sample_count];
+		double delta_t = DeltaT::polynomial(dt.year() + (dt.month() - 0.5) / 12.0);
+		bench::doNotOptimize(delta_t);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_DeltaT_Polynomial);
+
+void BM_DeltaT_Table(bench::State& state) {
+	std::size_t i = 0;
+	for (auto _ : state) {
+		auto delta_t = samples[i++ % sample_count].deltaT();
+		bench::doNotOptimize(delta_t);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_DeltaT_Table);
+
+void BM_SunPosition(bench::State& state) {
+	std::size_t i = 0;
+	for (auto _ : state) {
+		SunPosition sun(samples[i++ % sample_count]);
+		bench::doNotOptimize(sun);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_SunPosition);
+
+SATFIND_BENCHMARK_MAIN();
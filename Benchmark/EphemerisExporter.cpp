@@ -0,0 +1,88 @@
+/**
+ * @file EphemerisExporter.cpp
+ * @author fugu133
+ * @brief OEM / SP3 出力のベンチマーク
+ * @details 衛星ごとに1点ずつ伝搬して CartesianOrbitalElements::toString で書き出す方法と, EphemerisExporter の並列出力を比較する
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <SatFind/Core>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+#include "Benchmark.hpp"
+
+using namespace satfind;
+
+namespace {
+
+constexpr int object_count = 32;
+constexpr std::size_t epoch_count = 1440;
+
+auto makeCatalog() -> SatelliteCatalog {
+	const Tle base("ISS (ZARYA)", "1 25544U 98067A   24018.43698023  .00021385  00000+0  38757-3 0  9991",
+				   "2 25544  51.6427 342.3169 0004949 101.3994  45.6784 15.49554946435174");
+	std::vector<Tle> tles;
+	for (int i = 0; i < object_count; i++) {
+		OrbitalElements e(base);
+		TleMetadata m = TleMetadata::fromTle(base);
+		e.mean_anomaly = i * constant::pi2 / object_count;
+		m.catalog_number = 90000 + i;
+		tles.push_back(TleWriter::toTle("OBJECT " + std::to_string(i), e, m));
+	}
+	return SatelliteCatalog(tles);
+}
+
+const SatelliteCatalog catalog = makeCatalog();
+const TimeGrid grid(DateTime(2024, 1, 18, 0, 0, 0), TimeSpan(0, 0, 1, 0), epoch_count);
+
+const std::string out_path = "ephemeris_export_bench.out";
+
+auto exportWith(bench::State& state, bool sp3, std::size_t threads) -> void {
+	EphemerisExportOptions options;
+	options.threads = threads;
+	std::uint64_t bytes = 0;
+	for (auto _ : state) {
+		bytes = sp3 ? EphemerisExporter::writeSp3(out_path, catalog, grid, options)
+					: EphemerisExporter::writeOem(out_path, catalog, grid, options);
+	}
+	state.setItemsProcessed(state.iterations() * object_count * epoch_count);
+	state.setBytesProcessed(state.iterations() * bytes);
+	std::remove(out_path.c_str());
+}
+
+} // namespace
+
+/* 従来の方法: 1点ずつ伝搬し, toString で書き出す */
+void BM_Export_ToString(bench::State& state) {
+	for (auto _ : state) {
+		std::ofstream ofs(out_path);
+		for (SatelliteCatalog::Handle h = 0; h < catalog.size(); h++) {
+			for (const auto t : grid) {
+				ofs << catalog.propagator(h).trackFlightObject(t).toString() << "\n";
+			}
+		}
+	}
+	state.setItemsProcessed(state.iterations() * object_count * epoch_count);
+	std::remove(out_path.c_str());
+}
+SATFIND_BENCHMARK(BM_Export_ToString);
+
+void BM_Export_Oem_1Thread(bench::State& state) { exportWith(state, false, 1); }
+SATFIND_BENCHMARK(BM_Export_Oem_1Thread);
+
+void BM_Export_Oem(bench::State& state) { exportWith(state, false, 0); }
+SATFIND_BENCHMARK(BM_Export_Oem);
+
+void BM_Export_Sp3_1Thread(bench::State& state) { exportWith(state, true, 1); }
+SATFIND_BENCHMARK(BM_Export_Sp3_1Thread);
+
+void BM_Export_Sp3(bench::State& state) { exportWith(state, true, 0); }
+SATFIND_BENCHMARK(BM_Export_Sp3);
+
+SATFIND_BENCHMARK_MAIN();
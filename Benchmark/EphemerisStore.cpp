@@ -0,0 +1,99 @@
+/**
+ * @file EphemerisStore.cpp
+ * @author fugu133
+ * @brief エフェメリスファイルの検索・補間のベンチマーク
+ * @details 保存済みのエフェメリスからの時刻範囲の検索と補間を, 伝搬器で毎回計算する方法と比較する
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <SatFind/Core>
+#include <cstdio>
+
+#include "Benchmark.hpp"
+
+using namespace satfind;
+
+namespace {
+
+constexpr int object_count = 200;
+constexpr std::size_t sample_count = 1440;
+
+const std::string store_path = "ephemeris_store_bench.eph";
+
+const Tle tle("ISS (ZARYA)", "1 25544U 98067A   24018.43698023  .00021385  00000+0  38757-3 0  9991",
+			  "2 25544  51.6427 342.3169 0004949 101.3994  45.6784 15.49554946435174");
+const OrbitalPropagator propagator(tle);
+const TimeGrid grid(DateTime(2024, 1, 18, 0, 0, 0), TimeSpan(0, 0, 1, 0), sample_count);
+
+const auto store = [] {
+	EphemerisStore::Writer writer(store_path);
+	for (int i = 0; i < object_count; i++) {
+		writer.add(i + 1, "OBJECT", propagator, grid);
+	}
+	writer.finish();
+	EphemerisStore s(store_path);
+	std::remove(store_path.c_str()); // マップ済みの領域は削除後も有効
+	return s;
+}();
+
+/* 1日の中の任意の時刻 (刻み幅の整数倍でない) */
+auto sampleTime(std::size_t i) -> DateTime {
+	return DateTime(grid.start().ticks() + static_cast<std::int64_t>(i * 7919 % (sample_count - 1)) * 60000000 + 12345678);
+}
+
+} // namespace
+
+void BM_Store_Query(bench::State& state) {
+	std::size_t i = 0;
+	for (auto _ : state) {
+		const auto t = sampleTime(i);
+		const auto s = store.query(static_cast<int>(i++ % object_count) + 1, t, t + TimeSpan(0, 0, 15, 0));
+		bench::doNotOptimize(s.size());
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Store_Query);
+
+void BM_Store_Interpolate(bench::State& state) {
+	std::size_t i = 0;
+	for (auto _ : state) {
+		const auto s = store.series(i % object_count);
+		const auto e = s.interpolate(sampleTime(i++));
+		bench::doNotOptimize(e);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Store_Interpolate);
+
+/* 従来の方法: 時刻ごとに伝搬する */
+void BM_Store_Propagate(bench::State& state) {
+	std::size_t i = 0;
+	for (auto _ : state) {
+		const auto e = propagator.trackFlightObject(sampleTime(i++));
+		bench::doNotOptimize(e);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Store_Propagate);
+
+/* 1衛星分の位置の列を走査する */
+void BM_Store_ScanColumn(bench::State& state) {
+	std::size_t i = 0;
+	for (auto _ : state) {
+		const auto s = store.series(i++ % object_count);
+		double sum = 0;
+		for (const auto x : s.x()) {
+			sum += x;
+		}
+		bench::doNotOptimize(sum);
+	}
+	state.setItemsProcessed(state.iterations() * sample_count);
+	state.setBytesProcessed(state.iterations() * sample_count * sizeof(double));
+}
+SATFIND_BENCHMARK(BM_Store_ScanColumn);
+
+SATFIND_BENCHMARK_MAIN();
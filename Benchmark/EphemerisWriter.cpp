@@ -0,0 +1,90 @@
+/**
+ * @file EphemerisWriter.cpp
+ * @author fugu133
+ * @brief エフェメリス出力のベンチマーク
+ * @details 伝搬した状態を std::ofstream の operator<< で1行ずつ書き出す方法と, EphemerisWriter で伝搬と書き出しを並行させる
+ *          方法を比較する
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <SatFind/Core>
+#include <cstdio>
+#include <fstream>
+
+#include "Benchmark.hpp"
+
+using namespace satfind;
+
+namespace {
+
+constexpr std::size_t state_count = 100000;
+
+const Tle tle("ISS (ZARYA)", "1 25544U 98067A   24018.43698023  .00021385  00000+0  38757-3 0  9991",
+			  "2 25544  51.6427 342.3169 0004949 101.3994  45.6784 15.49554946435174");
+const OrbitalPropagator propagator(tle);
+const TimeGrid grid(DateTime(2024, 1, 18, 12, 0, 0), TimeSpan(0, 0, 0, 1), state_count);
+const auto states = OrbitalPropagator(tle).trackFlightObject(grid);
+const EphemerisSegment segment{"ISS (ZARYA)", "1998-067A", grid.start(), DateTime(grid.ticks().back())};
+
+const std::string out_path = "ephemeris_bench.out";
+
+auto writeWith(bench::State& state, EphemerisFormat format) -> void {
+	std::uint64_t bytes = 0;
+	for (auto _ : state) {
+		EphemerisWriter writer(out_path, format);
+		writer.beginSegment(segment);
+		writer.write(propagator, grid);
+		writer.close();
+		bytes = writer.bytesWritten();
+	}
+	state.setItemsProcessed(state.iterations() * state_count);
+	state.setBytesProcessed(state.iterations() * bytes);
+	std::remove(out_path.c_str());
+}
+
+} // namespace
+
+/* 従来の方法: 1点ずつ伝搬し, operator<< と std::endl で書き出す */
+void BM_Ephemeris_Ostream(bench::State& state) {
+	for (auto _ : state) {
+		std::ofstream ofs(out_path);
+		for (std::size_t i = 0; i < state_count; i++) {
+			const auto dt = grid.start() + TimeSpan(static_cast<std::int64_t>(i) * grid.step().ticks());
+			const auto e = propagator.trackFlightObject(dt);
+			const auto& r = e.position.elements();
+			const auto& v = e.velocity.elements();
+			ofs << dt << "," << r[0] << "," << r[1] << "," << r[2] << "," << v[0] << "," << v[1] << "," << v[2] << std::endl;
+		}
+	}
+	state.setItemsProcessed(state.iterations() * state_count);
+	std::remove(out_path.c_str());
+}
+SATFIND_BENCHMARK(BM_Ephemeris_Ostream);
+
+void BM_Ephemeris_Csv(bench::State& state) { writeWith(state, EphemerisFormat::Csv); }
+SATFIND_BENCHMARK(BM_Ephemeris_Csv);
+
+void BM_Ephemeris_Oem(bench::State& state) { writeWith(state, EphemerisFormat::Oem); }
+SATFIND_BENCHMARK(BM_Ephemeris_Oem);
+
+void BM_Ephemeris_Binary(bench::State& state) { writeWith(state, EphemerisFormat::Binary); }
+SATFIND_BENCHMARK(BM_Ephemeris_Binary);
+
+/* 整形のみ (伝搬と書き込みを含まない) */
+void BM_Ephemeris_FormatCsvRow(bench::State& state) {
+	char row[EphemerisWriter::max_row_length];
+	std::size_t i = 0;
+	for (auto _ : state) {
+		const auto n = EphemerisWriter::formatCsvRow(row, "1998-067A", states[i++ % state_count]);
+		bench::doNotOptimize(n);
+		bench::doNotOptimize(row);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Ephemeris_FormatCsvRow);
+
+SATFIND_BENCHMARK_MAIN();
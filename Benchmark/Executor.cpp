@@ -0,0 +1,127 @@
+/**
+ * @file Executor.cpp
+ * @author fugu133
+ * @brief 実行器による一括処理のベンチマーク
+ * @details カタログの初期化, 同時刻の伝搬, 時刻列の伝搬 (カタログと1つの伝搬器) を SerialExecutor と共有のスレッドプールで比較する.
+ *          スケーリングは作業者の数だけが異なる2つの結果の比から求める
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <SatFind/Core>
+
+#include "Benchmark.hpp"
+
+using namespace satfind;
+
+namespace {
+
+constexpr int object_count = 2000;
+constexpr std::size_t epoch_count = 1440;
+
+auto makeElements() -> std::vector<Tle> {
+	const Tle base("ISS (ZARYA)", "1 25544U 98067A   24018.43698023  .00021385  00000+0  38757-3 0  9991",
+				   "2 25544  51.6427 342.3169 0004949 101.3994  45.6784 15.49554946435174");
+	std::vector<Tle> tles;
+	for (int i = 0; i < object_count; i++) {
+		OrbitalElements e(base);
+		TleMetadata m = TleMetadata::fromTle(base);
+		e.mean_anomaly = i * constant::pi2 / object_count;
+		e.inclination = (30.0 + 60.0 * i / object_count) * constant::pi / 180.0;
+		m.catalog_number = 90000 + i;
+		tles.push_back(TleWriter::toTle("OBJECT " + std::to_string(i), e, m));
+	}
+	return tles;
+}
+
+const auto elements = makeElements();
+const SatelliteCatalog catalog(elements);
+const TimeGrid grid(DateTime(2024, 1, 18, 0, 0, 0), TimeSpan(0, 0, 1, 0), epoch_count);
+
+const auto handles = [] {
+	std::vector<SatelliteCatalog::Handle> h(catalog.size());
+	for (std::size_t i = 0; i < h.size(); i++) {
+		h[i] = static_cast<SatelliteCatalog::Handle>(i);
+	}
+	return h;
+}();
+
+SerialExecutor serial;
+
+auto build(bench::State& state, Executor& executor) -> void {
+	for (auto _ : state) {
+		SatelliteCatalog c(elements, executor);
+		bench::doNotOptimize(c.size());
+	}
+	state.setItemsProcessed(state.iterations() * object_count);
+}
+
+auto trackTime(bench::State& state, Executor& executor) -> void {
+	std::vector<StateVector> states(handles.size());
+	for (auto _ : state) {
+		catalog.trackFlightObject(handles, grid.start(), states.data(), executor);
+		bench::doNotOptimize(states.data());
+	}
+	state.setItemsProcessed(state.iterations() * object_count);
+}
+
+auto trackGrid(bench::State& state, Executor& executor) -> void {
+	const std::span<const SatelliteCatalog::Handle> subset(handles.data(), 200);
+	std::vector<StateVector> states(subset.size() * grid.size());
+	for (auto _ : state) {
+		catalog.trackFlightObject(subset, grid, states.data(), executor);
+		bench::doNotOptimize(states.data());
+	}
+	state.setItemsProcessed(state.iterations() * subset.size() * epoch_count);
+}
+
+auto trackPropagator(bench::State& state, Executor& executor) -> void {
+	const OrbitalPropagator propagator(elements.front());
+	std::vector<StateVector> states(grid.size());
+	for (auto _ : state) {
+		propagator.trackFlightObject(grid, states.data(), executor);
+		bench::doNotOptimize(states.data());
+	}
+	state.setItemsProcessed(state.iterations() * epoch_count);
+}
+
+} // namespace
+
+void BM_Executor_Build_Serial(bench::State& state) { build(state, serial); }
+SATFIND_BENCHMARK(BM_Executor_Build_Serial);
+
+void BM_Executor_Build_Pool(bench::State& state) { build(state, ThreadPool::shared()); }
+SATFIND_BENCHMARK(BM_Executor_Build_Pool);
+
+void BM_Executor_TrackTime_Serial(bench::State& state) { trackTime(state, serial); }
+SATFIND_BENCHMARK(BM_Executor_TrackTime_Serial);
+
+void BM_Executor_TrackTime_Pool(bench::State& state) { trackTime(state, ThreadPool::shared()); }
+SATFIND_BENCHMARK(BM_Executor_TrackTime_Pool);
+
+void BM_Executor_TrackGrid_Serial(bench::State& state) { trackGrid(state, serial); }
+SATFIND_BENCHMARK(BM_Executor_TrackGrid_Serial);
+
+void BM_Executor_TrackGrid_Pool(bench::State& state) { trackGrid(state, ThreadPool::shared()); }
+SATFIND_BENCHMARK(BM_Executor_TrackGrid_Pool);
+
+void BM_Executor_TrackPropagator_Serial(bench::State& state) { trackPropagator(state, serial); }
+SATFIND_BENCHMARK(BM_Executor_TrackPropagator_Serial);
+
+void BM_Executor_TrackPropagator_Pool(bench::State& state) { trackPropagator(state, ThreadPool::shared()); }
+SATFIND_BENCHMARK(BM_Executor_TrackPropagator_Pool);
+
+/* 空の処理を配る時間 (作業スレッドの起床と終了待ち) */
+void BM_Executor_Dispatch(bench::State& state) {
+	ThreadPool& pool = ThreadPool::shared();
+	for (auto _ : state) {
+		pool.parallelFor(pool.concurrency() * 4, 1, [](std::size_t begin, std::size_t, std::size_t) { bench::doNotOptimize(begin); });
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Executor_Dispatch);
+
+SATFIND_BENCHMARK_MAIN();
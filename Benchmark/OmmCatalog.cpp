@@ -0,0 +1,85 @@
+/**
+ * @file OmmCatalog.cpp
+ * @author fugu133
+ * @brief OMM バルクファイル読み込みのベンチマーク
+ * @details CSV と KVN の各形式で, 同数のレコードを含む 3LE カタログの読み込みと比較する
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <SatFind/Core>
+
+#include "Benchmark.hpp"
+
+using namespace satfind;
+
+namespace {
+
+constexpr std::size_t object_count = 30000;
+
+auto makeCsv() -> std::string {
+	std::string text = "OBJECT_NAME,OBJECT_ID,EPOCH,MEAN_MOTION,ECCENTRICITY,INCLINATION,RA_OF_ASC_NODE,ARG_OF_PERICENTER,"
+					   "MEAN_ANOMALY,EPHEMERIS_TYPE,CLASSIFICATION_TYPE,NORAD_CAT_ID,ELEMENT_SET_NO,REV_AT_EPOCH,BSTAR,"
+					   "MEAN_MOTION_DOT,MEAN_MOTION_DDOT\n";
+	for (std::size_t i = 0; i < object_count; i++) {
+		text += "OBJECT " + std::to_string(i) +
+				",1998-067A,2024-01-18T10:29:15.091872,15.49554946,.0004949,51.6427,342.3169,101.3994,45.6784,0,U," +
+				std::to_string(100000 + i) + ",999,43517,.38757E-3,.00021385,0\n";
+	}
+	return text;
+}
+
+auto makeKvn() -> std::string {
+	std::string text;
+	for (std::size_t i = 0; i < object_count; i++) {
+		text += "CCSDS_OMM_VERS = 2.0\n"
+				"OBJECT_NAME = OBJECT " +
+				std::to_string(i) +
+				"\nOBJECT_ID = 1998-067A\nCENTER_NAME = EARTH\nREF_FRAME = TEME\nTIME_SYSTEM = UTC\nMEAN_ELEMENT_THEORY = SGP4\n"
+				"EPOCH = 2024-01-18T10:29:15.091872\nMEAN_MOTION = 15.49554946 [rev/day]\nECCENTRICITY = .0004949\n"
+				"INCLINATION = 51.6427 [deg]\nRA_OF_ASC_NODE = 342.3169 [deg]\nARG_OF_PERICENTER = 101.3994 [deg]\n"
+				"MEAN_ANOMALY = 45.6784 [deg]\nEPHEMERIS_TYPE = 0\nCLASSIFICATION_TYPE = U\nNORAD_CAT_ID = " +
+				std::to_string(100000 + i) + "\nELEMENT_SET_NO = 999\nREV_AT_EPOCH = 43517\nBSTAR = .38757E-3 [1/ER]\n"
+				"MEAN_MOTION_DOT = .00021385 [rev/day**2]\nMEAN_MOTION_DDOT = 0 [rev/day**3]\n";
+	}
+	return text;
+}
+
+const auto csv = makeCsv();
+const auto kvn = makeKvn();
+
+auto readOmm(bench::State& state, const std::string& text) -> void {
+	for (auto _ : state) {
+		OmmReader reader;
+		reader.read(text);
+		bench::doNotOptimize(reader.records());
+	}
+	state.setItemsProcessed(state.iterations() * object_count);
+	state.setBytesProcessed(state.iterations() * text.size());
+}
+
+} // namespace
+
+void BM_Omm_Csv(bench::State& state) { readOmm(state, csv); }
+SATFIND_BENCHMARK(BM_Omm_Csv);
+
+void BM_Omm_Kvn(bench::State& state) { readOmm(state, kvn); }
+SATFIND_BENCHMARK(BM_Omm_Kvn);
+
+void BM_Omm_CsvToElements(bench::State& state) {
+	for (auto _ : state) {
+		std::vector<OrbitalElements> elements;
+		OmmReader::forEachRecord(
+		  csv, OmmFormat::Csv, [&](std::size_t, const OmmRecord& record) { elements.push_back(record.toOrbitalElements()); },
+		  [](std::size_t, const std::string&) {});
+		bench::doNotOptimize(elements);
+	}
+	state.setItemsProcessed(state.iterations() * object_count);
+	state.setBytesProcessed(state.iterations() * csv.size());
+}
+SATFIND_BENCHMARK(BM_Omm_CsvToElements);
+
+SATFIND_BENCHMARK_MAIN();
@@ -0,0 +1,96 @@
+/**
+ * @file SatelliteCatalog.cpp
+ * @author fugu133
+ * @brief 衛星カタログの検索のベンチマーク
+ * @details カタログ番号・国際識別符号・名前による検索を計測する. カタログ番号は std::map による検索と比較する
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <SatFind/Core>
+#include <cstdio>
+#include <map>
+
+#include "Benchmark.hpp"
+
+using namespace satfind;
+
+namespace {
+
+constexpr int object_count = 30000;
+
+auto makeCatalog() -> SatelliteCatalog {
+	const auto tle = Tle::parse("ISS (ZARYA)", "1 25544U 98067A   24018.43698023  .00021385  00000+0  38757-3 0  9991",
+								"2 25544  51.6427 342.3169 0004949 101.3994  45.6784 15.49554946435174");
+	const OrbitalPropagator propagator(tle);
+
+	SatelliteCatalog catalog;
+	catalog.reserve(object_count);
+	for (int i = 0; i < object_count; i++) {
+		char designator[16];
+		std::snprintf(designator, sizeof(designator), "%02d%03d%c", i % 100, i / 100, 'A' + i % 26);
+		catalog.add(SatelliteCatalog::Entry{100000 + i, "STARLINK-" + std::to_string(i), designator, tle.epoch()}, propagator);
+	}
+	return catalog;
+}
+
+const auto catalog = makeCatalog();
+
+const auto catalog_map = [] {
+	std::map<int, SatelliteCatalog::Handle> map;
+	for (SatelliteCatalog::Handle h = 0; h < catalog.size(); h++) {
+		map.emplace(catalog.entry(h).catalog_number, h);
+	}
+	return map;
+}();
+
+} // namespace
+
+void BM_Catalog_FindNumber(bench::State& state) {
+	int i = 0;
+	for (auto _ : state) {
+		bench::doNotOptimize(catalog.find(100000 + i));
+		i = (i + 7919) % object_count;
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Catalog_FindNumber);
+
+void BM_Catalog_FindNumberMap(bench::State& state) {
+	int i = 0;
+	for (auto _ : state) {
+		bench::doNotOptimize(catalog_map.find(100000 + i)->second);
+		i = (i + 7919) % object_count;
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Catalog_FindNumberMap);
+
+void BM_Catalog_FindDesignator(bench::State& state) {
+	for (auto _ : state) {
+		bench::doNotOptimize(catalog.findByDesignator("2023-123T"));
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Catalog_FindDesignator);
+
+void BM_Catalog_FindName(bench::State& state) {
+	for (auto _ : state) {
+		bench::doNotOptimize(catalog.findByName("starlink-12345"));
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Catalog_FindName);
+
+void BM_Catalog_SearchName(bench::State& state) {
+	for (auto _ : state) {
+		bench::doNotOptimize(catalog.searchName("2999"));
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Catalog_SearchName);
+
+SATFIND_BENCHMARK_MAIN();
@@ -0,0 +1,90 @@
+/**
+ * @file TleCatalog.cpp
+ * @author fugu133
+ * @brief TLE カタログ読み込みのベンチマーク
+ * @details TleCatalogReader と, std::getline で1行ずつ読み込んで Tle を構築する方法, および1件の解析を計測する
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <SatFind/Core>
+#include <sstream>
+
+#include "Benchmark.hpp"
+
+using namespace satfind;
+
+namespace {
+
+constexpr std::size_t object_count = 30000;
+
+/* 3LE 形式のカタログ (名前行は24文字に満たない) */
+auto makeCatalog() -> std::string {
+	const std::string tle1 = "1 25544U 98067A   24018.43698023  .00021385  00000+0  38757-3 0  9991";
+	const std::string tle2 = "2 25544  51.6427 342.3169 0004949 101.3994  45.6784 15.49554946435174";
+
+	std::string text;
+	for (std::size_t i = 0; i < object_count; i++) {
+		text += "OBJECT " + std::to_string(i) + "\n" + tle1 + "\n" + tle2 + "\n";
+	}
+	return text;
+}
+
+const auto catalog = makeCatalog();
+
+} // namespace
+
+void BM_Catalog_Getline(bench::State& state) {
+	for (auto _ : state) {
+		std::istringstream iss(catalog);
+		std::vector<Tle> elements;
+		std::string name, tle1, tle2;
+		while (std::getline(iss, name) && std::getline(iss, tle1) && std::getline(iss, tle2)) {
+			elements.emplace_back(name, tle1, tle2);
+		}
+		bench::doNotOptimize(elements);
+	}
+	state.setItemsProcessed(state.iterations() * object_count);
+	state.setBytesProcessed(state.iterations() * catalog.size());
+}
+SATFIND_BENCHMARK(BM_Catalog_Getline);
+
+void BM_Catalog_Reader(bench::State& state) {
+	for (auto _ : state) {
+		TleCatalogReader reader;
+		reader.read(catalog);
+		bench::doNotOptimize(reader.elements());
+	}
+	state.setItemsProcessed(state.iterations() * object_count);
+	state.setBytesProcessed(state.iterations() * catalog.size());
+}
+SATFIND_BENCHMARK(BM_Catalog_Reader);
+
+void BM_Catalog_SplitOnly(bench::State& state) {
+	for (auto _ : state) {
+		std::size_t n = 0;
+		TleCatalogReader::forEachRecord(
+		  catalog, [&](std::size_t, std::string_view, std::string_view, std::string_view) { n++; },
+		  [](std::size_t, int, const char*) {});
+		bench::doNotOptimize(n);
+	}
+	state.setItemsProcessed(state.iterations() * object_count);
+	state.setBytesProcessed(state.iterations() * catalog.size());
+}
+SATFIND_BENCHMARK(BM_Catalog_SplitOnly);
+
+void BM_Tle_Parse(bench::State& state) {
+	const std::string_view tle1 = "1 25544U 98067A   24018.43698023  .00021385  00000+0  38757-3 0  9991";
+	const std::string_view tle2 = "2 25544  51.6427 342.3169 0004949 101.3994  45.6784 15.49554946435174";
+	for (auto _ : state) {
+		auto tle = Tle::parse("ISS (ZARYA)", tle1, tle2);
+		bench::doNotOptimize(tle);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Tle_Parse);
+
+SATFIND_BENCHMARK_MAIN();
@@ -0,0 +1,85 @@
+/**
+ * @file TleWriter.cpp
+ * @author fugu133
+ * @brief TLE 書き出しのベンチマーク
+ * @details TleWriter でバッファに書き出す方法と, Tle::toTleString で文字列を連結する方法を比較する
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <SatFind/Core>
+
+#include "Benchmark.hpp"
+
+using namespace satfind;
+
+namespace {
+
+constexpr std::size_t object_count = 30000;
+
+auto makeElements() -> std::vector<Tle> {
+	const std::string tle1 = "1 25544U 98067A   24018.43698023  .00021385  00000+0  38757-3 0  9991";
+	const std::string tle2 = "2 25544  51.6427 342.3169 0004949 101.3994  45.6784 15.49554946435174";
+
+	std::vector<Tle> elements;
+	elements.reserve(object_count);
+	for (std::size_t i = 0; i < object_count; i++) {
+		elements.emplace_back("OBJECT " + std::to_string(i), tle1, tle2);
+	}
+	return elements;
+}
+
+const auto tles = makeElements();
+
+const auto elements = [] {
+	std::vector<std::pair<OrbitalElements, TleMetadata>> e;
+	for (const auto& tle : tles) {
+		e.emplace_back(OrbitalElements(tle), TleMetadata::fromTle(tle));
+	}
+	return e;
+}();
+
+} // namespace
+
+void BM_Write_ToTleString(bench::State& state) {
+	for (auto _ : state) {
+		std::string text;
+		for (const auto& tle : tles) {
+			text += tle.toTleString();
+		}
+		bench::doNotOptimize(text);
+	}
+	state.setItemsProcessed(state.iterations() * object_count);
+}
+SATFIND_BENCHMARK(BM_Write_ToTleString);
+
+void BM_Write_TleWriter(bench::State& state) {
+	std::string text(object_count * TleWriter::max_record_length, '\0');
+	for (auto _ : state) {
+		char* p = text.data();
+		for (std::size_t i = 0; i < object_count; i++) {
+			p += TleWriter::format(tles[i].name(), elements[i].first, elements[i].second, p);
+		}
+		bench::doNotOptimize(p);
+	}
+	state.setItemsProcessed(state.iterations() * object_count);
+}
+SATFIND_BENCHMARK(BM_Write_TleWriter);
+
+void BM_Write_Lines(bench::State& state) {
+	char line1[TleWriter::line_length];
+	char line2[TleWriter::line_length];
+	const auto& [e, m] = elements.front();
+	for (auto _ : state) {
+		TleWriter::formatLines(e, m, line1, line2);
+		bench::doNotOptimize(line1);
+		bench::doNotOptimize(line2);
+	}
+	state.setItemsProcessed(state.iterations());
+}
+SATFIND_BENCHMARK(BM_Write_Lines);
+
+SATFIND_BENCHMARK_MAIN();
@@ -37,7 +37,7 @@ int main() {
 			auto elem = op.trackFlightObject(dt);
 			auto pos = elem.position.toWgs84();
 			ofs << dt << "," << (dt - start_dt).totalSeconds() << "," << pos.longitude().degrees() << "," << pos.latitude().degrees() << ","
-				<< pos.altitude() << std::endl;
+				<< pos.altitude() << "\n";
 		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,405 @@
+/**
+ * @file CatalogWatcher.hpp
+ * @author fugu133
+ * @brief 軌道要素ファイルのディレクトリを監視してカタログを更新する (Linux のみ)
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#define SATFIND_HAS_INOTIFY 1
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "Essential.hpp"
+#include "LiveCatalog.hpp"
+#include "OmmReader.hpp"
+#include "TleCatalogReader.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+#if defined(SATFIND_HAS_INOTIFY)
+
+/**
+ * @brief 1回の再読み込みの結果
+ *
+ */
+struct CatalogWatcherReport {
+	std::size_t files;					  // 読み込んだファイル数 (削除されたファイルを含む)
+	std::size_t elements;				  // 読み込んだ要素数
+	std::size_t errors;					  // 読み飛ばしたレコード数
+	std::size_t removals;				  // カタログから削除した衛星数
+	std::chrono::microseconds parse_time; // ファイルの解析にかかった時間
+	std::chrono::microseconds latency;	  // 最初の変更を検知してからスナップショットを公開するまでの時間
+};
+
+/**
+ * @brief 再読み込みの累計
+ *
+ */
+struct CatalogWatcherMetrics {
+	std::size_t reloads;						// 再読み込みの回数
+	std::size_t files;							// 読み込んだファイル数の累計
+	std::size_t elements;						// 読み込んだ要素数の累計
+	std::size_t errors;							// 読み飛ばしたレコード数の累計
+	std::chrono::microseconds total_parse_time; // 解析時間の累計
+	std::chrono::microseconds max_latency;		// 公開までの時間の最大値
+	CatalogWatcherReport last;					// 最後の再読み込みの結果
+};
+
+/**
+ * @brief 軌道要素ファイルのディレクトリを inotify で監視し, 変更されたファイルだけを読み込んで LiveCatalog に公開する
+ * @note 拡張子が .tle, .txt, .2le, .3le のファイルを TLE カタログ, .csv, .xml, .kvn, .omm のファイルを OMM として読み込む.
+ *       短時間に続く書き込みは, 最後の変更から debounce の間変更がなくなるまでまとめ, 1つの差分として適用する.
+ *       ファイルから消えた衛星と削除されたファイルの衛星はカタログから削除する
+ * @remark 書き込み途中のファイルを読まないよう, ファイルは一時ファイルに書き込んでから rename で置き換えることを推奨する.
+ *         同じ衛星を複数のファイルに含めた場合, いずれかのファイルから消えた時点で削除される
+ */
+class CatalogWatcher {
+  public:
+	using Clock = std::chrono::steady_clock;
+	using ReportFunction = std::function<void(const CatalogWatcherReport&)>;
+
+	/**
+	 * @brief Construct a new Catalog Watcher object
+	 *
+	 * @param catalog 更新するカタログ
+	 * @param directory 監視するディレクトリ
+	 * @param debounce 変更をまとめる時間
+	 */
+	CatalogWatcher(LiveCatalog& catalog, std::string directory, std::chrono::milliseconds debounce = std::chrono::milliseconds(200))
+	  : m_catalog(catalog), m_directory(std::move(directory)), m_debounce(debounce), m_inotify_fd(-1), m_wake_fd(-1), m_metrics() {}
+
+	CatalogWatcher(const CatalogWatcher&) = delete;
+	auto operator=(const CatalogWatcher&) -> CatalogWatcher& = delete;
+
+	~CatalogWatcher() { stop(); }
+
+	/**
+	 * @brief 再読み込みのたびに呼び出す関数を設定する
+	 * @note 監視スレッドから呼び出す. start() の前に設定する
+	 *
+	 * @param report report(再読み込みの結果)
+	 */
+	auto setReportFunction(ReportFunction report) -> void { m_report = std::move(report); }
+
+	/**
+	 * @brief ディレクトリ内のファイルを読み込み, 監視を開始する
+	 * @exception IoException 監視を開始できない場合
+	 *
+	 */
+	auto start() -> void {
+		if (m_thread.joinable()) {
+			return;
+		}
+
+		m_inotify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (m_inotify_fd < 0) {
+			throw IoException("Cannot initialize inotify", IoException::FileOpenError);
+		}
+		if (::inotify_add_watch(m_inotify_fd, m_directory.c_str(), watch_mask) < 0) {
+			closeDescriptors();
+			throw IoException("Cannot watch directory: " + m_directory, IoException::FileOpenError);
+		}
+		m_wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (m_wake_fd < 0) {
+			closeDescriptors();
+			throw IoException("Cannot create eventfd", IoException::FileOpenError);
+		}
+
+		// 監視の開始後に読み込み, 読み込み中の変更を取りこぼさない
+		scan();
+		m_thread = std::thread([this] { run(); });
+	}
+
+	/**
+	 * @brief 監視を終了する
+	 *
+	 */
+	auto stop() -> void {
+		if (m_thread.joinable()) {
+			const std::uint64_t one = 1;
+			[[maybe_unused]] const auto n = ::write(m_wake_fd, &one, sizeof(one));
+			m_thread.join();
+		}
+		closeDescriptors();
+	}
+
+	auto running() const -> bool { return m_thread.joinable(); }
+
+	/**
+	 * @brief ディレクトリ内のすべての対象ファイルを読み込む
+	 *
+	 * @return CatalogWatcherReport 読み込みの結果
+	 */
+	auto scan() -> CatalogWatcherReport {
+		std::vector<Change> changes;
+		std::error_code ec;
+		for (const auto& file : std::filesystem::directory_iterator(m_directory, ec)) {
+			const std::string name = file.path().filename().string();
+			if (file.is_regular_file(ec) && kindOf(name) != FileKind::Ignored) {
+				changes.push_back({name, false});
+			}
+		}
+		return reload(changes, Clock::now());
+	}
+
+	/**
+	 * @brief 再読み込みの累計を取得する
+	 *
+	 */
+	auto metrics() const -> CatalogWatcherMetrics {
+		const std::lock_guard<std::mutex> lock(m_metrics_mutex);
+		return m_metrics;
+	}
+
+  private:
+	enum class FileKind { Ignored, Tle, Omm };
+
+	struct Change {
+		std::string name; // ファイル名
+		bool deleted;	  // 削除されたか
+	};
+
+	struct Pending {
+		Clock::time_point first_event; // 最初の変更の時刻
+		Clock::time_point last_event;  // 最後の変更の時刻
+		bool deleted;				   // 削除されたか
+	};
+
+	static constexpr std::uint32_t watch_mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MODIFY | IN_DELETE | IN_MOVED_FROM | IN_ONLYDIR;
+
+	LiveCatalog& m_catalog;									   // 更新するカタログ
+	std::string m_directory;								   // 監視するディレクトリ
+	std::chrono::milliseconds m_debounce;					   // 変更をまとめる時間
+	int m_inotify_fd;										   // inotify のファイル記述子
+	int m_wake_fd;											   // 監視スレッドを終了させる eventfd
+	std::thread m_thread;									   // 監視スレッド
+	ReportFunction m_report;								   // 再読み込みの通知先
+	std::mutex m_reload_mutex;								   // 再読み込みを直列にする
+	std::unordered_map<std::string, std::vector<int>> m_files; // ファイルごとの衛星のカタログ番号 (昇順)
+	mutable std::mutex m_metrics_mutex;						   // m_metrics を保護する
+	CatalogWatcherMetrics m_metrics;						   // 再読み込みの累計
+
+	static auto kindOf(std::string_view name) -> FileKind {
+		if (name.empty() || name[0] == '.' || name.back() == '~') {
+			return FileKind::Ignored;
+		}
+		const std::size_t dot = name.rfind('.');
+		if (dot == std::string_view::npos) {
+			return FileKind::Ignored;
+		}
+		const std::string_view ext = name.substr(dot);
+		if (ext == ".tle" || ext == ".txt" || ext == ".2le" || ext == ".3le") {
+			return FileKind::Tle;
+		}
+		if (ext == ".csv" || ext == ".xml" || ext == ".kvn" || ext == ".omm") {
+			return FileKind::Omm;
+		}
+		return FileKind::Ignored;
+	}
+
+	/**
+	 * @brief 監視スレッドの処理
+	 *
+	 */
+	auto run() -> void {
+		std::unordered_map<std::string, Pending> pending;
+		alignas(inotify_event) char buffer[16 * 1024];
+
+		while (true) {
+			int timeout = -1;
+			if (!pending.empty()) {
+				auto deadline = Clock::time_point::max();
+				for (const auto& [name, p] : pending) {
+					deadline = std::min(deadline, p.last_event + m_debounce);
+				}
+				const auto wait = std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now()).count();
+				timeout = static_cast<int>(std::max<decltype(wait)>(wait, 0));
+			}
+
+			pollfd fds[2] = {{m_inotify_fd, POLLIN, 0}, {m_wake_fd, POLLIN, 0}};
+			if (::poll(fds, 2, timeout) < 0 && errno != EINTR) {
+				break;
+			}
+			if (fds[1].revents & POLLIN) {
+				break;
+			}
+
+			if (fds[0].revents & POLLIN) {
+				ssize_t length;
+				while ((length = ::read(m_inotify_fd, buffer, sizeof(buffer))) > 0) {
+					const auto now = Clock::now();
+					for (ssize_t pos = 0; pos < length;) {
+						const auto* event = reinterpret_cast<const inotify_event*>(buffer + pos);
+						pos += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+						if (event->mask & IN_Q_OVERFLOW) {
+							// 取りこぼした変更があるため全ファイルを読み直す (読み込めないファイルは削除されたものとする)
+							{
+								const std::lock_guard<std::mutex> lock(m_reload_mutex);
+								for (const auto& [name, numbers] : m_files) {
+									markPending(pending, name, false, now);
+								}
+							}
+							std::error_code ec;
+							for (const auto& file : std::filesystem::directory_iterator(m_directory, ec)) {
+								markPending(pending, file.path().filename().string(), false, now);
+							}
+							continue;
+						}
+						if (event->len == 0 || kindOf(event->name) == FileKind::Ignored) {
+							continue;
+						}
+						markPending(pending, event->name, (event->mask & (IN_DELETE | IN_MOVED_FROM)) != 0, now);
+					}
+				}
+			}
+
+			const auto now = Clock::now();
+			std::vector<Change> changes;
+			auto first_event = now;
+			for (auto it = pending.begin(); it != pending.end();) {
+				if (now - it->second.last_event >= m_debounce) {
+					changes.push_back({it->first, it->second.deleted});
+					first_event = std::min(first_event, it->second.first_event);
+					it = pending.erase(it);
+				} else {
+					++it;
+				}
+			}
+			if (!changes.empty()) {
+				const auto report = reload(changes, first_event);
+				if (m_report) {
+					m_report(report);
+				}
+			}
+		}
+	}
+
+	static auto markPending(std::unordered_map<std::string, Pending>& pending, const std::string& name, bool deleted,
+							Clock::time_point now) -> void {
+		if (kindOf(name) == FileKind::Ignored) {
+			return;
+		}
+		auto [it, inserted] = pending.try_emplace(name, Pending{now, now, deleted});
+		if (!inserted) {
+			it->second.last_event = now;
+			it->second.deleted = deleted;
+		}
+	}
+
+	/**
+	 * @brief 変更されたファイルを読み込み, 差分を適用する
+	 *
+	 * @param changes 変更されたファイル
+	 * @param first_event 最初の変更の時刻 (公開までの時間の計測に使用)
+	 * @return CatalogWatcherReport 読み込みの結果
+	 */
+	auto reload(const std::vector<Change>& changes, Clock::time_point first_event) -> CatalogWatcherReport {
+		const std::lock_guard<std::mutex> lock(m_reload_mutex);
+		CatalogWatcherReport report{};
+		CatalogDelta delta;
+
+		const auto parse_begin = Clock::now();
+		for (const auto& change : changes) {
+			std::vector<int> numbers;
+			bool deleted = change.deleted;
+			if (!deleted) {
+				try {
+					report.errors += load(m_directory + "/" + change.name, delta, numbers);
+				} catch (const IoException&) {
+					// 通知後に削除されたファイル
+					deleted = true;
+				}
+			}
+			std::sort(numbers.begin(), numbers.end());
+			numbers.erase(std::unique(numbers.begin(), numbers.end()), numbers.end());
+
+			auto& previous = m_files[change.name];
+			std::set_difference(previous.begin(), previous.end(), numbers.begin(), numbers.end(), std::back_inserter(delta.removals));
+			if (deleted) {
+				m_files.erase(change.name);
+			} else {
+				previous = std::move(numbers);
+			}
+			report.files++;
+		}
+		report.parse_time = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - parse_begin);
+		report.elements = delta.elements.size() + delta.records.size();
+		report.removals = delta.removals.size();
+
+		m_catalog.apply(delta);
+		report.latency = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - first_event);
+
+		const std::lock_guard<std::mutex> metrics_lock(m_metrics_mutex);
+		m_metrics.reloads++;
+		m_metrics.files += report.files;
+		m_metrics.elements += report.elements;
+		m_metrics.errors += report.errors;
+		m_metrics.total_parse_time += report.parse_time;
+		m_metrics.max_latency = std::max(m_metrics.max_latency, report.latency);
+		m_metrics.last = report;
+		return report;
+	}
+
+	/**
+	 * @brief 1ファイルを読み込み, 差分に追加する
+	 *
+	 * @return std::size_t 読み飛ばしたレコード数
+	 */
+	static auto load(const std::string& path, CatalogDelta& delta, std::vector<int>& numbers) -> std::size_t {
+		const std::string_view name = std::string_view(path).substr(path.rfind('/') + 1);
+		if (kindOf(name) == FileKind::Omm) {
+			OmmReader reader(path);
+			for (const auto& record : reader.records()) {
+				numbers.push_back(record.norad_cat_id);
+				delta.records.push_back(record);
+			}
+			return reader.errors().size();
+		}
+
+		TleCatalogReader reader(path);
+		auto elements = reader.takeElements();
+		for (const auto& tle : elements) {
+			numbers.push_back(tle.catalogNumber());
+		}
+		delta.elements.insert(delta.elements.end(), std::make_move_iterator(elements.begin()), std::make_move_iterator(elements.end()));
+		return reader.errors().size();
+	}
+
+	auto closeDescriptors() -> void {
+		if (m_inotify_fd >= 0) {
+			::close(m_inotify_fd);
+			m_inotify_fd = -1;
+		}
+		if (m_wake_fd >= 0) {
+			::close(m_wake_fd);
+			m_wake_fd = -1;
+		}
+	}
+};
+
+#endif
+
+SATFIND_NAMESPACE_END
@@ -17,6 +17,7 @@
 #include "AngleHelper.hpp"
 #include "DateTime.hpp"
 #include "Essential.hpp"
+#include "Instrumentation.hpp"
 
 SATFIND_NAMESPACE_BEGIN
 
@@ -31,7 +32,9 @@ enum class CoordinateType {
 	EclipticCartesian,	 // Ecliptic Cartesian
 	EquatorialSpherical, // Equatorial Spherical
 	EquatorialCartesian, // Equatorial Cartesian
-	Topocentric			 // Topocentric (Azimuth, Elevation, Range)
+	Topocentric,		 // Topocentric (Azimuth, Elevation, Range)
+	Itrf,				 // ITRF Cartesian (with polar motion and UT1-UTC)
+	Gcrf				 // GCRF Cartesian (IAU-76/FK5 precession-nutation)
 };
 
 template <class DataType>
@@ -335,7 +338,7 @@ inline Ecef Eci::toEcef() const {
 	return Ecef(m_epoch, Eigen::Vector3d{x, y, z});
 }
 
-GeocentricSpherical Eci::toGeocentricSpherical() const {
+inline GeocentricSpherical Eci::toGeocentricSpherical() const {
 	return toEcef().toGeocentricSpherical();
 }
 
@@ -397,6 +400,7 @@ inline Wgs84 Ecef::toWgs84() const {
 		lat = std::atan2(m_data.z() + N * e2 * sin_phi, p);
 		i++;
 	} while (std::abs(lat - phi) > 1e-10 && i < 10); // 4回くらいで収束する
+	Instrumentation::addWgs84Iterations(i);
 
 	const double lon = std::atan2(m_data.y(), m_data.x());
 	const double alt = p / std::cos(phi) - a / std::sqrt(1 - e2 * std::sin(phi) * std::sin(phi));
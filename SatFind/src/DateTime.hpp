@@ -16,6 +16,7 @@
 #include <sstream>
 #include <chrono>
 #include <iostream>
+#include <string_view>
 
 #include "Essential.hpp"
 #include "AngleHelper.hpp"
@@ -92,7 +93,7 @@ class DateTime {
 	 *
 	 * @param date_time ISO8601形式の日付文字列
 	 */
-	DateTime(const std::string& date_time) { initialize(date_time); }
+	DateTime(const std::string& date_time) : m_ticks(parse(date_time).m_ticks) {}
 
 	/**
 	 * @brief Construct a new Date Time object
@@ -242,50 +243,10 @@ class DateTime {
 
 	/**
 	 * @brief ΔTを取得する
-	 * @note https://eclipse.gsfc.nasa.gov/SEhelp/deltatpoly2004.html
-	 * @return auto
-	 */
-	auto deltaT() const -> TimeSpan {
-		const int years = year();
-		double y = (double)years + ((double)month() - 0.5) / 12;
-
-		if (years < -500) {
-			return TimeSpan(Polynomial::deg2((y - 1820) / 100, -20, 0, 32), TimeUnit::Seconds);
-		} else if (band(years, -500, 500)) {
-			return TimeSpan(Polynomial::deg6(y / 100, 10583.6, -1014.41, 33.78311, -5.952053, -0.1798452, 0.022174192, 0.0090316521),
-							TimeUnit::Seconds);
-		} else if (band(years, 500, 1600)) {
-			return TimeSpan(Polynomial::deg6((y - 1000) / 100, 1574.2, -556.01, 71.23472, 0.319781, -0.8503463, -0.005050998, 0.0083572073),
-							TimeUnit::Seconds);
-		} else if (band(years, 1600, 1700)) {
-			return TimeSpan(Polynomial::deg3(y - 1600, 120, -0.9808, -0.01532, 1.0 / 7129.0), TimeUnit::Seconds);
-		} else if (band(years, 1700, 1800)) {
-			return TimeSpan(Polynomial::deg4(y - 1700, 8.83, 0.1603, -0.0059285, 0.00013336, -1.0 / 1174000.0), TimeUnit::Seconds);
-		} else if (band(years, 1800, 1860)) {
-			return TimeSpan(
-			  Polynomial::deg7(y - 1800, 13.72, -0.332447, 0.0068612, 0.0041116, -0.00037436, 0.0000121272, -0.0000001699, 0.000000000875),
-			  TimeUnit::Seconds);
-		} else if (band(years, 1860, 1900)) {
-			return TimeSpan(Polynomial::deg5(y - 1860, 7.62, 0.5737, -0.251754, 0.01680668, -0.0004473624, 1.0 / 233174.0),
-							TimeUnit::Seconds);
-		} else if (band(years, 1900, 1920)) {
-			return TimeSpan(Polynomial::deg4(y - 1900, -2.79, 1.494119, -0.0598939, 0.0061966, -0.000197), TimeUnit::Seconds);
-		} else if (band(years, 1920, 1941)) {
-			return TimeSpan(Polynomial::deg3(y - 1920, 21.20, 0.84493, -0.076100, 0.0020936), TimeUnit::Seconds);
-		} else if (band(years, 1941, 1961)) {
-			return TimeSpan(Polynomial::deg3(y - 1950, 29.07, 0.407, -1.0 / 233.0, 1.0 / 2547.0), TimeUnit::Seconds);
-		} else if (band(years, 1961, 1986)) {
-			return TimeSpan(Polynomial::deg3(y - 1975, 45.45, 1.067, -1.0 / 260.0, -1.0 / 718.0), TimeUnit::Seconds);
-		} else if (band(years, 1986, 2005)) {
-			return TimeSpan(Polynomial::deg5(y - 2000, 63.86, 0.3345, -0.060374, 0.0017275, 0.000651814, 0.00002373599), TimeUnit::Seconds);
-		} else if (band(years, 2005, 2050)) {
-			return TimeSpan(Polynomial::deg2(y - 2000, 62.92, 0.32217, 0.005589), TimeUnit::Seconds);
-		} else if (band(years, 2050, 2150)) {
-			return TimeSpan(Polynomial::deg2((y - 1820) / 100, -20 - 0.5628 * (2150 - y), 0, 32), TimeUnit::Seconds);
-		} else {
-			return TimeSpan(Polynomial::deg2((y - 1820) / 100, -20, 0, 32), TimeUnit::Seconds);
-		}
-	}
+	 * @note DeltaT::current() の表を補間する. 表の範囲外は多項式で近似する
+	 * @return TimeSpan ΔT (TT - UT)
+	 */
+	auto deltaT() const -> TimeSpan;
 
 	/**
 	 * @brief 均時差を取得する
@@ -367,21 +328,122 @@ class DateTime {
 	 * @return std::string ISO8601形式文字列
 	 */
 	auto toString() const -> std::string {
-		std::stringstream ss;
+		char buf[iso8601_length];
+		return std::string(buf, format(buf));
+	}
+
+	/**
+	 * @brief ISO8601形式文字列 (YYYY-MM-DDThh:mm:ss.ssssssZ) をバッファに書き込む
+	 * @note メモリ確保を行わない. 終端文字は書き込まない
+	 *
+	 * @param buf 書き込み先 (iso8601_length 文字以上)
+	 * @return std::size_t 書き込んだ文字数
+	 */
+	auto format(char* buf) const -> std::size_t {
 		int year, month, day;
 		pushDate(year, month, day);
-		ss << std::setfill('0') << std::setw(4) << year << "-" << std::setw(2) << month << "-" << std::setw(2) << day << "T" << std::setw(2)
-		   << hour() << ":" << std::setw(2) << minute() << ":" << std::setw(2) << second() << "." << std::setw(6) << microsecond() << "Z";
-		return ss.str();
+
+		const std::int64_t time_part_ticks = m_ticks % constant::ticks_per_day;
+		const auto seconds_of_day = static_cast<int>(time_part_ticks / constant::ticks_per_second);
+		const auto micro = static_cast<int>(time_part_ticks % constant::ticks_per_second / constant::ticks_per_microsecond);
+
+		writeDigits(buf, year, 4);
+		buf[4] = '-';
+		writeDigits(buf + 5, month, 2);
+		buf[7] = '-';
+		writeDigits(buf + 8, day, 2);
+		buf[10] = 'T';
+		writeDigits(buf + 11, seconds_of_day / constant::seconds_per_hour, 2);
+		buf[13] = ':';
+		writeDigits(buf + 14, seconds_of_day / constant::seconds_per_minute % constant::minutes_per_hour, 2);
+		buf[16] = ':';
+		writeDigits(buf + 17, seconds_of_day % constant::seconds_per_minute, 2);
+		buf[19] = '.';
+		writeDigits(buf + 20, micro, 6);
+		buf[26] = 'Z';
+
+		return iso8601_length;
 	}
 
-	auto add(std::int64_t ticks) -> DateTime { return DateTime(m_ticks + ticks); }
+	/**
+	 * @brief ISO8601形式の文字列を解析する
+	 * @note メモリ確保を行わない. 書式の自由度は文字列からのコンストラクタと同じで,
+	 *       小数秒は7桁目以降を切り捨てる. タイムゾーンは Z, UTC, GMT, ±hh:mm, ±hhmm, ±hh を受け付ける
+	 *
+	 * @param date_time ISO8601形式の日付文字列
+	 * @return DateTime
+	 */
+	static auto parse(std::string_view date_time) -> DateTime {
+		const char* str = date_time.data();
+		const std::size_t length = date_time.length();
 
-	auto add(const TimeSpan& ts) -> DateTime { return DateTime(m_ticks + ts.ticks()); }
+		if (length < 10) {
+			throw DateTimeException("Invalid ISO8601 date string", DateTimeException::InvalidIso8601Format);
+		}
+
+		const int year = parseDigits(str, 4);
+		const int month = parseDigits(str + 5, 2);
+		const int day = parseDigits(str + 8, 2);
+		int hour = 0, minute = 0, second = 0, microsecond = 0;
+		std::int64_t tz_offset_ticks = 0;
 
-	auto addYears(const int years) -> DateTime { return addMonths(years * 12); }
+		if (length > 10) {
+			if (length < 16) {
+				throw DateTimeException("Invalid ISO8601 time string", DateTimeException::InvalidIso8601Format);
+			}
+			hour = parseDigits(str + 11, 2);
+			minute = parseDigits(str + 14, 2);
 
-	auto addMonths(const int months) -> DateTime {
+			std::size_t pos = 16;
+			if (pos < length && !isTimeZoneDesignator(str[pos])) {
+				if (pos + 3 > length) {
+					throw DateTimeException("Invalid ISO8601 second string", DateTimeException::InvalidIso8601Format);
+				}
+				second = parseDigits(str + pos + 1, 2);
+				pos += 3;
+
+				if (pos < length && (str[pos] == '.' || str[pos] == ',')) {
+					const std::size_t decimal_begin = ++pos;
+					int scale = 100000;
+					while (pos < length && isDigit(str[pos])) {
+						microsecond += (str[pos++] - '0') * scale;
+						scale /= 10;
+					}
+					if (pos == decimal_begin) {
+						throw DateTimeException("Invalid ISO8601 decimal string", DateTimeException::InvalidIso8601Format);
+					}
+				}
+			}
+
+			if (pos < length) {
+				tz_offset_ticks = parseTimeZone(date_time.substr(pos));
+			}
+		}
+
+		if (!validateDate(year, month, day)) {
+			throw DateTimeException("Date range is invalid", DateTimeException::InvalidDate);
+		}
+		if (!validateTime(hour, minute, second, microsecond)) {
+			throw DateTimeException("Time range is invalid", DateTimeException::InvalidTime);
+		}
+
+		return DateTime(daysFromCivil(year, month, day) * constant::ticks_per_day + hour * constant::ticks_per_hour +
+						minute * constant::ticks_per_minute + second * constant::ticks_per_second +
+						microsecond * constant::ticks_per_microsecond - tz_offset_ticks);
+	}
+
+	/**
+	 * @brief format() が書き込む文字数
+	 */
+	static constexpr std::size_t iso8601_length = 27;
+
+	auto add(std::int64_t ticks) const -> DateTime { return DateTime(m_ticks + ticks); }
+
+	auto add(const TimeSpan& ts) const -> DateTime { return DateTime(m_ticks + ts.ticks()); }
+
+	auto addYears(const int years) const -> DateTime { return addMonths(years * 12); }
+
+	auto addMonths(const int months) const -> DateTime {
 		int year, month, day;
 		pushDate(year, month, day);
 
@@ -401,21 +463,24 @@ class DateTime {
 		return DateTime(year, month, day, 0, 0, 0).add(timeOfDay());
 	}
 
-	auto addDays(const double days) -> DateTime { return addMicroseconds(days * constant::microseconds_per_day); }
+	auto addDays(const double days) const -> DateTime { return addMicroseconds(days * constant::microseconds_per_day); }
 
-	auto addHours(const double hours) -> DateTime { return addMicroseconds(hours * constant::microseconds_per_hour); }
+	auto addHours(const double hours) const -> DateTime { return addMicroseconds(hours * constant::microseconds_per_hour); }
 
-	auto addMinutes(const double minutes) -> DateTime { return addMicroseconds(minutes * constant::microseconds_per_minute); }
+	auto addMinutes(const double minutes) const -> DateTime { return addMicroseconds(minutes * constant::microseconds_per_minute); }
 
-	auto addSeconds(const double seconds) -> DateTime { return addMicroseconds(seconds * constant::microseconds_per_second); }
+	auto addSeconds(const double seconds) const -> DateTime { return addMicroseconds(seconds * constant::microseconds_per_second); }
 
-	auto addMicroseconds(const double microseconds) -> DateTime {
+	auto addMicroseconds(const double microseconds) const -> DateTime {
 		return addTicks(static_cast<std::int64_t>(microseconds * constant::ticks_per_microsecond));
 	}
 
-	auto addTicks(const std::int64_t ticks) -> DateTime { return DateTime{m_ticks + ticks}; }
+	auto addTicks(const std::int64_t ticks) const -> DateTime { return DateTime{m_ticks + ticks}; }
 
-	friend auto operator<<(std::ostream& os, const DateTime& dt) -> std::ostream& { return os << dt.toString(); }
+	friend auto operator<<(std::ostream& os, const DateTime& dt) -> std::ostream& {
+		char buf[iso8601_length];
+		return os.write(buf, static_cast<std::streamsize>(dt.format(buf)));
+	}
 
 	int dayOfYear() const {
 		int year, month, day;
@@ -439,7 +504,7 @@ class DateTime {
 	 * @return true 閏年
 	 * @return false 平年
 	 */
-	auto isLeapYear(int year) const -> bool { return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0; }
+	static auto isLeapYear(int year) -> bool { return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0; }
 
 	/**
 	 * @brief 年の範囲チェック
@@ -448,7 +513,7 @@ class DateTime {
 	 * @return true Pass
 	 * @return false NG
 	 */
-	auto validateYearRange(int year) const -> bool { return year >= 1 && year <= 9999; }
+	static auto validateYearRange(int year) -> bool { return year >= 1 && year <= 9999; }
 
 	/**
 	 * @brief 月の範囲チェック
@@ -457,7 +522,7 @@ class DateTime {
 	 * @return true Pass
 	 * @return false NG
 	 */
-	auto validateMonthRange(int month) const -> bool { return month >= 1 && month <= 12; }
+	static auto validateMonthRange(int month) -> bool { return month >= 1 && month <= 12; }
 
 	/**
 	 * @brief 日付の範囲チェック
@@ -466,7 +531,7 @@ class DateTime {
 	 * @return true Pass
 	 * @return false NG
 	 */
-	auto validateDate(int year, int month, int day) const -> bool {
+	static auto validateDate(int year, int month, int day) -> bool {
 		if (!validateYearRange(year)) {
 			return false;
 		}
@@ -486,7 +551,7 @@ class DateTime {
 	 * @return true Pass
 	 * @return false NG
 	 */
-	auto validateHourRange(int hour) const -> bool { return hour >= 0 && hour <= 23; }
+	static auto validateHourRange(int hour) -> bool { return hour >= 0 && hour <= 23; }
 
 	/**
 	 * @brief 分の範囲チェック
@@ -495,7 +560,7 @@ class DateTime {
 	 * @return true Pass
 	 * @return false NG
 	 */
-	auto validateMinuteRange(int minute) const -> bool { return minute >= 0 && minute <= 59; }
+	static auto validateMinuteRange(int minute) -> bool { return minute >= 0 && minute <= 59; }
 
 	/**
 	 * @brief 秒の範囲チェック
@@ -504,7 +569,7 @@ class DateTime {
 	 * @return true Pass
 	 * @return false NG
 	 */
-	auto validateSecondRange(int second) const -> bool { return second >= 0 && second <= 59; }
+	static auto validateSecondRange(int second) -> bool { return second >= 0 && second <= 59; }
 
 	/**
 	 * @brief マイクロ秒の範囲チェック
@@ -513,7 +578,7 @@ class DateTime {
 	 * @return true Pass
 	 * @return false NG
 	 */
-	auto validateMicrosecondRange(int microsecond) const -> bool { return microsecond >= 0 && microsecond <= 999999; }
+	static auto validateMicrosecondRange(int microsecond) -> bool { return microsecond >= 0 && microsecond <= 999999; }
 
 	/**
 	 * @brief 時間の範囲チェック
@@ -527,7 +592,7 @@ class DateTime {
 	 * @return true Pass
 	 * @return false NG
 	 */
-	auto validateTime(int hour, int minute, int second, int microsecond) const -> bool {
+	static auto validateTime(int hour, int minute, int second, int microsecond) -> bool {
 		if (!validateHourRange(hour)) {
 			return false;
 		}
@@ -575,54 +640,17 @@ class DateTime {
 		m_ticks = TimeSpan(absoluteDay(year, month, day), hour, minute, second, microsecond).ticks();
 	}
 
-	auto initialize(const std::string& date_time) -> void {
-		std::int32_t year, month, day, hour, minute, second, microsecond;
-		year = iso8601BlocktoInt(date_time, 0, 4);
-		month = iso8601BlocktoInt(date_time, 5, 7);
-		day = iso8601BlocktoInt(date_time, 8, 10);
-		if (date_time.length() <= 10) {
-			initialize(year, month, day, 0, 0, 0, 0);
-		} else {
-			hour = iso8601BlocktoInt(date_time, 11, 13);
-			minute = iso8601BlocktoInt(date_time, 14, 16);
-
-			std::string sec_tz = date_time.substr(17);
-
-			// タイムゾーンの位置を探す
-			std::size_t tz_pos = 0;
-			while (tz_pos < sec_tz.length()) {
-				if (sec_tz[tz_pos] == 'Z' || sec_tz[tz_pos] == '+' || sec_tz[tz_pos] == '-') {
-					break;
-				}
-				tz_pos++;
-			}
-
-			iso8601BlocktoDecimal(sec_tz, 0, tz_pos - 1, second, microsecond);
-
-			if (tz_pos == sec_tz.length()) {
-				initialize(year, month, day, hour, minute, second, microsecond);
-			} else {
-				std::string tz = sec_tz.substr(tz_pos);
-				if (tz[0] == 'Z' || tz == "+00:00" || tz == "-00:00" || tz == "UTC" || tz == "GMT") {
-					initialize(year, month, day, hour, minute, second, microsecond);
-				} else {
-					int tz_hour = iso8601BlocktoInt(tz, 1, 3);
-					int tz_minute = iso8601BlocktoInt(tz, 4, 6);
-					initialize(year, month, day, hour, minute, second, microsecond);
-					if (tz[0] == '-') {
-						m_ticks += TimeSpan(tz_hour, tz_minute, 0).ticks();
-					} else {
-						m_ticks -= TimeSpan(tz_hour, tz_minute, 0).ticks();
-					}
-				}
-			}
-		}
-	}
-
-	auto iso8601BlocktoInt(const std::string& str, int begin, int end) const -> int {
+	/**
+	 * @brief 固定桁の10進数を読み込む
+	 *
+	 * @param str 文字列
+	 * @param digits 桁数
+	 * @return int 値
+	 */
+	static auto parseDigits(const char* str, int digits) -> int {
 		int value = 0;
-		for (int i = begin; i < end; i++) {
-			if (str[i] < '0' || str[i] > '9') {
+		for (int i = 0; i < digits; i++) {
+			if (!isDigit(str[i])) {
 				throw DateTimeException("Invalid integer string", DateTimeException::InvalidIso8601Format);
 			}
 			value = value * 10 + (str[i] - '0');
@@ -630,83 +658,91 @@ class DateTime {
 		return value;
 	}
 
-	auto iso8601BlocktoDecimal(const std::string& str, int begin, int end, int& integer, int& decimal) const -> double {
-		double ret = 0;
-		std::int32_t div = 1;
-		std::int32_t decimal_point_pos = begin;
-
-		while (decimal_point_pos <= end) {
-			if (str[decimal_point_pos] == '.') {
-				break;
-			}
-			decimal_point_pos++;
+	/**
+	 * @brief 固定桁の10進数を書き込む
+	 *
+	 * @param buf 書き込み先
+	 * @param value 値
+	 * @param digits 桁数
+	 */
+	static auto writeDigits(char* buf, int value, int digits) -> void {
+		for (int i = digits - 1; i >= 0; i--) {
+			buf[i] = static_cast<char>('0' + value % 10);
+			value /= 10;
 		}
+	}
 
-		integer = iso8601BlocktoInt(str, begin, decimal_point_pos);
-		decimal = 0;
+	static auto isDigit(char c) -> bool { return c >= '0' && c <= '9'; }
 
-		if (decimal_point_pos < end) {
-			decimal = iso8601BlocktoInt(str, decimal_point_pos + 1, end + 1);
-			for (int i = decimal_point_pos + 1; i <= end; i++) {
-				div *= 10;
-			}
+	static auto isTimeZoneDesignator(char c) -> bool { return c == 'Z' || c == '+' || c == '-' || c == 'U' || c == 'G'; }
+
+	/**
+	 * @brief タイムゾーン文字列を解析する
+	 *
+	 * @param tz タイムゾーン文字列
+	 * @return std::int64_t UTCからのオフセット [ticks]
+	 */
+	static auto parseTimeZone(std::string_view tz) -> std::int64_t {
+		if (tz == "Z" || tz == "UTC" || tz == "GMT") {
+			return 0;
+		}
+		if (tz[0] != '+' && tz[0] != '-') {
+			throw DateTimeException("Invalid ISO8601 time zone string", DateTimeException::InvalidIso8601Format);
 		}
 
-		ret = static_cast<double>(integer) + static_cast<double>(decimal) / static_cast<double>(div);
+		int tz_hour = 0;
+		int tz_minute = 0;
+		if (tz.length() == 3) {
+			tz_hour = parseDigits(tz.data() + 1, 2);
+		} else if (tz.length() == 5) {
+			tz_hour = parseDigits(tz.data() + 1, 2);
+			tz_minute = parseDigits(tz.data() + 3, 2);
+		} else if (tz.length() == 6 && tz[3] == ':') {
+			tz_hour = parseDigits(tz.data() + 1, 2);
+			tz_minute = parseDigits(tz.data() + 4, 2);
+		} else {
+			throw DateTimeException("Invalid ISO8601 time zone string", DateTimeException::InvalidIso8601Format);
+		}
 
-		decimal = decimal * (1000'000 / div);
+		const std::int64_t offset = tz_hour * constant::ticks_per_hour + tz_minute * constant::ticks_per_minute;
+		return tz[0] == '-' ? -offset : offset;
+	}
 
-		return ret;
+	/**
+	 * @brief グレゴリオ暦の日付から通算日数を求める
+	 * @ref Howard Hinnant, chrono-Compatible Low-Level Date Algorithms
+	 *
+	 * @return std::int64_t 0001-01-01 からの通算日数 [day]
+	 */
+	static auto daysFromCivil(int year, int month, int day) -> std::int64_t {
+		year -= month <= 2;
+		const int era = year / 400;
+		const int yoe = year - era * 400;
+		const int doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+		const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+		return static_cast<std::int64_t>(era) * 146097 + doe - civil_epoch_offset;
 	}
 
+	/**
+	 * @brief 通算日数からグレゴリオ暦の日付を求める
+	 * @ref Howard Hinnant, chrono-Compatible Low-Level Date Algorithms
+	 *
+	 */
 	auto pushDate(int& year, int& month, int& day) const -> void {
-		int total_days = static_cast<int>(m_ticks / constant::ticks_per_day);
-
-		// 年
-		{
-			// 4世紀単位の数
-			int num_4cent = total_days / 146097;
-			total_days -= num_4cent * 146097;
-
-			// 1世紀単位の数
-			int num_1cent = total_days / 36524;
-			if (num_1cent == 4) {
-				// 閏世紀末日
-				num_1cent = 3;
-			}
-			total_days -= num_1cent * 36524;
-
-			// 4年単位の数
-			int num_4year = total_days / 1461;
-			total_days -= num_4year * 1461;
-
-			// 1年単位の数
-			int num_year = total_days / 365;
-			if (num_year == 4) {
-				/*
-				 * 閏年末日
-				 */
-				num_year = 3;
-			}
-			total_days -= num_year * 365;
-
-			year = (num_4cent * 400) + (num_1cent * 100) + (num_4year * 4) + num_year + 1;
-		}
-
-		// 月
-		{
-			const auto& dyas_in_mounth = constant::dyas_in_mounth[isLeapYear(year)];
-			month = 1;
-			while (total_days >= dyas_in_mounth[month] && month <= 12) {
-				total_days -= dyas_in_mounth[month++];
-			}
-		}
-
-		// 日
-		day = total_days + 1;
+		const int z = static_cast<int>(m_ticks / constant::ticks_per_day) + civil_epoch_offset;
+		const int era = z / 146097;
+		const int doe = z - era * 146097;
+		const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+		const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+		const int mp = (5 * doy + 2) / 153;
+
+		day = doy - (153 * mp + 2) / 5 + 1;
+		month = mp < 10 ? mp + 3 : mp - 9;
+		year = yoe + era * 400 + (month <= 2);
 	}
 
-	auto band(const double x, const double l, const double r) const -> bool { return x >= l && x < r; }
+	static constexpr int civil_epoch_offset = 306; // 0000-03-01 から 0001-01-01 までの日数
+
 
 	friend auto operator+(const DateTime& dt, TimeSpan ts) -> DateTime { return DateTime(dt.ticks() + ts.ticks()); }
 
@@ -737,4 +773,6 @@ class DateTime {
 	friend auto operator<=(const DateTime& dt1, const DateTime& dt2) -> bool { return dt1.ticks() <= dt2.ticks(); }
 };
 
-SATFIND_NAMESPACE_END
\ No newline at end of file
+SATFIND_NAMESPACE_END
+
+#include "DeltaT.hpp"
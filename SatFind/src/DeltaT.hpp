@@ -0,0 +1,305 @@
+/**
+ * @file DeltaT.hpp
+ * @author fugu133
+ * @brief ΔT (TT - UT) の表
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <charconv>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DateTime.hpp"
+#include "Essential.hpp"
+#include "Polynomial.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief ΔT (TT - UT) の表
+ * @note 1900年1月から2150年12月までの月ごとのノードを持ち, ノード間を線形補間する.
+ *       ノードは平均グレゴリオ月 (365.2425 / 12 日) の等間隔に置くため, 時刻からノード番号を除算1回で求められる
+ * @remark 表の範囲外は多項式 (polynomial) で近似する
+ */
+class DeltaT {
+  public:
+	/**
+	 * @brief Construct a new Delta T object
+	 * @note 全ノードを多項式から求める
+	 */
+	DeltaT() : m_values(node_count) {
+		for (std::size_t k = 0; k < node_count; k++) {
+			m_values[k] = polynomial(first_year + (static_cast<double>(k) + 0.5) / 12.0);
+		}
+	}
+
+	/**
+	 * @brief 観測値で置き換えた表を作成する
+	 * @note 観測値の範囲内にあるノードは観測値の線形補間で置き換え, 範囲外のノードは多項式の値を保持する
+	 *
+	 * @param observed 観測値の一覧 (時刻の昇順)
+	 * @return DeltaT
+	 */
+	static auto fromObserved(const std::vector<std::pair<DateTime, double>>& observed) -> DeltaT {
+		DeltaT ret;
+		if (observed.empty()) {
+			return ret;
+		}
+
+		std::size_t j = 0;
+		for (std::size_t k = 0; k < node_count; k++) {
+			const std::int64_t t = nodeTicks(k);
+			if (t < observed.front().first.ticks() || t > observed.back().first.ticks()) {
+				continue;
+			}
+			while (j + 2 < observed.size() && observed[j + 1].first.ticks() < t) {
+				j++;
+			}
+			if (j + 1 >= observed.size()) {
+				ret.m_values[k] = observed[j].second;
+				continue;
+			}
+			const auto& [t0, v0] = observed[j];
+			const auto& [t1, v1] = observed[j + 1];
+			const double w = static_cast<double>(t - t0.ticks()) / static_cast<double>(t1.ticks() - t0.ticks());
+			ret.m_values[k] = v0 + w * (v1 - v0);
+		}
+		return ret;
+	}
+
+	/**
+	 * @brief IERS/USNO の観測値ファイル (deltat.data 形式) から読み込む
+	 * @note 1行に "年 月 日 ΔT[s]" を持つ形式と, "小数年 ΔT[s]" の2列形式を受け付ける. 数値で始まらない行は読み飛ばす
+	 *
+	 * @param stream 入力ストリーム
+	 * @return DeltaT
+	 */
+	static auto fromIers(std::istream& stream) -> DeltaT {
+		std::vector<std::pair<DateTime, double>> observed;
+		std::string line;
+		while (std::getline(stream, line)) {
+			double fields[4];
+			const std::size_t n = splitNumbers(line, fields);
+			if (n == 0) {
+				continue;
+			}
+
+			DateTime dt;
+			double value;
+			if (n >= 4) {
+				dt = DateTime(static_cast<int>(fields[0]), static_cast<int>(fields[1]), static_cast<int>(fields[2]), 0, 0, 0, 0);
+				value = fields[3];
+			} else if (n == 2) {
+				const int year = static_cast<int>(std::floor(fields[0]));
+				const DateTime year_begin(year, 1, 1, 0, 0, 0, 0);
+				const DateTime next_year_begin(year + 1, 1, 1, 0, 0, 0, 0);
+				dt = year_begin + TimeSpan(static_cast<std::int64_t>((fields[0] - year) * (next_year_begin - year_begin).ticks()));
+				value = fields[1];
+			} else {
+				throw DateTimeException("Invalid delta T record: " + line, DateTimeException::InvalidDeltaT);
+			}
+
+			if (!observed.empty() && dt <= observed.back().first) {
+				throw DateTimeException("Delta T records must be in ascending order", DateTimeException::InvalidDeltaT);
+			}
+			observed.emplace_back(dt, value);
+		}
+
+		if (observed.empty()) {
+			throw DateTimeException("Delta T file has no records", DateTimeException::InvalidDeltaT);
+		}
+		return fromObserved(observed);
+	}
+
+	/**
+	 * @brief IERS/USNO の観測値ファイル (deltat.data 形式) から読み込む
+	 *
+	 * @param path ファイルパス
+	 * @return DeltaT
+	 */
+	static auto fromIersFile(const std::string& path) -> DeltaT {
+		std::ifstream ifs(path);
+		if (!ifs) {
+			throw DateTimeException("Cannot open delta T file: " + path, DateTimeException::InvalidDeltaT);
+		}
+		return fromIers(ifs);
+	}
+
+	/**
+	 * @brief ΔTを取得する
+	 *
+	 * @param dt 時刻
+	 * @return double ΔT [s]
+	 */
+	auto seconds(const DateTime& dt) const -> double {
+		const std::int64_t offset = dt.ticks() - nodeTicks(0);
+		if (offset < 0 || offset >= static_cast<std::int64_t>(node_count - 1) * node_step_ticks) {
+			return polynomial(dt.year() + (dt.month() - 0.5) / 12.0);
+		}
+
+		const std::int64_t k = offset / node_step_ticks;
+		const double w = static_cast<double>(offset - k * node_step_ticks) / static_cast<double>(node_step_ticks);
+		const double v0 = m_values[static_cast<std::size_t>(k)];
+		const double v1 = m_values[static_cast<std::size_t>(k) + 1];
+		return v0 + w * (v1 - v0);
+	}
+
+	/**
+	 * @brief ΔTを取得する
+	 *
+	 * @param dt 時刻
+	 * @return TimeSpan ΔT
+	 */
+	auto at(const DateTime& dt) const -> TimeSpan { return TimeSpan(seconds(dt), TimeUnit::Seconds); }
+
+	/**
+	 * @brief 指定した時刻が表の範囲内か判定する
+	 *
+	 * @param dt 時刻
+	 */
+	auto covers(const DateTime& dt) const -> bool {
+		return dt.ticks() >= nodeTicks(0) && dt.ticks() < nodeTicks(node_count - 1);
+	}
+
+	/**
+	 * @brief ΔTの多項式近似
+	 * @note https://eclipse.gsfc.nasa.gov/SEhelp/deltatpoly2004.html
+	 *
+	 * @param y 小数年 (月の中央は 年 + (月 - 0.5) / 12)
+	 * @return double ΔT [s]
+	 */
+	static auto polynomial(double y) -> double {
+		const double years = std::floor(y);
+
+		if (years < -500) {
+			return Polynomial::deg2((y - 1820) / 100, -20, 0, 32);
+		} else if (band(years, -500, 500)) {
+			return Polynomial::deg6(y / 100, 10583.6, -1014.41, 33.78311, -5.952053, -0.1798452, 0.022174192, 0.0090316521);
+		} else if (band(years, 500, 1600)) {
+			return Polynomial::deg6((y - 1000) / 100, 1574.2, -556.01, 71.23472, 0.319781, -0.8503463, -0.005050998, 0.0083572073);
+		} else if (band(years, 1600, 1700)) {
+			return Polynomial::deg3(y - 1600, 120, -0.9808, -0.01532, 1.0 / 7129.0);
+		} else if (band(years, 1700, 1800)) {
+			return Polynomial::deg4(y - 1700, 8.83, 0.1603, -0.0059285, 0.00013336, -1.0 / 1174000.0);
+		} else if (band(years, 1800, 1860)) {
+			return Polynomial::deg7(y - 1800, 13.72, -0.332447, 0.0068612, 0.0041116, -0.00037436, 0.0000121272, -0.0000001699,
+									0.000000000875);
+		} else if (band(years, 1860, 1900)) {
+			return Polynomial::deg5(y - 1860, 7.62, 0.5737, -0.251754, 0.01680668, -0.0004473624, 1.0 / 233174.0);
+		} else if (band(years, 1900, 1920)) {
+			return Polynomial::deg4(y - 1900, -2.79, 1.494119, -0.0598939, 0.0061966, -0.000197);
+		} else if (band(years, 1920, 1941)) {
+			return Polynomial::deg3(y - 1920, 21.20, 0.84493, -0.076100, 0.0020936);
+		} else if (band(years, 1941, 1961)) {
+			return Polynomial::deg3(y - 1950, 29.07, 0.407, -1.0 / 233.0, 1.0 / 2547.0);
+		} else if (band(years, 1961, 1986)) {
+			return Polynomial::deg3(y - 1975, 45.45, 1.067, -1.0 / 260.0, -1.0 / 718.0);
+		} else if (band(years, 1986, 2005)) {
+			return Polynomial::deg5(y - 2000, 63.86, 0.3345, -0.060374, 0.0017275, 0.000651814, 0.00002373599);
+		} else if (band(years, 2005, 2050)) {
+			return Polynomial::deg2(y - 2000, 62.92, 0.32217, 0.005589);
+		} else if (band(years, 2050, 2150)) {
+			return Polynomial::deg2((y - 1820) / 100, -20 - 0.5628 * (2150 - y), 0, 32);
+		} else {
+			return Polynomial::deg2((y - 1820) / 100, -20, 0, 32);
+		}
+	}
+
+	/**
+	 * @brief DateTime::deltaT() が参照する表を取得する
+	 *
+	 * @return const DeltaT&
+	 */
+	static auto current() -> const DeltaT& {
+		const DeltaT* table = s_current.load(std::memory_order_acquire);
+		return table != nullptr ? *table : defaultTable();
+	}
+
+	/**
+	 * @brief DateTime::deltaT() が参照する表を置き換える
+	 * @note 置き換え前の表への参照は無効にならない
+	 *
+	 * @param table ΔTの表
+	 */
+	static auto setCurrent(DeltaT table) -> void {
+		static std::mutex mutex;
+		static std::vector<std::unique_ptr<const DeltaT>> installed;
+
+		std::lock_guard<std::mutex> lock(mutex);
+		installed.push_back(std::make_unique<const DeltaT>(std::move(table)));
+		s_current.store(installed.back().get(), std::memory_order_release);
+	}
+
+	/**
+	 * @brief DateTime::deltaT() が参照する表を多項式から求めた既定の表に戻す
+	 *
+	 */
+	static auto resetCurrent() -> void { s_current.store(nullptr, std::memory_order_release); }
+
+  private:
+	std::vector<double> m_values; // 各ノードのΔT [s]
+
+	static constexpr int first_year = 1900;
+	static constexpr int last_year = 2150;
+	static constexpr std::size_t node_count = (last_year - first_year + 1) * 12;
+	static constexpr std::int64_t first_year_ticks = 693595LL * constant::ticks_per_day; // 1900-01-01T00:00:00
+	static constexpr std::int64_t node_step_ticks = 2629746LL * constant::ticks_per_second; // 平均グレゴリオ月 (365.2425 / 12 日)
+
+	inline static std::atomic<const DeltaT*> s_current{nullptr};
+
+	static auto defaultTable() -> const DeltaT& {
+		static const DeltaT table;
+		return table;
+	}
+
+	/**
+	 * @brief k番目のノードの時刻 (月の中央)
+	 *
+	 */
+	static constexpr auto nodeTicks(std::size_t k) -> std::int64_t {
+		return first_year_ticks + static_cast<std::int64_t>(2 * k + 1) * node_step_ticks / 2;
+	}
+
+	static auto band(const double x, const double l, const double r) -> bool { return x >= l && x < r; }
+
+	/**
+	 * @brief 空白区切りの数値を読み込む
+	 *
+	 * @param line 行
+	 * @param fields 読み込んだ数値 (最大4個)
+	 * @return std::size_t 読み込んだ個数. 先頭が数値でない場合は0
+	 */
+	static auto splitNumbers(std::string_view line, double (&fields)[4]) -> std::size_t {
+		std::size_t n = 0;
+		std::size_t pos = 0;
+		while (n < 4) {
+			while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t' || line[pos] == '\r')) pos++;
+			if (pos >= line.size()) {
+				break;
+			}
+			const char* begin = line.data() + pos;
+			const auto [ptr, ec] = std::from_chars(begin, line.data() + line.size(), fields[n]);
+			if (ec != std::errc()) {
+				break;
+			}
+			pos += static_cast<std::size_t>(ptr - begin);
+			n++;
+		}
+		return n;
+	}
+};
+
+inline auto DateTime::deltaT() const -> TimeSpan { return DeltaT::current().at(*this); }
+
+SATFIND_NAMESPACE_END
@@ -0,0 +1,323 @@
+/**
+ * @file EarthOrientation.hpp
+ * @author fugu133
+ * @brief 地球姿勢パラメータ (EOP) テーブル
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DateTime.hpp"
+#include "Essential.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief 地球姿勢パラメータの1レコード
+ *
+ */
+struct EopRecord {
+	double mjd;		// 修正ユリウス日 (UTC 0h) [day]
+	double x_pole;	// 極運動 x [arcsec]
+	double y_pole;	// 極運動 y [arcsec]
+	double ut1_utc; // UT1-UTC [s]
+	double lod;		// 日長超過 LOD [ms]
+	double dpsi;	// 章動補正 δΔψ (IAU1980) [mas]
+	double deps;	// 章動補正 δΔε (IAU1980) [mas]
+};
+
+/**
+ * @brief IERS finals ファイルの種別
+ *
+ */
+enum class EopFormat {
+	Finals1980,	 // finals.all / finals.data (章動補正は δΔψ, δΔε)
+	Finals2000A, // finals2000A.all / finals2000A.data (章動補正は dX, dY のため読み込まない)
+};
+
+/**
+ * @brief 地球姿勢パラメータ (EOP) テーブル
+ * @note IERS Rapid Service の finals 形式 (固定桁) を読み込み, 日ごとのノード間を線形補間する
+ * @remark テーブル範囲外の時刻は端のレコードの値を保持する
+ */
+class EarthOrientationParameters {
+  public:
+	EarthOrientationParameters() : m_is_uniform(true) {}
+
+	/**
+	 * @brief Construct a new Earth Orientation Parameters object
+	 *
+	 * @param finals IERS finals 形式のストリーム
+	 * @param format ファイルの種別
+	 */
+	EarthOrientationParameters(std::istream& finals, EopFormat format = EopFormat::Finals1980) : EarthOrientationParameters() {
+		read(finals, format);
+	}
+
+	/**
+	 * @brief IERS finals 形式のファイルから読み込む
+	 *
+	 * @param path ファイルパス
+	 * @param format ファイルの種別
+	 * @return EarthOrientationParameters
+	 */
+	static auto fromFile(const std::string& path, EopFormat format = EopFormat::Finals1980) -> EarthOrientationParameters {
+		std::ifstream ifs(path);
+		if (!ifs) {
+			throw EarthOrientationException("Cannot open EOP file: " + path, EarthOrientationException::FileOpenError);
+		}
+		return EarthOrientationParameters(ifs, format);
+	}
+
+	/**
+	 * @brief IERS finals 形式のストリームから読み込む
+	 * @note UT1-UTC または極運動が空欄の行 (予報の末尾) は読み飛ばす
+	 *
+	 * @param finals IERS finals 形式のストリーム
+	 * @param format ファイルの種別
+	 */
+	void read(std::istream& finals, EopFormat format = EopFormat::Finals1980) {
+		std::string line;
+		while (std::getline(finals, line)) {
+			if (!line.empty() && line.back() == '\r') {
+				line.pop_back();
+			}
+
+			EopRecord record;
+			if (parseFinalsLine(line, format, record)) {
+				add(record);
+			}
+		}
+
+		if (m_records.empty()) {
+			throw EarthOrientationException("EOP table is empty", EarthOrientationException::EmptyTable);
+		}
+	}
+
+	/**
+	 * @brief レコードを追加する
+	 * @note レコードは修正ユリウス日の昇順で追加すること
+	 *
+	 * @param record EOPレコード
+	 */
+	void add(const EopRecord& record) {
+		if (!m_records.empty()) {
+			const double step = record.mjd - m_records.back().mjd;
+			if (step <= 0.0) {
+				throw EarthOrientationException("EOP records must be in ascending order", EarthOrientationException::InvalidRecord);
+			}
+			m_is_uniform = m_is_uniform && step == 1.0;
+		}
+		m_records.push_back(record);
+	}
+
+	/**
+	 * @brief 指定した時刻のEOPを補間して取得する
+	 *
+	 * @param utc 時刻 (UTC)
+	 * @return EopRecord 補間したEOP
+	 */
+	auto at(const DateTime& utc) const -> EopRecord { return atMjd(modifiedJulianDay(utc)); }
+
+	/**
+	 * @brief 指定した修正ユリウス日のEOPを補間して取得する
+	 * @note UT1-UTC はうるう秒による1秒の跳びを除去してから補間する
+	 *
+	 * @param mjd 修正ユリウス日 (UTC) [day]
+	 * @return EopRecord 補間したEOP
+	 */
+	auto atMjd(double mjd) const -> EopRecord {
+		if (m_records.empty()) {
+			throw EarthOrientationException("EOP table is empty", EarthOrientationException::EmptyTable);
+		}
+		if (mjd <= m_records.front().mjd) {
+			return withMjd(m_records.front(), mjd);
+		}
+		if (mjd >= m_records.back().mjd) {
+			return withMjd(m_records.back(), mjd);
+		}
+
+		const std::size_t i = lowerNode(mjd);
+		const EopRecord& a = m_records[i];
+		const EopRecord& b = m_records[i + 1];
+		const double w = (mjd - a.mjd) / (b.mjd - a.mjd);
+
+		// うるう秒の跳びは次のノード (UTC 0h) で生じるため, 区間内は手前側の連続値で補間する
+		const double dut1 = b.ut1_utc - a.ut1_utc;
+		const double leap = std::round(dut1);
+
+		EopRecord r;
+		r.mjd = mjd;
+		r.x_pole = a.x_pole + w * (b.x_pole - a.x_pole);
+		r.y_pole = a.y_pole + w * (b.y_pole - a.y_pole);
+		r.ut1_utc = a.ut1_utc + w * (dut1 - leap);
+		r.lod = a.lod + w * (b.lod - a.lod);
+		r.dpsi = a.dpsi + w * (b.dpsi - a.dpsi);
+		r.deps = a.deps + w * (b.deps - a.deps);
+		return r;
+	}
+
+	/**
+	 * @brief 指定した時刻がテーブルの範囲内か判定する
+	 *
+	 * @param utc 時刻 (UTC)
+	 */
+	auto covers(const DateTime& utc) const -> bool {
+		const double mjd = modifiedJulianDay(utc);
+		return !m_records.empty() && mjd >= m_records.front().mjd && mjd <= m_records.back().mjd;
+	}
+
+	/**
+	 * @brief 指定した期間のレコードのみを持つテーブルを取得する
+	 * @note 補間に必要な前後1ノードを含める
+	 *
+	 * @param begin 開始時刻 (UTC)
+	 * @param end 終了時刻 (UTC)
+	 * @return EarthOrientationParameters
+	 */
+	auto slice(const DateTime& begin, const DateTime& end) const -> EarthOrientationParameters {
+		EarthOrientationParameters ret;
+		if (m_records.empty()) {
+			return ret;
+		}
+
+		const double mjd_begin = modifiedJulianDay(begin);
+		const double mjd_end = modifiedJulianDay(end);
+		const std::size_t first = mjd_begin <= m_records.front().mjd ? 0 : lowerNode(std::min(mjd_begin, m_records.back().mjd));
+		std::size_t last = mjd_end >= m_records.back().mjd ? m_records.size() - 1 : lowerNode(std::max(mjd_end, m_records.front().mjd)) + 1;
+		last = std::min(last, m_records.size() - 1);
+
+		for (std::size_t i = first; i <= last; i++) {
+			ret.add(m_records[i]);
+		}
+		return ret;
+	}
+
+	auto records() const -> const std::vector<EopRecord>& { return m_records; }
+
+	auto empty() const -> bool { return m_records.empty(); }
+
+	auto size() const -> std::size_t { return m_records.size(); }
+
+	/**
+	 * @brief 修正ユリウス日 (UTC) を取得する
+	 * @note DateTime::modifiedJulianDay() と同値だが整数演算で日数を求める
+	 *
+	 * @param utc 時刻 (UTC)
+	 * @return double 修正ユリウス日 [day]
+	 */
+	static auto modifiedJulianDay(const DateTime& utc) -> double {
+		const std::int64_t days = utc.ticks() / constant::ticks_per_day;
+		const std::int64_t rest = utc.ticks() % constant::ticks_per_day;
+		return static_cast<double>(days - mjd_epoch_days) + static_cast<double>(rest) / constant::ticks_per_day;
+	}
+
+  private:
+	std::vector<EopRecord> m_records;
+	bool m_is_uniform; // ノードが1日間隔で連続しているかどうか
+
+	static constexpr std::int64_t mjd_epoch_days = 678575; // 0001-01-01 から MJD 0 (1858-11-17) までの日数
+
+	/* finals 形式の桁位置 (0始まり) */
+	static constexpr std::size_t finals_pos_mjd = 7;
+	static constexpr std::size_t finals_len_mjd = 8;
+	static constexpr std::size_t finals_pos_x_pole = 18;
+	static constexpr std::size_t finals_len_x_pole = 9;
+	static constexpr std::size_t finals_pos_y_pole = 37;
+	static constexpr std::size_t finals_len_y_pole = 9;
+	static constexpr std::size_t finals_pos_ut1_utc = 58;
+	static constexpr std::size_t finals_len_ut1_utc = 10;
+	static constexpr std::size_t finals_pos_lod = 79;
+	static constexpr std::size_t finals_len_lod = 7;
+	static constexpr std::size_t finals_pos_dpsi = 97;
+	static constexpr std::size_t finals_len_dpsi = 9;
+	static constexpr std::size_t finals_pos_deps = 116;
+	static constexpr std::size_t finals_len_deps = 9;
+
+	/**
+	 * @brief 指定した修正ユリウス日の直前のノード番号を取得する
+	 *
+	 * @param mjd 修正ユリウス日 (テーブル範囲内) [day]
+	 */
+	auto lowerNode(double mjd) const -> std::size_t {
+		if (m_is_uniform) {
+			const auto i = static_cast<std::size_t>(mjd - m_records.front().mjd);
+			return std::min(i, m_records.size() - 2);
+		}
+
+		const auto it =
+		  std::upper_bound(m_records.begin(), m_records.end(), mjd, [](double v, const EopRecord& r) { return v < r.mjd; });
+		return static_cast<std::size_t>(std::distance(m_records.begin(), it)) - 1;
+	}
+
+	static auto withMjd(EopRecord record, double mjd) -> EopRecord {
+		record.mjd = mjd;
+		return record;
+	}
+
+	/**
+	 * @brief 固定桁の数値フィールドを読み込む
+	 *
+	 * @param line 行
+	 * @param pos 開始位置
+	 * @param len 桁数
+	 * @param value 読み込んだ値
+	 * @return true 数値を読み込めた
+	 * @return false 空欄または範囲外
+	 */
+	static auto parseField(std::string_view line, std::size_t pos, std::size_t len, double& value) -> bool {
+		if (pos >= line.size()) {
+			return false;
+		}
+
+		std::string_view field = line.substr(pos, len);
+		while (!field.empty() && field.front() == ' ') field.remove_prefix(1);
+		while (!field.empty() && field.back() == ' ') field.remove_suffix(1);
+		if (field.empty()) {
+			return false;
+		}
+		if (field.front() == '+') {
+			field.remove_prefix(1);
+		}
+
+		const auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+		if (ec != std::errc() || ptr != field.data() + field.size()) {
+			throw EarthOrientationException("Invalid EOP field: " + std::string(field), EarthOrientationException::InvalidRecord);
+		}
+		return true;
+	}
+
+	static auto parseFinalsLine(std::string_view line, EopFormat format, EopRecord& record) -> bool {
+		if (!parseField(line, finals_pos_mjd, finals_len_mjd, record.mjd)) {
+			return false;
+		}
+		if (!parseField(line, finals_pos_x_pole, finals_len_x_pole, record.x_pole) ||
+			!parseField(line, finals_pos_y_pole, finals_len_y_pole, record.y_pole) ||
+			!parseField(line, finals_pos_ut1_utc, finals_len_ut1_utc, record.ut1_utc)) {
+			return false;
+		}
+		if (!parseField(line, finals_pos_lod, finals_len_lod, record.lod)) {
+			record.lod = 0.0;
+		}
+		if (format != EopFormat::Finals1980 || !parseField(line, finals_pos_dpsi, finals_len_dpsi, record.dpsi) ||
+			!parseField(line, finals_pos_deps, finals_len_deps, record.deps)) {
+			record.dpsi = 0.0;
+			record.deps = 0.0;
+		}
+		return true;
+	}
+};
+
+SATFIND_NAMESPACE_END
@@ -0,0 +1,326 @@
+/**
+ * @file ElementCache.hpp
+ * @author fugu133
+ * @brief 初期化済みの軌道要素のバイナリキャッシュ
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "Essential.hpp"
+#include "MappedFile.hpp"
+#include "OrbitalPropagator.hpp"
+#include "Tle.hpp"
+#include "TleCatalogReader.hpp"
+#include "Tracing.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief キャッシュ中の1天体分のレコード
+ * @note 固定長でメモリマップした領域をそのまま参照する. 文字列はヌル文字で埋める
+ */
+struct ElementCacheRecord {
+	std::int32_t catalog_number;									  // 衛星カタログ番号
+	std::uint32_t reserved;											  // 予約 (0)
+	std::int64_t epoch_ticks;										  // 軌道要素UTC元期 [ticks]
+	char name[32];													  // オブジェクト名
+	char international_designator[16];								  // 国際設計識別符号
+	char tle1[72];													  // TLE 1行目
+	char tle2[72];													  // TLE 2行目
+	alignas(8) unsigned char state[sizeof(OrbitalPropagator::State)]; // 初期化済みの伝搬器 (OrbitalPropagator::State)
+};
+
+/**
+ * @brief 初期化済みの軌道要素のバイナリキャッシュ
+ * @note TLE の解析結果と OrbitalPropagator の初期化済みの定数を固定長レコードで保存し, 読み込み時はファイルを
+ *       メモリマップしてそのまま参照する. 伝搬器はレコードの複製のみで復元し, 初期化の計算を行わない
+ * @remark 形式はリトルエンディアンで, ヘッダにマジック, 版, レコード長, 元の TLE のハッシュ, レコード全体のチェックサム,
+ *         ヘッダのチェックサムを持つ. 開くときはヘッダとファイル長のみを検査し, レコードのチェックサムは verify() で検査する.
+ *         State のレイアウトはコンパイラに依存するため, レコード長が一致しないキャッシュは無効として扱う
+ */
+class ElementCache {
+  public:
+	ElementCache() : m_header(nullptr), m_records(nullptr) {}
+
+	/**
+	 * @brief キャッシュファイルを開く
+	 *
+	 * @param path キャッシュファイルのパス
+	 */
+	explicit ElementCache(const std::string& path) : m_file(path) {
+		if (!isLittleEndian()) {
+			throw IoException("Element cache requires a little-endian host", IoException::InvalidFormat);
+		}
+		if (m_file.size() < sizeof(Header)) {
+			throw IoException("Element cache is truncated: " + path, IoException::InvalidFormat);
+		}
+
+		m_header = reinterpret_cast<const Header*>(m_file.data());
+		if (std::memcmp(m_header->magic, magic, sizeof(magic)) != 0 || m_header->version != version ||
+			m_header->endian_tag != endian_tag || m_header->header_size != sizeof(Header) ||
+			m_header->record_size != sizeof(ElementCacheRecord)) {
+			throw IoException("Incompatible element cache: " + path, IoException::InvalidFormat);
+		}
+		if (m_header->header_checksum != headerChecksum(*m_header)) {
+			throw IoException("Element cache header is corrupted: " + path, IoException::ChecksumMismatch);
+		}
+		if (m_file.size() != sizeof(Header) + m_header->count * sizeof(ElementCacheRecord)) {
+			throw IoException("Element cache is truncated: " + path, IoException::InvalidFormat);
+		}
+
+		m_records = reinterpret_cast<const ElementCacheRecord*>(m_file.data() + sizeof(Header));
+	}
+
+	/**
+	 * @brief TLE の一覧からキャッシュファイルを作成する
+	 * @note 伝搬器の初期化に失敗した TLE (離心率が範囲外など) は保存しない. 一時ファイルに書き込んでから置き換える
+	 *
+	 * @param path キャッシュファイルのパス
+	 * @param elements TLE の一覧
+	 * @param source_hash 元の TLE のハッシュ (hashSource())
+	 * @return std::size_t 保存したレコードの数
+	 */
+	static auto write(const std::string& path, const std::vector<Tle>& elements, std::uint64_t source_hash) -> std::size_t {
+		if (!isLittleEndian()) {
+			throw IoException("Element cache requires a little-endian host", IoException::InvalidFormat);
+		}
+
+		std::vector<ElementCacheRecord> records;
+		records.reserve(elements.size());
+		for (const auto& tle : elements) {
+			try {
+				const OrbitalPropagator propagator(tle);
+				records.push_back(makeRecord(tle, propagator.state()));
+			} catch (const OrbitException&) {
+				continue;
+			}
+		}
+
+		Header header{};
+		std::memcpy(header.magic, magic, sizeof(magic));
+		header.version = version;
+		header.endian_tag = endian_tag;
+		header.header_size = sizeof(Header);
+		header.record_size = sizeof(ElementCacheRecord);
+		header.count = records.size();
+		header.source_hash = source_hash;
+		header.payload_checksum = hash(records.data(), records.size() * sizeof(ElementCacheRecord));
+		header.header_checksum = headerChecksum(header);
+
+		Tracing::Span span("io", "ElementCache::write", "records", static_cast<std::int64_t>(records.size()));
+		const std::string temp_path = path + ".tmp";
+		{
+			std::ofstream ofs(temp_path, std::ios::binary | std::ios::trunc);
+			if (!ofs) {
+				throw IoException("Cannot open file: " + temp_path, IoException::FileOpenError);
+			}
+			ofs.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+			ofs.write(reinterpret_cast<const char*>(records.data()),
+					  static_cast<std::streamsize>(records.size() * sizeof(ElementCacheRecord)));
+			if (!ofs) {
+				throw IoException("Cannot write file: " + temp_path, IoException::FileWriteError);
+			}
+		}
+		if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+			std::remove(temp_path.c_str());
+			throw IoException("Cannot replace file: " + path, IoException::FileWriteError);
+		}
+		return records.size();
+	}
+
+	/**
+	 * @brief キャッシュを開き, 元の TLE カタログと一致しなければ作り直す
+	 * @note 一致の判定にはカタログ全体のハッシュを用いる. 不正な TLE は読み飛ばす (TleCatalogReader)
+	 *
+	 * @param catalog_path TLE カタログのパス
+	 * @param cache_path キャッシュファイルのパス
+	 * @return ElementCache
+	 */
+	static auto loadOrBuild(const std::string& catalog_path, const std::string& cache_path) -> ElementCache {
+		Tracing::Span span("catalog", "ElementCache::loadOrBuild");
+		const MappedFile catalog(catalog_path);
+		const std::uint64_t source_hash = hashSource(catalog.view());
+
+		try {
+			ElementCache cache(cache_path);
+			if (cache.sourceHash() == source_hash) {
+				return cache;
+			}
+		} catch (const IoException&) {
+			// キャッシュがない, または形式が異なる場合は作り直す
+		}
+
+		TleCatalogReader reader;
+		reader.read(catalog.view());
+		write(cache_path, reader.elements(), source_hash);
+		return ElementCache(cache_path);
+	}
+
+	/**
+	 * @brief 元の TLE カタログのハッシュを求める
+	 *
+	 * @param text TLE カタログの内容
+	 * @return std::uint64_t ハッシュ
+	 */
+	static auto hashSource(std::string_view text) -> std::uint64_t { return hash(text.data(), text.size()); }
+
+	auto size() const -> std::size_t { return m_header != nullptr ? static_cast<std::size_t>(m_header->count) : 0; }
+
+	auto empty() const -> bool { return size() == 0; }
+
+	auto sourceHash() const -> std::uint64_t { return m_header != nullptr ? m_header->source_hash : 0; }
+
+	/**
+	 * @brief レコードのチェックサムを検査する
+	 * @note 全レコードを走査する
+	 *
+	 * @return bool 一致するか
+	 */
+	auto verify() const -> bool {
+		return m_header != nullptr && hash(m_records, size() * sizeof(ElementCacheRecord)) == m_header->payload_checksum;
+	}
+
+	/**
+	 * @brief i番目のレコードを取得する
+	 * @note メモリマップした領域を直接参照する
+	 *
+	 * @param i 番号
+	 * @return const ElementCacheRecord&
+	 */
+	auto record(std::size_t i) const -> const ElementCacheRecord& { return m_records[i]; }
+
+	auto operator[](std::size_t i) const -> const ElementCacheRecord& { return record(i); }
+
+	auto begin() const -> const ElementCacheRecord* { return m_records; }
+
+	auto end() const -> const ElementCacheRecord* { return m_records + size(); }
+
+	auto catalogNumber(std::size_t i) const -> int { return m_records[i].catalog_number; }
+
+	auto name(std::size_t i) const -> std::string_view { return field(m_records[i].name); }
+
+	auto epoch(std::size_t i) const -> DateTime { return DateTime(m_records[i].epoch_ticks); }
+
+	/**
+	 * @brief i番目の TLE を取得する
+	 * @note 保存した行を解析し直す
+	 *
+	 */
+	auto tle(std::size_t i) const -> Tle {
+		const auto& r = m_records[i];
+		return Tle::parse(field(r.name), field(r.tle1), field(r.tle2), TleChecksum::Ignore);
+	}
+
+	/**
+	 * @brief i番目の伝搬器を取得する
+	 * @note 初期化済みの定数を複製するのみで, 初期化の計算を行わない
+	 *
+	 */
+	auto propagator(std::size_t i) const -> OrbitalPropagator {
+		OrbitalPropagator::State state;
+		std::memcpy(&state, m_records[i].state, sizeof(state));
+		return OrbitalPropagator(state);
+	}
+
+  private:
+	/**
+	 * @brief ファイルヘッダ
+	 *
+	 */
+	struct Header {
+		char magic[8];					// "SFELMCHE"
+		std::uint32_t version;			// 形式の版
+		std::uint32_t endian_tag;		// 0x01020304
+		std::uint32_t header_size;		// ヘッダのバイト数
+		std::uint32_t record_size;		// レコードのバイト数
+		std::uint64_t count;			// レコード数
+		std::uint64_t source_hash;		// 元の TLE のハッシュ
+		std::uint64_t payload_checksum; // レコード全体のチェックサム
+		std::uint64_t header_checksum;	// 以上のフィールドのチェックサム
+	};
+
+	static_assert(std::is_trivially_copyable_v<OrbitalPropagator::State>, "OrbitalPropagator::State must be trivially copyable");
+	static_assert(sizeof(Header) == 56, "Unexpected element cache header layout");
+	static_assert(sizeof(ElementCacheRecord) % 8 == 0, "Element cache records must be 8-byte aligned");
+
+	static constexpr char magic[8] = {'S', 'F', 'E', 'L', 'M', 'C', 'H', 'E'};
+	static constexpr std::uint32_t version = 1;
+	static constexpr std::uint32_t endian_tag = 0x01020304;
+
+	MappedFile m_file;					 // キャッシュファイル
+	const Header* m_header;				 // ヘッダ
+	const ElementCacheRecord* m_records; // 先頭のレコード
+
+	static constexpr auto isLittleEndian() -> bool { return std::endian::native == std::endian::little; }
+
+	static auto makeRecord(const Tle& tle, const OrbitalPropagator::State& state) -> ElementCacheRecord {
+		ElementCacheRecord r;
+		std::memset(&r, 0, sizeof(r));
+		r.catalog_number = tle.catalogNumber();
+		r.epoch_ticks = tle.epoch().ticks();
+		copyField(r.name, tle.name());
+		copyField(r.international_designator, tle.internationalDesignator());
+		copyField(r.tle1, tle.tleLine1());
+		copyField(r.tle2, tle.tleLine2());
+		std::memcpy(r.state, &state, sizeof(state));
+		return r;
+	}
+
+	template <std::size_t N>
+	static auto copyField(char (&dst)[N], std::string_view src) -> void {
+		std::memcpy(dst, src.data(), std::min(src.size(), N - 1));
+	}
+
+	template <std::size_t N>
+	static auto field(const char (&src)[N]) -> std::string_view {
+		const void* terminator = std::memchr(src, '\0', N);
+		return std::string_view(src, terminator != nullptr ? static_cast<std::size_t>(static_cast<const char*>(terminator) - src) : N);
+	}
+
+	static auto headerChecksum(const Header& header) -> std::uint64_t { return hash(&header, offsetof(Header, header_checksum)); }
+
+	/**
+	 * @brief 64bit ハッシュ
+	 * @note 8バイト単位で FNV-1a と同じ操作を行い, 最後に攪拌する
+	 *
+	 */
+	static auto hash(const void* data, std::size_t size) -> std::uint64_t {
+		constexpr std::uint64_t prime = 0x100000001b3ULL;
+		const auto* p = static_cast<const unsigned char*>(data);
+		std::uint64_t h = 0xcbf29ce484222325ULL ^ size;
+
+		std::size_t i = 0;
+		for (; i + 8 <= size; i += 8) {
+			std::uint64_t w;
+			std::memcpy(&w, p + i, 8);
+			h = (h ^ w) * prime;
+			h ^= h >> 29;
+		}
+		for (; i < size; i++) {
+			h = (h ^ p[i]) * prime;
+		}
+
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+		return h;
+	}
+};
+
+SATFIND_NAMESPACE_END
@@ -0,0 +1,334 @@
+/**
+ * @file ElementHistory.hpp
+ * @author fugu133
+ * @brief 1衛星の複数元期の軌道要素
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "DateTime.hpp"
+#include "Essential.hpp"
+#include "Executor.hpp"
+#include "OmmReader.hpp"
+#include "OrbitalElements.hpp"
+#include "OrbitalPropagator.hpp"
+#include "TimeGrid.hpp"
+#include "Tle.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief 時刻に対して使用する軌道要素の選び方
+ *
+ */
+enum class EpochSelection {
+	Nearest,   // 元期が最も近い要素 (等距離の場合は前の要素)
+	Preceding, // 元期が時刻以前で最も新しい要素 (時刻が最初の元期より前の場合は最初の要素)
+};
+
+/**
+ * @brief 1衛星の複数元期の軌道要素
+ * @note 元期の昇順に軌道要素を保持し, 時刻ごとに使用する要素を二分探索で選ぶ. 伝搬器は初めて使用したときに初期化する.
+ *       昇順の時刻列は要素の切り替わりを先頭から順に追うため, 時刻ごとの探索と初期化を行わない
+ * @remark 伝搬器を遅延初期化するため, 同じオブジェクトを複数のスレッドから同時に使用できない
+ */
+class ElementHistory {
+  public:
+	ElementHistory() : m_catalog_number(-1) {}
+
+	/**
+	 * @brief Construct a new Element History object
+	 * @exception OrbitException カタログ番号が異なる TLE を含む場合
+	 *
+	 * @param elements 同一衛星の TLE (順不同)
+	 */
+	explicit ElementHistory(const std::vector<Tle>& elements) : ElementHistory() {
+		for (const auto& tle : elements) {
+			add(tle);
+		}
+	}
+
+	/**
+	 * @brief 複数衛星の TLE をカタログ番号ごとに分ける
+	 *
+	 * @param elements TLE (順不同)
+	 * @return std::unordered_map<int, ElementHistory> カタログ番号ごとの軌道要素
+	 */
+	static auto fromCatalog(const std::vector<Tle>& elements) -> std::unordered_map<int, ElementHistory> {
+		std::unordered_map<int, ElementHistory> histories;
+		for (const auto& tle : elements) {
+			histories[tle.catalogNumber()].add(tle);
+		}
+		return histories;
+	}
+
+	/**
+	 * @brief 軌道要素を追加する
+	 * @note 同じ元期の要素がある場合は置き換える
+	 * @exception OrbitException カタログ番号が既存の要素と異なる場合
+	 *
+	 * @param tle TLE
+	 */
+	auto add(const Tle& tle) -> void {
+		checkCatalogNumber(tle.catalogNumber());
+		add(OrbitalElements(tle));
+	}
+
+	/**
+	 * @brief 軌道要素を追加する
+	 * @note 同じ元期の要素がある場合は置き換える
+	 * @exception OrbitException カタログ番号が既存の要素と異なる場合
+	 *
+	 * @param record OMM レコード
+	 */
+	auto add(const OmmRecord& record) -> void {
+		checkCatalogNumber(record.norad_cat_id);
+		add(record.toOrbitalElements());
+	}
+
+	/**
+	 * @brief 軌道要素を追加する
+	 * @note 同じ元期の要素がある場合は置き換える. カタログ番号は確認しない
+	 *
+	 * @param elements 軌道要素
+	 */
+	auto add(const OrbitalElements& elements) -> void {
+		const std::int64_t epoch = elements.epoch.ticks();
+		const auto it = std::lower_bound(m_epochs.begin(), m_epochs.end(), epoch);
+		const auto i = static_cast<std::size_t>(it - m_epochs.begin());
+		if (it != m_epochs.end() && *it == epoch) {
+			m_elements[i] = elements;
+			m_propagators[i].reset();
+			return;
+		}
+		m_epochs.insert(it, epoch);
+		m_elements.insert(m_elements.begin() + static_cast<std::ptrdiff_t>(i), elements);
+		m_propagators.insert(m_propagators.begin() + static_cast<std::ptrdiff_t>(i), std::nullopt);
+	}
+
+	/**
+	 * @brief カタログ番号
+	 * @note TLE または OMM レコードを追加していない場合は -1
+	 *
+	 */
+	auto catalogNumber() const -> int { return m_catalog_number; }
+
+	auto size() const -> std::size_t { return m_epochs.size(); }
+
+	auto empty() const -> bool { return m_epochs.empty(); }
+
+	auto epoch(std::size_t i) const -> DateTime { return DateTime(m_epochs[i]); }
+
+	auto elements(std::size_t i) const -> const OrbitalElements& { return m_elements[i]; }
+
+	/**
+	 * @brief 時刻に対して使用する要素を選ぶ
+	 * @note O(log n)
+	 * @exception OrbitException 要素が空の場合
+	 *
+	 * @param time 時刻
+	 * @param selection 選び方
+	 * @return std::size_t 要素の添字
+	 */
+	auto select(const DateTime& time, EpochSelection selection = EpochSelection::Nearest) const -> std::size_t {
+		checkNotEmpty();
+		const std::int64_t t = time.ticks();
+		const auto it = std::upper_bound(m_epochs.begin(), m_epochs.end(), t);
+		if (it == m_epochs.begin()) {
+			return 0;
+		}
+		const auto i = static_cast<std::size_t>(it - m_epochs.begin()) - 1;
+		return (i + 1 < m_epochs.size() && t >= boundary(i, selection)) ? i + 1 : i;
+	}
+
+	/**
+	 * @brief 要素の伝搬器を取得する
+	 * @note 初めて使用する要素の場合は初期化する
+	 * @exception OrbitException 伝搬器の初期化に失敗した場合
+	 *
+	 * @param i 要素の添字
+	 * @return OrbitalPropagator& 伝搬器
+	 */
+	auto propagator(std::size_t i) -> OrbitalPropagator& {
+		if (!m_propagators[i]) {
+			m_propagators[i].emplace(m_elements[i]);
+		}
+		return *m_propagators[i];
+	}
+
+	/**
+	 * @brief 位置・速度 (TEME) を計算する
+	 *
+	 * @param time 時刻
+	 * @param selection 要素の選び方
+	 * @return CartesianOrbitalElements 位置・速度 (TEME)
+	 */
+	auto trackFlightObject(const DateTime& time, EpochSelection selection = EpochSelection::Nearest) -> CartesianOrbitalElements {
+		return propagator(select(time, selection)).trackFlightObject(time);
+	}
+
+	/**
+	 * @brief 時刻列の各時刻での位置・速度 (TEME) を計算する
+	 * @note 時刻列が昇順の間は要素の切り替わりを順に追い, 二分探索しない. 昇順でない時刻は個別に探索する
+	 *
+	 * @param ticks 時刻 [ticks]
+	 * @param states 出力先 (ticks.size() 個以上)
+	 * @param selection 要素の選び方
+	 */
+	auto trackFlightObject(std::span<const std::int64_t> ticks, StateVector* states, EpochSelection selection = EpochSelection::Nearest)
+	  -> void {
+		if (ticks.empty()) {
+			return;
+		}
+		trackRange(ticks, states, selection, [this](std::size_t i) -> OrbitalPropagator& { return propagator(i); });
+	}
+
+	/**
+	 * @brief 時刻列の各時刻での位置・速度 (TEME) を並列に計算する
+	 * @note 時刻列を OrbitalPropagator::grid_grain 個ずつの区間に分けて実行器に渡す. 使用しうる要素の伝搬器を先に並列に初期化し,
+	 *       区間ごとに伝搬器を複製して伝搬する. 結果は逐次の場合と一致する
+	 * @exception OrbitException 使用する要素の伝搬器の初期化に失敗した場合
+	 *
+	 * @param ticks 時刻 [ticks]
+	 * @param states 出力先 (ticks.size() 個以上)
+	 * @param executor 実行器
+	 * @param selection 要素の選び方
+	 */
+	auto trackFlightObject(std::span<const std::int64_t> ticks, StateVector* states, Executor& executor,
+						   EpochSelection selection = EpochSelection::Nearest) -> void {
+		if (ticks.empty()) {
+			return;
+		}
+		// 時刻の範囲で選ばれうる要素の伝搬器を初期化する. 失敗した要素は使用する区間で再び初期化して例外を送出する
+		const auto [min, max] = std::minmax_element(ticks.begin(), ticks.end());
+		const std::size_t first = select(DateTime(*min), selection);
+		const std::size_t last = select(DateTime(*max), selection);
+		executor.parallelFor(last - first + 1, 1, [&](std::size_t begin, std::size_t end, std::size_t) {
+			for (std::size_t i = first + begin; i < first + end; i++) {
+				try {
+					propagator(i);
+				} catch (const OrbitException&) {
+				}
+			}
+		});
+
+		executor.parallelFor(ticks.size(), OrbitalPropagator::grid_grain, [&](std::size_t begin, std::size_t end, std::size_t) {
+			std::optional<OrbitalPropagator> local;
+			std::size_t local_index = m_elements.size();
+			trackRange(ticks.subspan(begin, end - begin), states + begin, selection, [&](std::size_t i) -> OrbitalPropagator& {
+				if (i != local_index) {
+					local.emplace(m_propagators[i] ? *m_propagators[i] : OrbitalPropagator(m_elements[i]));
+					local_index = i;
+				}
+				return *local;
+			});
+		});
+	}
+
+	/**
+	 * @brief 時刻列の各時刻での位置・速度 (TEME) を計算する
+	 *
+	 * @param grid 時刻列
+	 * @param selection 要素の選び方
+	 * @return std::vector<StateVector> 位置・速度 (TEME)
+	 */
+	auto trackFlightObject(const TimeGrid& grid, EpochSelection selection = EpochSelection::Nearest) -> std::vector<StateVector> {
+		std::vector<StateVector> states(grid.size());
+		trackFlightObject(grid.ticks(), states.data(), selection);
+		return states;
+	}
+
+	auto trackFlightObject(const TimeGrid& grid, Executor& executor, EpochSelection selection = EpochSelection::Nearest)
+	  -> std::vector<StateVector> {
+		std::vector<StateVector> states(grid.size());
+		trackFlightObject(grid.ticks(), states.data(), executor, selection);
+		return states;
+	}
+
+  private:
+	int m_catalog_number;										 // カタログ番号
+	std::vector<std::int64_t> m_epochs;							 // 元期 [ticks] (昇順)
+	std::vector<OrbitalElements> m_elements;					 // 軌道要素 (m_epochs と同じ順序)
+	std::vector<std::optional<OrbitalPropagator>> m_propagators; // 伝搬器 (未使用の要素は空)
+
+	/**
+	 * @brief 要素 i から i + 1 に切り替わる時刻
+	 *
+	 */
+	auto boundary(std::size_t i, EpochSelection selection) const -> std::int64_t {
+		if (selection == EpochSelection::Preceding) {
+			return m_epochs[i + 1];
+		}
+		// t - e[i] <= e[i + 1] - t の間は要素 i を使用する
+		const std::int64_t a = m_epochs[i];
+		const std::int64_t b = m_epochs[i + 1];
+		return a + (b - a) / 2 + 1;
+	}
+
+	auto nextBoundary(std::size_t i, EpochSelection selection) const -> std::int64_t {
+		return i + 1 < m_epochs.size() ? boundary(i, selection) : std::numeric_limits<std::int64_t>::max();
+	}
+
+	/**
+	 * @brief 時刻列の各時刻での位置・速度 (TEME) を計算する
+	 *
+	 * @param ticks 時刻 [ticks] (空でないこと)
+	 * @param states 出力先 (ticks.size() 個以上)
+	 * @param selection 要素の選び方
+	 * @param get get(要素の添字) で伝搬器を取得する関数
+	 */
+	template <class GetPropagator>
+	auto trackRange(std::span<const std::int64_t> ticks, StateVector* states, EpochSelection selection, GetPropagator&& get) const
+	  -> void {
+		std::size_t i = select(DateTime(ticks[0]), selection);
+		std::int64_t next = nextBoundary(i, selection);
+		OrbitalPropagator* current = &get(i);
+
+		for (std::size_t k = 0; k < ticks.size(); k++) {
+			const std::int64_t t = ticks[k];
+			if (k > 0 && t < ticks[k - 1]) {
+				i = select(DateTime(t), selection);
+				next = nextBoundary(i, selection);
+				current = &get(i);
+			}
+			if (t >= next) {
+				while (t >= next) {
+					i++;
+					next = nextBoundary(i, selection);
+				}
+				current = &get(i);
+			}
+			const auto e = current->trackFlightObject(DateTime(t));
+			states[k] = StateVector{t, e.position.elements(), e.velocity.elements()};
+		}
+	}
+
+	auto checkCatalogNumber(int catalog_number) -> void {
+		if (m_catalog_number < 0) {
+			m_catalog_number = catalog_number;
+		} else if (m_catalog_number != catalog_number) {
+			throw OrbitException("Catalog number mismatch in element history", OrbitException::CatalogNumberMismatch);
+		}
+	}
+
+	auto checkNotEmpty() const -> void {
+		if (m_epochs.empty()) {
+			throw OrbitException("Element history is empty", OrbitException::EmptyElementHistory);
+		}
+	}
+};
+
+SATFIND_NAMESPACE_END
@@ -0,0 +1,530 @@
+/**
+ * @file EphemerisExporter.hpp
+ * @author fugu133
+ * @brief 衛星群のエフェメリスの OEM / SP3 出力
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "DateTime.hpp"
+#include "EphemerisWriter.hpp"
+#include "Essential.hpp"
+#include "Exception.hpp"
+#include "Executor.hpp"
+#include "OrbitalElements.hpp"
+#include "OrbitalPropagator.hpp"
+#include "PreciseFrame.hpp"
+#include "SatelliteCatalog.hpp"
+#include "TimeGrid.hpp"
+#include "Tracing.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief 出力する座標系
+ *
+ */
+enum class EphemerisFrame {
+	Teme, // SGP4 の出力のまま
+	Itrf, // 地球固定 (FrameRotationCache が必要)
+	Gcrf, // 慣性系 (FrameRotationCache が必要)
+};
+
+/**
+ * @brief OEM / SP3 出力の設定
+ *
+ */
+struct EphemerisExportOptions {
+	EphemerisFrame frame = EphemerisFrame::Teme;  // 出力する座標系
+	const FrameRotationCache* rotation = nullptr; // ITRF / GCRF への回転 (時刻列の範囲を含むもの)
+	Executor* executor = nullptr;				  // 実行器 (nullptr の場合は threads に従う)
+	std::size_t threads = 0;					  // executor が nullptr の場合の並列数 (0 の場合は共有のスレッドプール)
+	std::size_t chunk_size = 1440;				  // 1作業単位の時刻数
+};
+
+/**
+ * @brief 衛星群のエフェメリスを CCSDS OEM または SP3 形式で出力する
+ * @note 出力を (衛星, 時刻の区間) または時刻の区間ごとの作業単位に分割し, 実行器 (Executor) の作業者が時刻列での一括伝搬,
+ *       座標変換, 整形を並列に行う. 整形済みの作業単位は作業単位の順にまとめて書き込むため, 出力は作業者数によらず同一になる.
+ *       整形済みで書き込み前の作業単位は作業者数の4倍までなので, 使用メモリは出力の長さによらない
+ * @remark 一時ファイルに書き込んでから置き換えるため, 失敗した場合は既存のファイルを変更しない
+ */
+class EphemerisExporter {
+  public:
+	static constexpr std::size_t max_sp3_satellites = 85; // SP3-c の衛星数の上限
+
+	/**
+	 * @brief 衛星ごとの区間からなる OEM を出力する
+	 * @note 衛星ごとに META ブロックとデータ行を handles の順に書き込む. 時刻は UTC
+	 * @exception OrbitException 伝搬に失敗した場合 (減衰など)
+	 * @exception IoException 書き込みに失敗した場合
+	 *
+	 * @param path 出力先のパス
+	 * @param catalog 衛星カタログ
+	 * @param handles 出力する衛星
+	 * @param grid 時刻列 (UTC)
+	 * @param options 設定
+	 * @return std::uint64_t 書き込んだバイト数
+	 */
+	static auto writeOem(const std::string& path, const SatelliteCatalog& catalog, std::span<const SatelliteCatalog::Handle> handles,
+						 const TimeGrid& grid, const EphemerisExportOptions& options = {}) -> std::uint64_t {
+		checkArguments(grid, options);
+		const std::size_t chunks = chunkCount(grid, options);
+
+		std::string header = "CCSDS_OEM_VERS = 2.0\nCREATION_DATE = ";
+		appendDate(header, DateTime::now());
+		header += "\nORIGINATOR = SATFIND\n";
+
+		return run(path, header, handles.size() * chunks, options, [&](std::size_t unit, std::string& out, Workspace& ws) {
+			const std::size_t chunk = unit % chunks;
+			const SatelliteCatalog::Handle handle = handles[unit / chunks];
+			if (chunk == 0) {
+				appendOemMetadata(out, catalog.entry(handle), grid, options.frame);
+			}
+
+			const TimeGrid sub = subGrid(grid, chunk, options);
+			propagate(catalog.propagator(handle), sub, ws, false);
+			transform(sub, options, ws);
+
+			char row[EphemerisWriter::max_row_length];
+			for (const auto& s : ws.states) {
+				out.append(row, EphemerisWriter::formatOemRow(row, s));
+			}
+		});
+	}
+
+	/**
+	 * @brief カタログの全衛星の OEM を出力する
+	 *
+	 */
+	static auto writeOem(const std::string& path, const SatelliteCatalog& catalog, const TimeGrid& grid,
+						 const EphemerisExportOptions& options = {}) -> std::uint64_t {
+		const auto handles = allHandles(catalog);
+		return writeOem(path, catalog, handles, grid, options);
+	}
+
+	/**
+	 * @brief SP3-c (位置・速度) を出力する
+	 * @note 衛星には handles の順に L01, L02, ... の番号を振り, 対応するカタログ番号と衛星名を注釈行に書き込む.
+	 *       位置は [km], 速度は [dm/s], 時計は不明値 (999999.999999). 伝搬できない時刻 (減衰など) は SP3 の規約どおり
+	 *       位置・速度を 0 とする
+	 * @exception OrbitException 衛星数が max_sp3_satellites を超える場合
+	 * @exception IoException 書き込みに失敗した場合
+	 *
+	 * @param path 出力先のパス
+	 * @param catalog 衛星カタログ
+	 * @param handles 出力する衛星
+	 * @param grid 時刻列 (UTC)
+	 * @param options 設定
+	 * @return std::uint64_t 書き込んだバイト数
+	 */
+	static auto writeSp3(const std::string& path, const SatelliteCatalog& catalog, std::span<const SatelliteCatalog::Handle> handles,
+						 const TimeGrid& grid, const EphemerisExportOptions& options = {}) -> std::uint64_t {
+		checkArguments(grid, options);
+		if (handles.size() > max_sp3_satellites) {
+			throw OrbitException("SP3 supports at most 85 satellites", OrbitException::ParameterOutOfRange);
+		}
+
+		return run(path, sp3Header(catalog, handles, grid, options.frame), chunkCount(grid, options), options,
+				   [&](std::size_t unit, std::string& out, Workspace& ws) {
+					   const TimeGrid sub = subGrid(grid, unit, options);
+					   const std::size_t n = sub.size();
+
+					   // 衛星ごとに伝搬して, 時刻ごとに並べ替える
+					   ws.table.resize(handles.size() * n);
+					   ws.valid.resize(handles.size() * n);
+					   for (std::size_t s = 0; s < handles.size(); s++) {
+						   propagate(catalog.propagator(handles[s]), sub, ws, true);
+						   transform(sub, options, ws);
+						   for (std::size_t k = 0; k < n; k++) {
+							   ws.table[k * handles.size() + s] = ws.states[k];
+							   ws.valid[k * handles.size() + s] = ws.valid_states[k];
+						   }
+					   }
+
+					   char line[128];
+					   for (std::size_t k = 0; k < n; k++) {
+						   out.append(line, formatSp3Epoch(line, sub.at(k)));
+						   for (std::size_t s = 0; s < handles.size(); s++) {
+							   const std::size_t i = k * handles.size() + s;
+							   out.append(line, formatSp3Record(line, static_cast<int>(s + 1), ws.table[i], ws.valid[i] != 0));
+						   }
+					   }
+					   if (unit + 1 == chunkCount(grid, options)) {
+						   out += "EOF\n";
+					   }
+				   });
+	}
+
+	/**
+	 * @brief カタログの全衛星の SP3-c を出力する
+	 *
+	 */
+	static auto writeSp3(const std::string& path, const SatelliteCatalog& catalog, const TimeGrid& grid,
+						 const EphemerisExportOptions& options = {}) -> std::uint64_t {
+		const auto handles = allHandles(catalog);
+		return writeSp3(path, catalog, handles, grid, options);
+	}
+
+  private:
+	/**
+	 * @brief 作業スレッドごとの作業領域
+	 *
+	 */
+	struct Workspace {
+		std::vector<StateVector> states; // 1衛星分の状態
+		std::vector<char> valid_states;	 // states の各時刻を伝搬できたか
+		std::vector<StateVector> table;	 // SP3: 時刻 × 衛星の状態
+		std::vector<char> valid;		 // SP3: table の各要素を伝搬できたか
+	};
+
+	/**
+	 * @brief 作業単位を並列に整形し, 順に書き込む
+	 * @note 作業者数の2倍ずつの作業単位をまとめて実行器に渡す. 同じ呼び出しで1つ前のまとまりの整形結果を書き込む処理も渡し,
+	 *       整形と書き込みを重ねる. 書き込みはまとまりの順に行うため, 出力は作業者数によらず同一になる
+	 *
+	 * @param path 出力先のパス
+	 * @param header ファイルの先頭に書き込む文字列
+	 * @param unit_count 作業単位の数
+	 * @param options 設定
+	 * @param produce 作業単位を整形する関数 (unit, 出力先, 作業領域)
+	 * @return std::uint64_t 書き込んだバイト数
+	 */
+	template <class Produce>
+	static auto run(const std::string& path, const std::string& header, std::size_t unit_count, const EphemerisExportOptions& options,
+					Produce&& produce) -> std::uint64_t {
+		Tracing::Span span("io", "EphemerisExporter::run", "units", static_cast<std::int64_t>(unit_count));
+		const std::string temp_path = path + ".tmp";
+		std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			throw IoException("Cannot open file: " + temp_path, IoException::FileOpenError);
+		}
+
+		std::optional<ThreadPool> local_pool;
+		Executor* executor = options.executor;
+		if (executor == nullptr) {
+			executor = options.threads != 0 ? &local_pool.emplace(options.threads) : &ThreadPool::shared();
+		}
+
+		const std::size_t window = executor->concurrency() * 2;
+		WorkerLocal<Workspace> workspaces(*executor);
+		std::vector<std::string> texts[2] = {std::vector<std::string>(window), std::vector<std::string>(window)};
+		std::uint64_t bytes = 0;
+
+		auto write = [&](std::vector<std::string>& batch, std::size_t count) {
+			std::size_t size = 0;
+			for (std::size_t i = 0; i < count; i++) {
+				size += batch[i].size();
+			}
+			Tracing::Span trace("io", "EphemerisExporter::write", "bytes", static_cast<std::int64_t>(size));
+			for (std::size_t i = 0; i < count; i++) {
+				file.write(batch[i].data(), static_cast<std::streamsize>(batch[i].size()));
+				batch[i].clear();
+			}
+			if (!file) {
+				throw IoException("Cannot write file: " + temp_path, IoException::FileWriteError);
+			}
+			bytes += size;
+		};
+
+		try {
+			file.write(header.data(), static_cast<std::streamsize>(header.size()));
+			bytes += header.size();
+
+			// 要素 0 は前のまとまりの書き込み, 要素 1 以降は今のまとまりの整形
+			std::size_t pending = 0;
+			for (std::size_t first = 0, b = 0; first < unit_count; first += window, b ^= 1) {
+				const std::size_t count = std::min(window, unit_count - first);
+				executor->parallelFor(count + 1, 1, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+					for (std::size_t i = begin; i < end; i++) {
+						if (i == 0) {
+							if (pending != 0) {
+								write(texts[b ^ 1], pending);
+							}
+							continue;
+						}
+						const std::size_t unit = first + i - 1;
+						Tracing::Span chunk("propagation", "EphemerisExporter::produce", "unit", static_cast<std::int64_t>(unit));
+						produce(unit, texts[b][i - 1], workspaces[worker]);
+					}
+				});
+				pending = count;
+				if (first + window >= unit_count) {
+					write(texts[b], pending);
+				}
+			}
+
+			file.close();
+			if (file.fail()) {
+				throw IoException("Cannot write file: " + temp_path, IoException::FileWriteError);
+			}
+			if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+				throw IoException("Cannot replace file: " + path, IoException::FileWriteError);
+			}
+		} catch (...) {
+			file.close();
+			std::remove(temp_path.c_str());
+			throw;
+		}
+		span.setArg("bytes", static_cast<std::int64_t>(bytes));
+		return bytes;
+	}
+
+	static auto checkArguments(const TimeGrid& grid, const EphemerisExportOptions& options) -> void {
+		if (grid.empty()) {
+			throw DateTimeException("Ephemeris export requires at least one epoch", DateTimeException::InvalidTimeGrid);
+		}
+		if (options.frame != EphemerisFrame::Teme && options.rotation == nullptr) {
+			throw EarthOrientationException("Frame rotation cache is required for ITRF/GCRF output", EarthOrientationException::EmptyTable);
+		}
+	}
+
+	static auto allHandles(const SatelliteCatalog& catalog) -> std::vector<SatelliteCatalog::Handle> {
+		std::vector<SatelliteCatalog::Handle> handles(catalog.size());
+		for (std::size_t i = 0; i < handles.size(); i++) {
+			handles[i] = static_cast<SatelliteCatalog::Handle>(i);
+		}
+		return handles;
+	}
+
+	static auto chunkCount(const TimeGrid& grid, const EphemerisExportOptions& options) -> std::size_t {
+		const std::size_t chunk_size = std::max<std::size_t>(1, options.chunk_size);
+		return std::max<std::size_t>(1, (grid.size() + chunk_size - 1) / chunk_size);
+	}
+
+	static auto subGrid(const TimeGrid& grid, std::size_t chunk, const EphemerisExportOptions& options) -> TimeGrid {
+		const std::size_t chunk_size = std::max<std::size_t>(1, options.chunk_size);
+		const std::size_t first = chunk * chunk_size;
+		return TimeGrid(grid.at(first), grid.step(), std::min(chunk_size, grid.size() - std::min(first, grid.size())));
+	}
+
+	/**
+	 * @brief 時刻列で伝搬して ws.states に格納する
+	 *
+	 * @param propagator 伝搬器
+	 * @param grid 時刻列
+	 * @param ws 作業領域
+	 * @param skip_failures 伝搬できない時刻を ws.valid_states に記録して続行するか (false の場合は例外を送出する)
+	 */
+	static auto propagate(OrbitalPropagator propagator, const TimeGrid& grid, Workspace& ws, bool skip_failures) -> void {
+		ws.states.resize(grid.size());
+		ws.valid_states.assign(grid.size(), 1);
+		try {
+			propagator.trackFlightObject(grid, ws.states.data());
+		} catch (const OrbitException&) {
+			if (!skip_failures) {
+				throw;
+			}
+			// 時刻ごとに伝搬し直して, 伝搬できない時刻のみを除く
+			for (std::size_t k = 0; k < grid.size(); k++) {
+				try {
+					const auto e = propagator.trackFlightObject(grid.at(k));
+					ws.states[k] = StateVector{grid.at(k).ticks(), e.position.elements(), e.velocity.elements()};
+				} catch (const OrbitException&) {
+					ws.states[k] = StateVector{grid.at(k).ticks(), Eigen::Vector3d::Zero(), Eigen::Vector3d::Zero()};
+					ws.valid_states[k] = 0;
+				}
+			}
+		}
+	}
+
+	static auto transform(const TimeGrid& grid, const EphemerisExportOptions& options, Workspace& ws) -> void {
+		if (options.frame == EphemerisFrame::Itrf) {
+			ws.states = options.rotation->toItrf(grid, ws.states);
+		} else if (options.frame == EphemerisFrame::Gcrf) {
+			ws.states = options.rotation->toGcrf(grid, ws.states);
+		}
+	}
+
+	static auto frameName(EphemerisFrame frame) -> std::string_view {
+		switch (frame) {
+			case EphemerisFrame::Itrf:
+				return "ITRF";
+			case EphemerisFrame::Gcrf:
+				return "GCRF";
+			default:
+				return "TEME";
+		}
+	}
+
+	static auto appendDate(std::string& out, const DateTime& time) -> void {
+		char date[DateTime::iso8601_length];
+		out.append(date, time.format(date));
+	}
+
+	/**
+	 * @brief 国際識別符号を OEM の OBJECT_ID (例: 1998-067A) にする
+	 * @note TLE 形式 (例: 98067A) 以外の場合はカタログ番号を用いる
+	 */
+	static auto objectId(const SatelliteCatalog::Entry& entry) -> std::string {
+		const std::string_view d = entry.designator.view();
+		const bool valid = d.size() >= 6 && std::all_of(d.begin(), d.begin() + 5, [](char c) { return c >= '0' && c <= '9'; });
+		if (!valid) {
+			return std::to_string(entry.catalog_number);
+		}
+		const int year = (d[0] - '0') * 10 + (d[1] - '0');
+		return std::to_string(year < 57 ? 2000 + year : 1900 + year) + "-" + std::string(d.substr(2));
+	}
+
+	static auto appendOemMetadata(std::string& out, const SatelliteCatalog::Entry& entry, const TimeGrid& grid, EphemerisFrame frame)
+	  -> void {
+		out += "\nMETA_START\nOBJECT_NAME = ";
+		out += entry.name.view();
+		out += "\nOBJECT_ID = ";
+		out += objectId(entry);
+		out += "\nCENTER_NAME = EARTH\nREF_FRAME = ";
+		out += frameName(frame);
+		out += "\nTIME_SYSTEM = UTC\nSTART_TIME = ";
+		appendDate(out, grid.start());
+		out += "\nSTOP_TIME = ";
+		appendDate(out, grid.back());
+		out += "\nMETA_STOP\n\n";
+	}
+
+	/**
+	 * @brief 数値を右詰めで書き込む
+	 *
+	 * @param out 書き込み先
+	 * @param width 幅
+	 * @param value 値
+	 * @param precision 小数点以下の桁数
+	 * @return char* 書き込んだ末尾
+	 */
+	static auto writeField(char* out, int width, double value, int precision) -> char* {
+		char number[EphemerisWriter::max_number_length];
+		const auto n = static_cast<int>(EphemerisWriter::writeNumber(number, value, precision) - number);
+		const int pad = std::max(0, width - n);
+		std::memset(out, ' ', static_cast<std::size_t>(pad));
+		std::memcpy(out + pad, number, static_cast<std::size_t>(n));
+		return out + pad + n;
+	}
+
+	/* SP3 の時刻 (日付は空白区切り, 秒は小数8桁) */
+	static auto formatSp3Time(char* out, const DateTime& time) -> char* {
+		return out + std::snprintf(out, 32, "%4d %2d %2d %2d %2d %11.8f", time.year(), time.month(), time.day(), time.hour(), time.minute(),
+								   time.second() + time.microsecond() * 1e-6);
+	}
+
+	static auto formatSp3Epoch(char* out, const DateTime& time) -> std::size_t {
+		char* p = out;
+		std::memcpy(p, "*  ", 3);
+		p = formatSp3Time(p + 3, time);
+		*p++ = '\n';
+		return static_cast<std::size_t>(p - out);
+	}
+
+	/**
+	 * @brief SP3 の位置行 (P) と速度行 (V) を書き込む
+	 *
+	 * @param out 書き込み先 (128文字以上)
+	 * @param id 衛星番号 (1-99)
+	 * @param state 位置・速度 [m], [m/s]
+	 * @param valid 伝搬できたか (false の場合は 0 を書き込む)
+	 * @return std::size_t 書き込んだ文字数
+	 */
+	static auto formatSp3Record(char* out, int id, const StateVector& state, bool valid) -> std::size_t {
+		char* p = out;
+		for (const char type : {'P', 'V'}) {
+			*p++ = type;
+			*p++ = 'L';
+			*p++ = static_cast<char>('0' + id / 10);
+			*p++ = static_cast<char>('0' + id % 10);
+			for (int i = 0; i < 3; i++) {
+				const double value = type == 'P' ? state.position[i] * 1e-3 : state.velocity[i] * 10.0;
+				p = writeField(p, 14, valid ? value : 0.0, 6);
+			}
+			p = writeField(p, 14, 999999.999999, 6);
+			*p++ = '\n';
+		}
+		return static_cast<std::size_t>(p - out);
+	}
+
+	/**
+	 * @brief SP3-c のヘッダ (22行と衛星の注釈行) を作成する
+	 *
+	 */
+	static auto sp3Header(const SatelliteCatalog& catalog, std::span<const SatelliteCatalog::Handle> handles, const TimeGrid& grid,
+						  EphemerisFrame frame) -> std::string {
+		char line[128];
+		std::string out;
+
+		char* p = line + std::snprintf(line, sizeof(line), "#cV");
+		p = formatSp3Time(p, grid.start());
+		std::snprintf(p, 64, " %7zu ORBIT %-5.5s FIT SATF\n", grid.size(), std::string(frameName(frame)).c_str());
+		out += line;
+
+		const std::int64_t t = grid.start().ticks();
+		const std::int64_t gps = t - DateTime(1980, 1, 6, 0, 0, 0).ticks();
+		const std::int64_t mjd = t - DateTime(1858, 11, 17, 0, 0, 0).ticks();
+		const std::int64_t week_ticks = 7 * constant::ticks_per_day;
+		std::snprintf(line, sizeof(line), "## %4lld %15.8f %14.8f %5lld %15.13f\n", static_cast<long long>(gps / week_ticks),
+					  static_cast<double>(gps % week_ticks) / constant::ticks_per_second,
+					  static_cast<double>(grid.step().ticks()) / constant::ticks_per_second,
+					  static_cast<long long>(mjd / constant::ticks_per_day),
+					  static_cast<double>(mjd % constant::ticks_per_day) / constant::ticks_per_day);
+		out += line;
+
+		for (std::size_t row = 0; row < 5; row++) {
+			out += row == 0 ? "+   " : "+        ";
+			if (row == 0) {
+				std::snprintf(line, sizeof(line), "%2zu   ", handles.size());
+				out += line;
+			}
+			for (std::size_t i = row * 17; i < row * 17 + 17; i++) {
+				if (i < handles.size()) {
+					std::snprintf(line, sizeof(line), "L%02zu", i + 1);
+					out += line;
+				} else {
+					out += "  0";
+				}
+			}
+			out += '\n';
+		}
+		for (std::size_t row = 0; row < 5; row++) {
+			out += "++       ";
+			for (std::size_t i = 0; i < 17; i++) {
+				out += "  0";
+			}
+			out += '\n';
+		}
+
+		out += "%c L  cc UTC ccc cccc cccc cccc cccc ccccc ccccc ccccc ccccc\n";
+		out += "%c cc cc ccc ccc cccc cccc cccc cccc ccccc ccccc ccccc ccccc\n";
+		out += "%f  1.2500000  1.025000000  0.00000000000  0.000000000000000\n";
+		out += "%f  0.0000000  0.000000000  0.00000000000  0.000000000000000\n";
+		out += "%i    0    0    0    0      0      0      0      0         0\n";
+		out += "%i    0    0    0    0      0      0      0      0         0\n";
+		out += "/* SATFIND SGP4/SDP4 EPHEMERIS\n";
+		out += "/* POSITION KM, VELOCITY DM/S, CLOCK NOT AVAILABLE\n";
+		out += "/* FRAME ";
+		out += frameName(frame);
+		out += ", TIME SYSTEM UTC\n";
+		out += "/* SATELLITE ID, CATALOG NUMBER, NAME\n";
+		for (std::size_t i = 0; i < handles.size(); i++) {
+			const auto& entry = catalog.entry(handles[i]);
+			std::snprintf(line, sizeof(line), "/* L%02zu %9d %.48s\n", i + 1, entry.catalog_number, std::string(entry.name.view()).c_str());
+			out += line;
+		}
+		return out;
+	}
+};
+
+SATFIND_NAMESPACE_END
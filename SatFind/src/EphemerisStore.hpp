@@ -0,0 +1,569 @@
+/**
+ * @file EphemerisStore.hpp
+ * @author fugu133
+ * @brief 列指向のエフェメリスファイル
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "DateTime.hpp"
+#include "Essential.hpp"
+#include "Exception.hpp"
+#include "Executor.hpp"
+#include "MappedFile.hpp"
+#include "OrbitalElements.hpp"
+#include "OrbitalPropagator.hpp"
+#include "SatelliteCatalog.hpp"
+#include "TimeGrid.hpp"
+#include "Tracing.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief 1衛星分のエフェメリスの参照
+ * @note 時刻, 位置, 速度の各列をメモリマップした領域のまま参照し, 複製しない. 等間隔の時刻列は開始時刻と刻み幅のみで表す.
+ *       参照元の EphemerisStore が破棄されるまで有効
+ */
+class EphemerisSeries {
+  public:
+	EphemerisSeries() : m_catalog_number(0), m_count(0), m_start_ticks(0), m_step_ticks(0), m_times(nullptr), m_columns{} {}
+
+	auto catalogNumber() const -> int { return m_catalog_number; }
+
+	auto name() const -> std::string_view { return m_name; }
+
+	auto size() const -> std::size_t { return m_count; }
+
+	auto empty() const -> bool { return m_count == 0; }
+
+	/**
+	 * @brief 時刻列が等間隔か
+	 * @note 等間隔の場合は時刻の列を持たず, times() は空になる
+	 *
+	 */
+	auto uniform() const -> bool { return m_times == nullptr; }
+
+	auto ticks(std::size_t i) const -> std::int64_t {
+		return m_times != nullptr ? m_times[i] : m_start_ticks + static_cast<std::int64_t>(i) * m_step_ticks;
+	}
+
+	auto epoch(std::size_t i) const -> DateTime { return DateTime(ticks(i)); }
+
+	auto position(std::size_t i) const -> Eigen::Vector3d { return {m_columns[0][i], m_columns[1][i], m_columns[2][i]}; }
+
+	auto velocity(std::size_t i) const -> Eigen::Vector3d { return {m_columns[3][i], m_columns[4][i], m_columns[5][i]}; }
+
+	auto state(std::size_t i) const -> StateVector { return StateVector{ticks(i), position(i), velocity(i)}; }
+
+	/* 各列 (位置 [m], 速度 [m/s], TEME) */
+	auto times() const -> std::span<const std::int64_t> { return {m_times, m_times != nullptr ? m_count : 0}; }
+	auto x() const -> std::span<const double> { return {m_columns[0], m_count}; }
+	auto y() const -> std::span<const double> { return {m_columns[1], m_count}; }
+	auto z() const -> std::span<const double> { return {m_columns[2], m_count}; }
+	auto vx() const -> std::span<const double> { return {m_columns[3], m_count}; }
+	auto vy() const -> std::span<const double> { return {m_columns[4], m_count}; }
+	auto vz() const -> std::span<const double> { return {m_columns[5], m_count}; }
+
+	/**
+	 * @brief 時刻以降の最初の点の添字
+	 * @note 等間隔の場合は O(1), それ以外は二分探索
+	 *
+	 * @param t 時刻 [ticks]
+	 * @return std::size_t 添字 (すべての点が t より前の場合は size())
+	 */
+	auto lowerBound(std::int64_t t) const -> std::size_t {
+		if (m_times != nullptr) {
+			return static_cast<std::size_t>(std::lower_bound(m_times, m_times + m_count, t) - m_times);
+		}
+		if (m_count == 0 || t <= m_start_ticks) {
+			return 0;
+		}
+		if (m_step_ticks == 0) {
+			return m_count;
+		}
+		const std::int64_t k = (t - m_start_ticks + m_step_ticks - 1) / m_step_ticks;
+		return static_cast<std::size_t>(std::min<std::int64_t>(k, static_cast<std::int64_t>(m_count)));
+	}
+
+	/**
+	 * @brief 閉区間 [begin, end] の点を参照する
+	 * @note 列を複製せずに範囲を絞った参照を返す
+	 *
+	 * @param begin 開始時刻
+	 * @param end 終了時刻
+	 * @return EphemerisSeries 区間内の点
+	 */
+	auto slice(const DateTime& begin, const DateTime& end) const -> EphemerisSeries {
+		const std::size_t first = lowerBound(begin.ticks());
+		const std::size_t last = std::max(first, lowerBound(end.ticks() + 1));
+		return subrange(first, last - first);
+	}
+
+	/**
+	 * @brief 添字の範囲を参照する
+	 *
+	 * @param offset 先頭の添字
+	 * @param count 点数
+	 * @return EphemerisSeries
+	 */
+	auto subrange(std::size_t offset, std::size_t count) const -> EphemerisSeries {
+		EphemerisSeries s = *this;
+		offset = std::min(offset, m_count);
+		s.m_count = std::min(count, m_count - offset);
+		if (m_times != nullptr) {
+			s.m_times = m_times + offset;
+		} else {
+			s.m_start_ticks = m_start_ticks + static_cast<std::int64_t>(offset) * m_step_ticks;
+		}
+		for (int c = 0; c < 6; c++) {
+			s.m_columns[c] = m_columns[c] + offset;
+		}
+		return s;
+	}
+
+	/**
+	 * @brief 任意の時刻の位置・速度を補間する
+	 * @note 前後の2点の位置と速度から3次のエルミート補間を行う. 点の時刻では保存した値をそのまま返す
+	 * @exception OrbitException 時刻が範囲外の場合
+	 *
+	 * @param time 時刻
+	 * @return StateVector 位置・速度 (TEME)
+	 */
+	auto interpolate(const DateTime& time) const -> StateVector {
+		const std::int64_t t = time.ticks();
+		if (m_count == 0 || t < ticks(0) || t > ticks(m_count - 1)) {
+			throw OrbitException("Time is outside of the ephemeris", OrbitException::ParameterOutOfRange);
+		}
+		const std::size_t i1 = lowerBound(t);
+		if (ticks(i1) == t) {
+			return state(i1);
+		}
+		const std::size_t i0 = i1 - 1;
+
+		const double h = static_cast<double>(ticks(i1) - ticks(i0)) / constant::ticks_per_second;
+		const double s = static_cast<double>(t - ticks(i0)) / static_cast<double>(ticks(i1) - ticks(i0));
+		const double s2 = s * s;
+		const double s3 = s2 * s;
+
+		// エルミート基底関数とその s による微分
+		const double h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+		const double h10 = s3 - 2.0 * s2 + s;
+		const double h01 = -2.0 * s3 + 3.0 * s2;
+		const double h11 = s3 - s2;
+		const double d00 = 6.0 * s2 - 6.0 * s;
+		const double d10 = 3.0 * s2 - 4.0 * s + 1.0;
+		const double d01 = -6.0 * s2 + 6.0 * s;
+		const double d11 = 3.0 * s2 - 2.0 * s;
+
+		const Eigen::Vector3d p0 = position(i0);
+		const Eigen::Vector3d p1 = position(i1);
+		const Eigen::Vector3d v0 = velocity(i0);
+		const Eigen::Vector3d v1 = velocity(i1);
+		return StateVector{t, h00 * p0 + h10 * h * v0 + h01 * p1 + h11 * h * v1, (d00 * p0 + d01 * p1) / h + d10 * v0 + d11 * v1};
+	}
+
+  private:
+	friend class EphemerisStore;
+
+	int m_catalog_number;		 // カタログ番号
+	std::string_view m_name;	 // 衛星名
+	std::size_t m_count;		 // 点数
+	std::int64_t m_start_ticks;	 // 先頭の時刻 (等間隔の場合) [ticks]
+	std::int64_t m_step_ticks;	 // 刻み幅 (等間隔の場合) [ticks]
+	const std::int64_t* m_times; // 時刻の列 (等間隔の場合は nullptr)
+	const double* m_columns[6];	 // 位置・速度の列 (x, y, z, vx, vy, vz)
+};
+
+/**
+ * @brief 列指向のエフェメリスファイル
+ * @note 衛星ごとに時刻, 位置, 速度を列として保存し, 末尾に衛星の索引 (カタログ番号の昇順) を置く. 読み込み時はファイルを
+ *       メモリマップして列をそのまま参照する. 衛星の検索と時刻範囲の検索はいずれも二分探索で, 結果は複製しない参照として返す
+ * @remark 形式はリトルエンディアンで, 各列は8バイト境界に置く. 等間隔の時刻列は開始時刻と刻み幅のみを保存する (差分符号化).
+ *         作成は EphemerisStore::Writer で行う
+ */
+class EphemerisStore {
+  public:
+	class Writer;
+
+	EphemerisStore() : m_header(nullptr), m_index(nullptr) {}
+
+	/**
+	 * @brief エフェメリスファイルを開く
+	 * @note ヘッダ, 索引, ファイル長を検査する. 列の内容は読み込まない
+	 * @exception IoException ファイルを開けない場合, または形式が異なる場合
+	 *
+	 * @param path ファイルのパス
+	 */
+	explicit EphemerisStore(const std::string& path) : m_file(path) {
+		if (!isLittleEndian()) {
+			throw IoException("Ephemeris store requires a little-endian host", IoException::InvalidFormat);
+		}
+		if (m_file.size() < sizeof(Header)) {
+			throw IoException("Ephemeris store is truncated: " + path, IoException::InvalidFormat);
+		}
+		m_header = reinterpret_cast<const Header*>(m_file.data());
+		if (std::memcmp(m_header->magic, magic, sizeof(magic)) != 0 || m_header->version != version ||
+			m_header->endian_tag != endian_tag || m_header->header_size != sizeof(Header) ||
+			m_header->index_entry_size != sizeof(IndexEntry)) {
+			throw IoException("Incompatible ephemeris store: " + path, IoException::InvalidFormat);
+		}
+		if (m_header->file_size != m_file.size() ||
+			m_header->index_offset + m_header->satellite_count * sizeof(IndexEntry) != m_file.size()) {
+			throw IoException("Ephemeris store is truncated: " + path, IoException::InvalidFormat);
+		}
+		m_index = reinterpret_cast<const IndexEntry*>(m_file.data() + m_header->index_offset);
+		for (std::size_t i = 0; i < size(); i++) {
+			const auto& e = m_index[i];
+			const std::uint64_t column_bytes = e.count * sizeof(double);
+			bool valid = (e.flags & flag_time_column) == 0 || e.time_offset + column_bytes <= m_header->index_offset;
+			for (const auto offset : e.column_offset) {
+				valid = valid && offset % 8 == 0 && offset + column_bytes <= m_header->index_offset;
+			}
+			if (!valid) {
+				throw IoException("Ephemeris store index is corrupted: " + path, IoException::InvalidFormat);
+			}
+		}
+	}
+
+	/**
+	 * @brief 衛星の数
+	 *
+	 */
+	auto size() const -> std::size_t { return m_header != nullptr ? static_cast<std::size_t>(m_header->satellite_count) : 0; }
+
+	auto empty() const -> bool { return size() == 0; }
+
+	/**
+	 * @brief カタログ番号で衛星を検索する
+	 * @note 索引の二分探索
+	 *
+	 * @param catalog_number カタログ番号
+	 * @return std::size_t 衛星の番号 (見つからない場合は npos)
+	 */
+	auto find(int catalog_number) const -> std::size_t {
+		const IndexEntry* last = m_index + size();
+		const IndexEntry* it =
+		  std::lower_bound(m_index, last, catalog_number, [](const IndexEntry& e, int n) { return e.catalog_number < n; });
+		return it != last && it->catalog_number == catalog_number ? static_cast<std::size_t>(it - m_index) : npos;
+	}
+
+	/**
+	 * @brief i番目の衛星のエフェメリスを参照する
+	 *
+	 * @param i 衛星の番号
+	 * @return EphemerisSeries
+	 */
+	auto series(std::size_t i) const -> EphemerisSeries {
+		const auto& e = m_index[i];
+		EphemerisSeries s;
+		s.m_catalog_number = e.catalog_number;
+		s.m_name = std::string_view(e.name, strnlen(e.name, sizeof(e.name)));
+		s.m_count = static_cast<std::size_t>(e.count);
+		s.m_start_ticks = e.start_ticks;
+		s.m_step_ticks = e.step_ticks;
+		s.m_times = (e.flags & flag_time_column) != 0 ? reinterpret_cast<const std::int64_t*>(m_file.data() + e.time_offset) : nullptr;
+		for (int c = 0; c < 6; c++) {
+			s.m_columns[c] = reinterpret_cast<const double*>(m_file.data() + e.column_offset[c]);
+		}
+		return s;
+	}
+
+	/**
+	 * @brief 衛星の時刻範囲 [begin, end] のエフェメリスを参照する
+	 * @note 見つからない場合は空の参照を返す
+	 *
+	 * @param catalog_number カタログ番号
+	 * @param begin 開始時刻
+	 * @param end 終了時刻
+	 * @return EphemerisSeries
+	 */
+	auto query(int catalog_number, const DateTime& begin, const DateTime& end) const -> EphemerisSeries {
+		const std::size_t i = find(catalog_number);
+		return i != npos ? series(i).slice(begin, end) : EphemerisSeries();
+	}
+
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  private:
+	/**
+	 * @brief ファイルヘッダ
+	 *
+	 */
+	struct Header {
+		char magic[8];					// "SFEPHSTR"
+		std::uint32_t version;			// 形式の版
+		std::uint32_t endian_tag;		// 0x01020304
+		std::uint32_t header_size;		// ヘッダのバイト数
+		std::uint32_t index_entry_size; // 索引の1項目のバイト数
+		std::uint64_t satellite_count;	// 衛星の数
+		std::uint64_t index_offset;		// 索引のファイル位置
+		std::uint64_t file_size;		// ファイルのバイト数
+	};
+
+	/**
+	 * @brief 衛星の索引
+	 * @note 列の位置はファイル先頭からのバイト数
+	 */
+	struct IndexEntry {
+		std::int32_t catalog_number;	// カタログ番号
+		std::uint32_t flags;			// flag_time_column
+		char name[32];					// 衛星名 (ヌル文字で埋める)
+		std::uint64_t count;			// 点数
+		std::int64_t start_ticks;		// 先頭の時刻 [ticks]
+		std::int64_t step_ticks;		// 刻み幅 (等間隔の場合) [ticks]
+		std::uint64_t time_offset;		// 時刻の列の位置 (等間隔でない場合)
+		std::uint64_t column_offset[6]; // 位置・速度の列の位置 (x, y, z, vx, vy, vz)
+	};
+
+	static_assert(sizeof(Header) == 48, "Unexpected ephemeris store header layout");
+	static_assert(sizeof(IndexEntry) % 8 == 0, "Ephemeris store index entries must be 8-byte aligned");
+
+	static constexpr char magic[8] = {'S', 'F', 'E', 'P', 'H', 'S', 'T', 'R'};
+	static constexpr std::uint32_t version = 1;
+	static constexpr std::uint32_t endian_tag = 0x01020304;
+	static constexpr std::uint32_t flag_time_column = 1; // 時刻の列を持つ (等間隔でない)
+
+	MappedFile m_file;		   // エフェメリスファイル
+	const Header* m_header;	   // ヘッダ
+	const IndexEntry* m_index; // 索引
+
+	static constexpr auto isLittleEndian() -> bool { return std::endian::native == std::endian::little; }
+};
+
+/**
+ * @brief エフェメリスファイルの作成
+ * @note 衛星ごとに列を順に書き込み, finish() で索引とヘッダを書き込む. 一時ファイルに書き込んでから置き換える
+ */
+class EphemerisStore::Writer {
+  public:
+	/**
+	 * @brief Construct a new Writer object
+	 * @exception IoException ファイルを開けない場合
+	 *
+	 * @param path 出力先のパス
+	 */
+	explicit Writer(const std::string& path) : m_path(path), m_temp_path(path + ".tmp"), m_offset(0), m_finished(false) {
+		if (!isLittleEndian()) {
+			throw IoException("Ephemeris store requires a little-endian host", IoException::InvalidFormat);
+		}
+		m_file.open(m_temp_path, std::ios::binary | std::ios::trunc);
+		if (!m_file) {
+			throw IoException("Cannot open file: " + m_temp_path, IoException::FileOpenError);
+		}
+		const Header placeholder{};
+		writeBytes(&placeholder, sizeof(placeholder));
+	}
+
+	Writer(const Writer&) = delete;
+	auto operator=(const Writer&) -> Writer& = delete;
+
+	~Writer() {
+		if (!m_finished) {
+			m_file.close();
+			std::remove(m_temp_path.c_str());
+		}
+	}
+
+	/**
+	 * @brief 衛星のエフェメリスを追加する
+	 * @exception OrbitException 時刻が狭義単調増加でない場合, またはカタログ番号が重複する場合
+	 * @exception IoException 書き込みに失敗した場合
+	 *
+	 * @param catalog_number カタログ番号
+	 * @param name 衛星名 (31文字まで保存する)
+	 * @param states 位置・速度 (TEME, 時刻の昇順)
+	 */
+	auto add(int catalog_number, std::string_view name, std::span<const StateVector> states) -> void {
+		for (const auto& e : m_index) {
+			if (e.catalog_number == catalog_number) {
+				throw OrbitException("Duplicate catalog number in ephemeris store", OrbitException::CatalogNumberMismatch);
+			}
+		}
+
+		IndexEntry entry{};
+		entry.catalog_number = catalog_number;
+		std::memcpy(entry.name, name.data(), std::min(name.size(), sizeof(entry.name) - 1));
+		entry.count = states.size();
+		entry.start_ticks = states.empty() ? 0 : states.front().ticks;
+		entry.step_ticks = states.size() > 1 ? states[1].ticks - states[0].ticks : 0;
+
+		bool uniform = true;
+		for (std::size_t i = 1; i < states.size(); i++) {
+			const std::int64_t step = states[i].ticks - states[i - 1].ticks;
+			if (step <= 0) {
+				throw OrbitException("Ephemeris times must be strictly increasing", OrbitException::ParameterOutOfRange);
+			}
+			uniform = uniform && step == entry.step_ticks;
+		}
+
+		if (!uniform) {
+			entry.flags |= flag_time_column;
+			entry.step_ticks = 0;
+			entry.time_offset = m_offset;
+			m_column.resize(states.size());
+			for (std::size_t i = 0; i < states.size(); i++) {
+				std::memcpy(&m_column[i], &states[i].ticks, sizeof(std::int64_t));
+			}
+			writeBytes(m_column.data(), states.size() * sizeof(double));
+		}
+		for (int c = 0; c < 6; c++) {
+			entry.column_offset[c] = m_offset;
+			m_column.resize(states.size());
+			for (std::size_t i = 0; i < states.size(); i++) {
+				m_column[i] = c < 3 ? states[i].position[c] : states[i].velocity[c - 3];
+			}
+			writeBytes(m_column.data(), states.size() * sizeof(double));
+		}
+		m_index.push_back(entry);
+	}
+
+	/**
+	 * @brief 伝搬器で時刻列の各時刻の位置・速度を計算して追加する
+	 *
+	 * @param catalog_number カタログ番号
+	 * @param name 衛星名
+	 * @param propagator 伝搬器
+	 * @param grid 時刻列
+	 */
+	auto add(int catalog_number, std::string_view name, OrbitalPropagator propagator, const TimeGrid& grid) -> void {
+		m_states.resize(grid.size());
+		propagator.trackFlightObject(grid, m_states.data());
+		add(catalog_number, name, m_states);
+	}
+
+	/**
+	 * @brief カタログの全衛星を時刻列で伝搬して追加する
+	 * @note 伝搬に失敗した衛星 (減衰など, OrbitException) は追加しない
+	 *
+	 * @param catalog 衛星カタログ
+	 * @param grid 時刻列
+	 * @return std::size_t 追加した衛星の数
+	 */
+	auto add(const SatelliteCatalog& catalog, const TimeGrid& grid) -> std::size_t {
+		std::size_t added = 0;
+		for (SatelliteCatalog::Handle h = 0; h < catalog.size(); h++) {
+			const auto& entry = catalog.entry(h);
+			try {
+				add(entry.catalog_number, entry.name.view(), catalog.propagator(h), grid);
+				added++;
+			} catch (const OrbitException&) {
+			}
+		}
+		return added;
+	}
+
+	/**
+	 * @brief カタログの全衛星を時刻列で並列に伝搬して追加する
+	 * @note 実行器の作業者数の2倍ずつの衛星を並列に伝搬し, カタログの順に書き込む. 伝搬に失敗した衛星 (減衰など, OrbitException)
+	 *       は追加しない
+	 *
+	 * @param catalog 衛星カタログ
+	 * @param grid 時刻列
+	 * @param executor 実行器
+	 * @return std::size_t 追加した衛星の数
+	 */
+	auto add(const SatelliteCatalog& catalog, const TimeGrid& grid, Executor& executor) -> std::size_t {
+		const std::size_t batch = executor.concurrency() * 2;
+		const std::size_t n = grid.size();
+		std::vector<char> propagated(batch);
+		std::size_t added = 0;
+		for (std::size_t first = 0; first < catalog.size(); first += batch) {
+			const std::size_t count = std::min(batch, catalog.size() - first);
+			m_states.resize(count * n);
+			executor.parallelFor(count, 1, [&](std::size_t begin, std::size_t end, std::size_t) {
+				for (std::size_t i = begin; i < end; i++) {
+					try {
+						OrbitalPropagator propagator = catalog.propagator(static_cast<SatelliteCatalog::Handle>(first + i));
+						propagator.trackFlightObject(grid, m_states.data() + i * n);
+						propagated[i] = 1;
+					} catch (const OrbitException&) {
+						propagated[i] = 0;
+					}
+				}
+			});
+			for (std::size_t i = 0; i < count; i++) {
+				if (propagated[i]) {
+					const auto& entry = catalog.entry(static_cast<SatelliteCatalog::Handle>(first + i));
+					add(entry.catalog_number, entry.name.view(), std::span<const StateVector>(m_states.data() + i * n, n));
+					added++;
+				}
+			}
+		}
+		return added;
+	}
+
+	/**
+	 * @brief 索引とヘッダを書き込み, ファイルを置き換える
+	 * @exception IoException 書き込みに失敗した場合
+	 *
+	 */
+	auto finish() -> void {
+		if (m_finished) {
+			return;
+		}
+		Tracing::Span span("io", "EphemerisStore::Writer::finish", "satellites", static_cast<std::int64_t>(m_index.size()));
+		std::sort(m_index.begin(), m_index.end(),
+				  [](const IndexEntry& a, const IndexEntry& b) { return a.catalog_number < b.catalog_number; });
+
+		Header header{};
+		std::memcpy(header.magic, magic, sizeof(magic));
+		header.version = version;
+		header.endian_tag = endian_tag;
+		header.header_size = sizeof(Header);
+		header.index_entry_size = sizeof(IndexEntry);
+		header.satellite_count = m_index.size();
+		header.index_offset = m_offset;
+		writeBytes(m_index.data(), m_index.size() * sizeof(IndexEntry));
+		header.file_size = m_offset;
+
+		m_file.seekp(0);
+		m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		m_file.close();
+		if (m_file.fail()) {
+			throw IoException("Cannot write file: " + m_temp_path, IoException::FileWriteError);
+		}
+		if (std::rename(m_temp_path.c_str(), m_path.c_str()) != 0) {
+			std::remove(m_temp_path.c_str());
+			throw IoException("Cannot replace file: " + m_path, IoException::FileWriteError);
+		}
+		m_finished = true;
+	}
+
+  private:
+	std::string m_path;				   // 出力先のパス
+	std::string m_temp_path;		   // 一時ファイルのパス
+	std::ofstream m_file;			   // 一時ファイル
+	std::uint64_t m_offset;			   // 書き込んだバイト数
+	std::vector<IndexEntry> m_index;   // 索引
+	std::vector<double> m_column;	   // 列の書き込み用の作業領域
+	std::vector<StateVector> m_states; // 伝搬結果の作業領域
+	bool m_finished;				   // finish() したか
+
+	auto writeBytes(const void* data, std::size_t size) -> void {
+		m_file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+		if (!m_file) {
+			throw IoException("Cannot write file: " + m_temp_path, IoException::FileWriteError);
+		}
+		m_offset += size;
+	}
+};
+
+SATFIND_NAMESPACE_END
@@ -0,0 +1,594 @@
+/**
+ * @file EphemerisWriter.hpp
+ * @author fugu133
+ * @brief 位置・速度の時系列 (エフェメリス) のファイル出力
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "DateTime.hpp"
+#include "Essential.hpp"
+#include "Exception.hpp"
+#include "Executor.hpp"
+#include "FixedString.hpp"
+#include "OrbitalElements.hpp"
+#include "OrbitalPropagator.hpp"
+#include "SpscQueue.hpp"
+#include "TimeGrid.hpp"
+#include "Tracing.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief エフェメリスの出力形式
+ *
+ */
+enum class EphemerisFormat {
+	Csv,	// CSV (object_id, time, x, y, z [m], vx, vy, vz [m/s])
+	Oem,	// CCSDS OEM (KVN, [km], [km/s])
+	Binary, // リトルエンディアンの固定長レコード ([m], [m/s])
+};
+
+/**
+ * @brief エフェメリスの区間 (1天体分の時系列) の情報
+ * @note OEM では META ブロックとして, バイナリでは区間ヘッダとして書き出す. CSV では各行の object_id 列に使用する
+ */
+struct EphemerisSegment {
+	FixedString<64> object_name; // 天体名
+	FixedString<16> object_id;	 // 国際識別符号 (例: 1998-067A)
+	DateTime start;				 // 区間の開始時刻
+	DateTime stop;				 // 区間の終了時刻
+};
+
+/**
+ * @brief バイナリ形式のファイルヘッダ
+ *
+ */
+struct EphemerisFileHeader {
+	char magic[8];					   // "SFEPHEM\0"
+	std::uint32_t version;			   // 形式の版
+	std::uint32_t header_size;		   // sizeof(EphemerisFileHeader)
+	std::uint32_t segment_header_size; // sizeof(EphemerisSegmentHeader)
+	std::uint32_t record_size;		   // sizeof(EphemerisRecord)
+};
+
+/**
+ * @brief バイナリ形式の区間ヘッダ
+ * @note 区間のレコードの直前に置く. 文字列はヌル文字で埋める
+ */
+struct EphemerisSegmentHeader {
+	char object_name[64];	  // 天体名
+	char object_id[16];		  // 国際識別符号
+	std::int64_t start_ticks; // 区間の開始時刻 [ticks]
+	std::int64_t stop_ticks;  // 区間の終了時刻 [ticks]
+	std::uint64_t count;	  // 区間のレコード数
+};
+
+/**
+ * @brief バイナリ形式のレコード
+ *
+ */
+struct EphemerisRecord {
+	std::int64_t ticks; // 時刻 [ticks]
+	double position[3]; // 位置 (TEME) [m]
+	double velocity[3]; // 速度 (TEME) [m/s]
+};
+
+/**
+ * @brief エフェメリスをファイルに書き出す
+ * @note 呼び出し側 (生産者) は StateVector のブロックを有界の SPSC キューに渡し, 書き出しスレッドが大きなバッファに
+ *       整形してまとめて書き込む. 伝搬と整形・書き込みは並行して進み, キューが満杯の間は生産者が待つ.
+ *       書き出し済みのブロックは acquireBlock() で再利用するため, 定常状態ではメモリ確保が発生しない
+ * @remark write() と beginSegment() は1つのスレッドからのみ呼び出す. 書き出しスレッドで発生した例外は, 以降の write() または
+ *         close() で送出する
+ */
+class EphemerisWriter {
+  public:
+	static constexpr std::size_t default_block_size = 4096;	 // 1ブロックの状態数
+	static constexpr std::size_t default_queue_capacity = 8; // キューに置けるブロック数
+	static constexpr std::size_t buffer_size = 1 << 20;		 // 出力バッファの大きさ [byte]
+	static constexpr std::size_t max_number_length = 32;	 // 数値1つの最大文字数
+
+	/* 1行の最大文字数 (object_id, 時刻, 数値6つと区切り文字) */
+	static constexpr std::size_t max_row_length = 16 + 1 + DateTime::iso8601_length + 6 * (1 + max_number_length) + 1;
+
+	/**
+	 * @brief ファイルを開き, 書き出しスレッドを開始する
+	 * @exception IoException ファイルを開けない場合
+	 *
+	 * @param path 出力先のパス
+	 * @param format 出力形式
+	 * @param queue_capacity キューに置けるブロック数
+	 */
+	EphemerisWriter(const std::string& path, EphemerisFormat format, std::size_t queue_capacity = default_queue_capacity)
+	  : m_format(format),
+		m_queue(queue_capacity),
+		m_free_blocks(queue_capacity + 1),
+		m_has_segment(false),
+		m_bytes_written(0),
+		m_file_offset(0),
+		m_used(0),
+		m_segment_open(false),
+		m_segment_count(0),
+		m_count_offset(0) {
+		if (format == EphemerisFormat::Binary && !isLittleEndian()) {
+			throw IoException("Binary ephemeris requires a little-endian host", IoException::InvalidFormat);
+		}
+		m_file.open(path, std::ios::binary | std::ios::trunc);
+		if (!m_file) {
+			throw IoException("Cannot open file: " + path, IoException::FileOpenError);
+		}
+		m_buffer.resize(buffer_size + max_row_length + sizeof(EphemerisSegmentHeader));
+		m_thread = std::thread([this] { run(); });
+	}
+
+	EphemerisWriter(const EphemerisWriter&) = delete;
+	auto operator=(const EphemerisWriter&) -> EphemerisWriter& = delete;
+
+	~EphemerisWriter() {
+		try {
+			close();
+		} catch (...) {
+		}
+	}
+
+	/**
+	 * @brief 区間を開始する
+	 * @note 以降に書き出す状態はこの区間に属する. OEM とバイナリでは最初の状態の前に必ず呼び出す
+	 *
+	 * @param segment 区間の情報
+	 */
+	auto beginSegment(const EphemerisSegment& segment) -> void {
+		Item item;
+		item.is_segment = true;
+		item.segment = segment;
+		enqueue(std::move(item));
+		m_has_segment = true;
+	}
+
+	/**
+	 * @brief 空のブロックを取得する
+	 * @note 書き出し済みのブロックがあれば再利用する
+	 *
+	 * @param reserve 確保しておく状態数
+	 * @return std::vector<StateVector> 空のブロック
+	 */
+	auto acquireBlock(std::size_t reserve = default_block_size) -> std::vector<StateVector> {
+		std::vector<StateVector> block;
+		m_free_blocks.tryPop(block);
+		block.clear();
+		block.reserve(reserve);
+		return block;
+	}
+
+	/**
+	 * @brief 状態のブロックを書き出す
+	 * @note キューが満杯の場合は空きができるまで待つ
+	 * @exception IoException 区間が未開始の場合 (OEM, バイナリ), または書き出しスレッドで書き込みに失敗した場合
+	 *
+	 * @param block 状態 (TEME)
+	 */
+	auto write(std::vector<StateVector> block) -> void {
+		if (block.empty()) {
+			return;
+		}
+		if (!m_has_segment && m_format != EphemerisFormat::Csv) {
+			throw IoException("Ephemeris segment is not started", IoException::InvalidFormat);
+		}
+		Item item;
+		item.is_segment = false;
+		item.states = std::move(block);
+		enqueue(std::move(item));
+	}
+
+	/**
+	 * @brief 状態の配列を書き出す
+	 * @note default_block_size ごとのブロックに複製して渡す
+	 *
+	 * @param states 状態 (TEME)
+	 */
+	auto write(std::span<const StateVector> states) -> void {
+		while (!states.empty()) {
+			const std::size_t n = std::min(states.size(), default_block_size);
+			auto block = acquireBlock(n);
+			block.assign(states.begin(), states.begin() + static_cast<std::ptrdiff_t>(n));
+			write(std::move(block));
+			states = states.subspan(n);
+		}
+	}
+
+	/**
+	 * @brief 時刻列の各時刻で伝搬した状態を書き出す
+	 * @note ブロックごとに伝搬して渡すため, 伝搬と書き出しが並行して進む. 時刻列の配列は作成しない
+	 *
+	 * @param propagator 伝搬器
+	 * @param grid 時刻列
+	 * @param block_size 1ブロックの状態数
+	 */
+	auto write(const OrbitalPropagator& propagator, const TimeGrid& grid, std::size_t block_size = default_block_size) -> void {
+		const std::int64_t start = grid.start().ticks();
+		const std::int64_t step = grid.step().ticks();
+		for (std::size_t i = 0; i < grid.size();) {
+			const std::size_t n = std::min(block_size, grid.size() - i);
+			auto block = acquireBlock(n);
+			for (std::size_t k = 0; k < n; k++) {
+				const std::int64_t t = start + static_cast<std::int64_t>(i + k) * step;
+				const auto e = propagator.trackFlightObject(DateTime(t));
+				block.push_back(StateVector{t, e.position.elements(), e.velocity.elements()});
+			}
+			write(std::move(block));
+			i += n;
+		}
+	}
+
+	/**
+	 * @brief 時刻列の各時刻で伝搬した状態を書き出す
+	 * @note 実行器の作業者の数のブロックずつ並列に伝搬し, 時刻の順に渡す. 渡したブロックの書き出しと次のブロックの伝搬は
+	 *       並行して進む. 書き出す内容は実行器を使用しない場合と一致する
+	 *
+	 * @param propagator 伝搬器
+	 * @param grid 時刻列
+	 * @param executor 実行器
+	 * @param block_size 1ブロックの状態数
+	 */
+	auto write(const OrbitalPropagator& propagator, const TimeGrid& grid, Executor& executor,
+			   std::size_t block_size = default_block_size) -> void {
+		const std::int64_t start = grid.start().ticks();
+		const std::int64_t step = grid.step().ticks();
+		const std::size_t batch = executor.concurrency();
+		std::vector<std::vector<StateVector>> blocks;
+		blocks.reserve(batch);
+		for (std::size_t first = 0; first < grid.size(); first += batch * block_size) {
+			for (std::size_t i = first; blocks.size() < batch && i < grid.size(); i += block_size) {
+				blocks.push_back(acquireBlock(std::min(block_size, grid.size() - i)));
+				blocks.back().resize(std::min(block_size, grid.size() - i));
+			}
+			executor.parallelFor(blocks.size(), 1, [&](std::size_t begin, std::size_t end, std::size_t) {
+				for (std::size_t b = begin; b < end; b++) {
+					auto& block = blocks[b];
+					for (std::size_t k = 0; k < block.size(); k++) {
+						const std::int64_t t = start + static_cast<std::int64_t>(first + b * block_size + k) * step;
+						const auto e = propagator.trackFlightObject(DateTime(t));
+						block[k] = StateVector{t, e.position.elements(), e.velocity.elements()};
+					}
+				}
+			});
+			for (auto& block : blocks) {
+				write(std::move(block));
+			}
+			blocks.clear();
+		}
+	}
+
+	/**
+	 * @brief 残りを書き出してファイルを閉じる
+	 * @note 書き出しスレッドの終了を待つ. 2回目以降の呼び出しは書き出しスレッドの例外を再び送出する以外は何もしない
+	 * @exception IoException 書き出しスレッドで書き込みに失敗した場合
+	 *
+	 */
+	auto close() -> void {
+		if (m_thread.joinable()) {
+			m_queue.close();
+			m_thread.join();
+		}
+		rethrowError();
+	}
+
+	/**
+	 * @brief ファイルに書き込んだバイト数
+	 *
+	 */
+	auto bytesWritten() const -> std::uint64_t { return m_bytes_written.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief 小数点以下の桁数を指定して数値を書き込む
+	 * @note 値を 10^precision 倍した整数に丸めて整数部と小数部を書き込む. 丸め誤差が最下位桁に及ぶ大きな値 (非有限値を含む) は
+	 *       std::to_chars で書き込み, max_number_length に収まらない場合は最短の表記とする
+	 *
+	 * @param out 書き込み先 (max_number_length 文字以上)
+	 * @param value 値
+	 * @param precision 小数点以下の桁数 (0-9)
+	 * @return char* 書き込んだ末尾
+	 */
+	static auto writeNumber(char* out, double value, int precision) -> char* {
+		const double scaled = value * power_of_ten[precision];
+		if (!(std::fabs(scaled) < 1e12)) {
+			auto [end, ec] = std::to_chars(out, out + max_number_length, value, std::chars_format::fixed, precision);
+			return ec == std::errc{} ? end : std::to_chars(out, out + max_number_length, value).ptr;
+		}
+		std::int64_t units = std::llround(scaled);
+		if (units < 0) {
+			*out++ = '-';
+			units = -units;
+		}
+		const auto scale = static_cast<std::int64_t>(power_of_ten[precision]);
+		char* p = std::to_chars(out, out + max_number_length, units / scale).ptr;
+		*p++ = '.';
+		std::int64_t fraction = units % scale;
+		for (int i = precision - 1; i >= 0; i--) {
+			p[i] = static_cast<char>('0' + fraction % 10);
+			fraction /= 10;
+		}
+		return p + precision;
+	}
+
+	/**
+	 * @brief CSV の1行を書き込む
+	 * @note 終端文字は書き込まない
+	 *
+	 * @param out 書き込み先 (max_row_length 文字以上)
+	 * @param object_id object_id 列
+	 * @param state 状態
+	 * @return std::size_t 書き込んだ文字数
+	 */
+	static auto formatCsvRow(char* out, std::string_view object_id, const StateVector& state) -> std::size_t {
+		char* p = out;
+		std::memcpy(p, object_id.data(), std::min<std::size_t>(object_id.size(), 16));
+		p += std::min<std::size_t>(object_id.size(), 16);
+		*p++ = ',';
+		p += DateTime(state.ticks).format(p);
+		for (int i = 0; i < 3; i++) {
+			*p++ = ',';
+			p = writeNumber(p, state.position[i], 3);
+		}
+		for (int i = 0; i < 3; i++) {
+			*p++ = ',';
+			p = writeNumber(p, state.velocity[i], 6);
+		}
+		*p++ = '\n';
+		return static_cast<std::size_t>(p - out);
+	}
+
+	/**
+	 * @brief OEM のデータ行を書き込む
+	 * @note 位置は [km] で小数6桁, 速度は [km/s] で小数9桁. 終端文字は書き込まない
+	 *
+	 * @param out 書き込み先 (max_row_length 文字以上)
+	 * @param state 状態
+	 * @return std::size_t 書き込んだ文字数
+	 */
+	static auto formatOemRow(char* out, const StateVector& state) -> std::size_t {
+		char* p = out;
+		p += DateTime(state.ticks).format(p);
+		for (int i = 0; i < 3; i++) {
+			*p++ = ' ';
+			p = writeNumber(p, state.position[i] * 1e-3, 6);
+		}
+		for (int i = 0; i < 3; i++) {
+			*p++ = ' ';
+			p = writeNumber(p, state.velocity[i] * 1e-3, 9);
+		}
+		*p++ = '\n';
+		return static_cast<std::size_t>(p - out);
+	}
+
+  private:
+	struct Item {
+		bool is_segment = false;		 // 区間の開始か
+		EphemerisSegment segment;		 // 区間の情報 (is_segment の場合)
+		std::vector<StateVector> states; // 状態 (is_segment でない場合)
+	};
+
+	static constexpr char magic[8] = {'S', 'F', 'E', 'P', 'H', 'E', 'M', '\0'};
+	static constexpr std::uint32_t version = 1;
+
+	EphemerisFormat m_format;						   // 出力形式
+	std::ofstream m_file;							   // 出力先
+	SpscQueue<Item> m_queue;						   // 書き出すブロック (生産者 -> 書き出しスレッド)
+	SpscQueue<std::vector<StateVector>> m_free_blocks; // 再利用するブロック (書き出しスレッド -> 生産者)
+	std::thread m_thread;							   // 書き出しスレッド
+	std::exception_ptr m_error;						   // 書き出しスレッドで発生した例外
+	bool m_has_segment;								   // 区間を開始したか (生産者)
+	std::atomic<std::uint64_t> m_bytes_written;		   // 書き込んだバイト数
+
+	/* 以下は書き出しスレッドのみが使用する */
+	std::vector<char> m_buffer;	   // 出力バッファ
+	std::uint64_t m_file_offset;   // バッファ先頭のファイル位置
+	std::size_t m_used;			   // バッファの使用量
+	EphemerisSegment m_segment;	   // 現在の区間
+	bool m_segment_open;		   // 区間を開始したか
+	std::uint64_t m_segment_count; // 現在の区間のレコード数
+	std::uint64_t m_count_offset;  // 現在の区間ヘッダのレコード数のファイル位置
+
+	auto enqueue(Item item) -> void {
+		if (!m_thread.joinable()) {
+			throw IoException("Ephemeris writer is closed", IoException::FileWriteError);
+		}
+		if (!m_queue.push(std::move(item))) {
+			rethrowError();
+		}
+	}
+
+	/**
+	 * @brief 書き出しスレッドで発生した例外を送出する
+	 * @note 例外は保持したままにし, 以降の write() や close() でも同じ例外を送出する
+	 *
+	 */
+	auto rethrowError() const -> void {
+		if (m_error) {
+			std::rethrow_exception(m_error);
+		}
+	}
+
+	auto run() -> void {
+		try {
+			writeFileHeader();
+			Item item;
+			while (m_queue.pop(item)) {
+				if (item.is_segment) {
+					endSegment();
+					startSegment(item.segment);
+				} else {
+					writeStates(item.states);
+					m_free_blocks.tryPush(item.states);
+				}
+			}
+			endSegment();
+			flush();
+			m_file.close();
+			if (m_file.fail()) {
+				throw IoException("Cannot write ephemeris file", IoException::FileWriteError);
+			}
+		} catch (...) {
+			m_error = std::current_exception();
+			m_queue.cancel();
+		}
+	}
+
+	auto writeFileHeader() -> void {
+		if (m_format == EphemerisFormat::Csv) {
+			append("object_id,time,x [m],y [m],z [m],vx [m/s],vy [m/s],vz [m/s]\n");
+		} else if (m_format == EphemerisFormat::Oem) {
+			char date[DateTime::iso8601_length];
+			append("CCSDS_OEM_VERS = 2.0\nCREATION_DATE = ");
+			append(std::string_view(date, DateTime::now().format(date)));
+			append("\nORIGINATOR = SATFIND\n");
+		} else {
+			EphemerisFileHeader header{};
+			std::memcpy(header.magic, magic, sizeof(magic));
+			header.version = version;
+			header.header_size = sizeof(EphemerisFileHeader);
+			header.segment_header_size = sizeof(EphemerisSegmentHeader);
+			header.record_size = sizeof(EphemerisRecord);
+			append(std::string_view(reinterpret_cast<const char*>(&header), sizeof(header)));
+		}
+	}
+
+	auto startSegment(const EphemerisSegment& segment) -> void {
+		m_segment = segment;
+		m_segment_open = true;
+		m_segment_count = 0;
+		if (m_format == EphemerisFormat::Oem) {
+			char date[DateTime::iso8601_length];
+			append("\nMETA_START\nOBJECT_NAME = ");
+			append(segment.object_name.view());
+			append("\nOBJECT_ID = ");
+			append(segment.object_id.view());
+			append("\nCENTER_NAME = EARTH\nREF_FRAME = TEME\nTIME_SYSTEM = UTC\nSTART_TIME = ");
+			append(std::string_view(date, segment.start.format(date)));
+			append("\nSTOP_TIME = ");
+			append(std::string_view(date, segment.stop.format(date)));
+			append("\nMETA_STOP\n\n");
+		} else if (m_format == EphemerisFormat::Binary) {
+			EphemerisSegmentHeader header{};
+			std::memcpy(header.object_name, segment.object_name.view().data(), segment.object_name.size());
+			std::memcpy(header.object_id, segment.object_id.view().data(), segment.object_id.size());
+			header.start_ticks = segment.start.ticks();
+			header.stop_ticks = segment.stop.ticks();
+			header.count = 0;
+			// 区間ヘッダはバッファの境界で分割しない (バッファは buffer_size を超えて区間ヘッダ1つ分の余裕を持つ)
+			if (m_used >= buffer_size) {
+				flush();
+			}
+			m_count_offset = m_file_offset + m_used + offsetof(EphemerisSegmentHeader, count);
+			std::memcpy(m_buffer.data() + m_used, &header, sizeof(header));
+			m_used += sizeof(header);
+		}
+	}
+
+	/**
+	 * @brief バイナリ形式の区間ヘッダにレコード数を書き込む
+	 * @note 区間ヘッダがバッファに残っている場合はバッファを書き換え, 書き込み済みの場合はファイルを書き換える
+	 */
+	auto endSegment() -> void {
+		if (!m_segment_open || m_format != EphemerisFormat::Binary) {
+			return;
+		}
+		m_segment_open = false;
+		if (m_count_offset >= m_file_offset) { // 区間ヘッダがバッファに残っている
+			std::memcpy(m_buffer.data() + (m_count_offset - m_file_offset), &m_segment_count, sizeof(m_segment_count));
+			return;
+		}
+		flush();
+		const auto end = m_file.tellp();
+		m_file.seekp(static_cast<std::streamoff>(m_count_offset));
+		m_file.write(reinterpret_cast<const char*>(&m_segment_count), sizeof(m_segment_count));
+		m_file.seekp(end);
+		if (!m_file) {
+			throw IoException("Cannot write ephemeris file", IoException::FileWriteError);
+		}
+	}
+
+	auto writeStates(const std::vector<StateVector>& states) -> void {
+		m_segment_count += states.size();
+		for (const auto& s : states) {
+			if (m_used >= buffer_size) {
+				flush();
+			}
+			char* p = m_buffer.data() + m_used;
+			switch (m_format) {
+				case EphemerisFormat::Csv:
+					m_used += formatCsvRow(p, m_segment.object_id.view(), s);
+					break;
+				case EphemerisFormat::Oem:
+					m_used += formatOemRow(p, s);
+					break;
+				case EphemerisFormat::Binary: {
+					EphemerisRecord r;
+					r.ticks = s.ticks;
+					for (int i = 0; i < 3; i++) {
+						r.position[i] = s.position[i];
+						r.velocity[i] = s.velocity[i];
+					}
+					std::memcpy(p, &r, sizeof(r));
+					m_used += sizeof(r);
+					break;
+				}
+			}
+		}
+	}
+
+	auto append(std::string_view text) -> void {
+		while (!text.empty()) {
+			if (m_used >= buffer_size) {
+				flush();
+			}
+			const std::size_t n = std::min(text.size(), buffer_size - m_used);
+			std::memcpy(m_buffer.data() + m_used, text.data(), n);
+			m_used += n;
+			text.remove_prefix(n);
+		}
+	}
+
+	auto flush() -> void {
+		if (m_used == 0) {
+			return;
+		}
+		Tracing::Span span("io", "EphemerisWriter::flush", "bytes", static_cast<std::int64_t>(m_used));
+		m_file.write(m_buffer.data(), static_cast<std::streamsize>(m_used));
+		if (!m_file) {
+			throw IoException("Cannot write ephemeris file", IoException::FileWriteError);
+		}
+		m_file_offset += m_used;
+		m_bytes_written.fetch_add(m_used, std::memory_order_relaxed);
+		m_used = 0;
+	}
+
+	static constexpr double power_of_ten[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+
+	static constexpr auto isLittleEndian() -> bool { return std::endian::native == std::endian::little; }
+};
+
+SATFIND_NAMESPACE_END
@@ -43,7 +43,10 @@ class TleException : public BaseException {
 		UnmatchedCatalogNumber,
 		InvalidIntegerString,
 		InvalidDoubleString,
-		InvalidExponentString
+		InvalidExponentString,
+		InvalidChecksum,
+		InvalidCatalogNumber,
+		FieldOutOfRange
 	};
 };
 
@@ -63,7 +66,11 @@ class DateTimeException : public BaseException {
 		InvalidDate,
 		InvalidTime,
 		InvalidDateTime,
-		InvalidIso8601Format
+		InvalidIso8601Format,
+		InvalidTimeGrid,
+		InvalidDeltaT,
+		InvalidLeapSecond,
+		InvalidTimeScale
 	};
 };
 
@@ -79,6 +86,36 @@ class OrbitException : public BaseException {
 		ShortPeriodPredictionError,
 		ParameterOutOfRange,
 		ObjectDecayed,
+		CatalogNumberMismatch,
+		EmptyElementHistory,
+	};
+};
+
+class EarthOrientationException : public BaseException {
+  public:
+	EarthOrientationException() = delete;
+	EarthOrientationException(const std::string& what_message, int error_code) : BaseException(what_message, error_code) {}
+
+	enum {
+		FileOpenError,
+		InvalidRecord,
+		EmptyTable,
+		OutOfRange,
+	};
+};
+
+class IoException : public BaseException {
+  public:
+	IoException() = delete;
+	IoException(const std::string& what_message, int error_code) : BaseException(what_message, error_code) {}
+
+	enum {
+		FileOpenError,
+		FileMapError,
+		FileReadError,
+		FileWriteError,
+		InvalidFormat,
+		ChecksumMismatch,
 	};
 };
 
@@ -0,0 +1,371 @@
+/**
+ * @file Executor.hpp
+ * @author fugu133
+ * @brief 一括処理の並列実行
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Essential.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief 一括処理を並列に実行する
+ * @note 一括処理の関数 (SatelliteCatalog, EphemerisStore::Writer, EphemerisExporter, 時刻列を扱う OrbitalPropagator, ElementHistory,
+ *       GroundObserver, FrameRotationCache, EphemerisWriter の関数) は実行器を引数に取る. 既存のスケジューラを使用する場合は
+ *       execute() を実装した派生クラスを渡す
+ */
+class Executor {
+  public:
+	/**
+	 * @brief 区間 [begin, end) を処理する関数への参照
+	 *
+	 */
+	struct RangeTask {
+		void* context;
+		void (*invoke)(void* context, std::size_t begin, std::size_t end, std::size_t worker);
+
+		auto operator()(std::size_t begin, std::size_t end, std::size_t worker) const -> void { invoke(context, begin, end, worker); }
+	};
+
+	virtual ~Executor() = default;
+
+	/**
+	 * @brief 同時に処理を実行する作業者の数
+	 *
+	 * @return std::size_t 作業者の数 (1 以上)
+	 */
+	virtual auto concurrency() const -> std::size_t = 0;
+
+	/**
+	 * @brief [0, count) を区間に分けて処理する
+	 * @note 実装は次を満たすこと
+	 *       - [0, count) を重ならない区間に分け, 各区間で task を1回呼び出す. 区間の長さは grain 以下
+	 *       - worker は [0, concurrency()) の番号で, 同じ番号の呼び出しが同時に実行されない
+	 *       - すべての呼び出しが終わってから戻る. task が例外を送出した場合は残りの区間を省略してよく, 例外の1つを送出する
+	 *
+	 * @param count 要素数
+	 * @param grain 1区間の最大の要素数 (1 以上)
+	 * @param task 区間を処理する関数
+	 */
+	virtual auto execute(std::size_t count, std::size_t grain, const RangeTask& task) -> void = 0;
+
+	/**
+	 * @brief [0, count) を grain 個以下の区間に分けて並列に処理する
+	 *
+	 * @param count 要素数
+	 * @param grain 1区間の最大の要素数 (0 の場合は 1)
+	 * @param body 区間を処理する関数 (begin, end, worker)
+	 */
+	template <class Body>
+	auto parallelFor(std::size_t count, std::size_t grain, Body&& body) -> void {
+		if (count == 0) {
+			return;
+		}
+		using Function = std::remove_reference_t<Body>;
+		const RangeTask task{const_cast<void*>(static_cast<const void*>(std::addressof(body))),
+							 [](void* context, std::size_t begin, std::size_t end, std::size_t worker) {
+								 (*static_cast<Function*>(context))(begin, end, worker);
+							 }};
+		execute(count, std::max<std::size_t>(1, grain), task);
+	}
+};
+
+/**
+ * @brief 呼び出し元のスレッドで順に処理する実行器
+ *
+ */
+class SerialExecutor : public Executor {
+  public:
+	auto concurrency() const -> std::size_t override { return 1; }
+
+	auto execute(std::size_t count, std::size_t grain, const RangeTask& task) -> void override {
+		for (std::size_t begin = 0; begin < count; begin += grain) {
+			task(begin, std::min(count, begin + grain), 0);
+		}
+	}
+};
+
+/**
+ * @brief ワークスティーリングによるスレッドプール
+ * @note concurrency - 1 個の作業スレッドを起動し, 呼び出し元のスレッドを作業者 0 として加える. execute() は [0, count) を作業者ごとの
+ *       連続した区間に分けて配り, 各作業者は自分の区間の先頭から grain 個ずつ処理する. 自分の区間が空になった作業者は,
+ *       他の作業者の区間の後半を奪って処理を続ける
+ * @remark 一度に実行する処理は1つで, 別のスレッドからの execute() は前の処理の終了を待つ. 処理の中から同じプールの execute() を
+ *         呼び出した場合は, 呼び出した作業者が順に処理する
+ */
+class ThreadPool : public Executor {
+  public:
+	/**
+	 * @brief Construct a new Thread Pool object
+	 *
+	 * @param concurrency 作業者の数 (0 の場合はハードウェアのスレッド数)
+	 */
+	explicit ThreadPool(std::size_t concurrency = 0)
+	  : m_concurrency(concurrency != 0 ? concurrency : std::max(1u, std::thread::hardware_concurrency())),
+		m_slots(std::make_unique<Slot[]>(m_concurrency)),
+		m_task(nullptr),
+		m_grain(1),
+		m_generation(0),
+		m_running(0),
+		m_stop(false),
+		m_failed(false) {
+		m_threads.reserve(m_concurrency - 1);
+		for (std::size_t w = 1; w < m_concurrency; w++) {
+			m_threads.emplace_back([this, w] { workerLoop(w); });
+		}
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+
+	~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_wake.notify_all();
+		for (auto& t : m_threads) {
+			t.join();
+		}
+	}
+
+	/**
+	 * @brief プロセスで共有するスレッドプール
+	 * @note 作業者の数はハードウェアのスレッド数. 最初に呼び出したときに作業スレッドを起動する
+	 *
+	 * @return ThreadPool&
+	 */
+	static auto shared() -> ThreadPool& {
+		static ThreadPool pool;
+		return pool;
+	}
+
+	auto concurrency() const -> std::size_t override { return m_concurrency; }
+
+	auto execute(std::size_t count, std::size_t grain, const RangeTask& task) -> void override {
+		Current& current = currentWorker();
+		if (current.pool == this) {
+			for (std::size_t begin = 0; begin < count; begin += grain) {
+				task(begin, std::min(count, begin + grain), current.worker);
+			}
+			return;
+		}
+
+		std::lock_guard<std::mutex> job(m_job_mutex);
+		const std::size_t chunks = (count + grain - 1) / grain;
+		if (chunks == 1 || m_concurrency == 1) {
+			// 作業スレッドを起こすまでもない場合
+			const Current previous = std::exchange(current, Current{this, 0});
+			try {
+				for (std::size_t begin = 0; begin < count; begin += grain) {
+					task(begin, std::min(count, begin + grain), 0);
+				}
+			} catch (...) {
+				current = previous;
+				throw;
+			}
+			current = previous;
+			return;
+		}
+		for (std::size_t w = 0; w < m_concurrency; w++) {
+			std::lock_guard<std::mutex> lock(m_slots[w].mutex);
+			m_slots[w].begin = std::min(count, chunks * w / m_concurrency * grain);
+			m_slots[w].end = std::min(count, chunks * (w + 1) / m_concurrency * grain);
+		}
+		m_failed.store(false, std::memory_order_relaxed);
+		m_error = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_task = &task;
+			m_grain = grain;
+			m_running = m_concurrency - 1;
+			m_generation++;
+		}
+		m_wake.notify_all();
+
+		const Current previous = std::exchange(current, Current{this, 0});
+		work(0);
+		current = previous;
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_done.wait(lock, [this] { return m_running == 0; });
+		m_task = nullptr;
+		if (m_error) {
+			std::rethrow_exception(std::exchange(m_error, nullptr));
+		}
+	}
+
+  private:
+	/**
+	 * @brief 作業者の未処理の区間
+	 *
+	 */
+	struct alignas(64) Slot {
+		std::mutex mutex;
+		std::size_t begin = 0;
+		std::size_t end = 0;
+	};
+
+	/**
+	 * @brief スレッドが処理中のプールと作業者の番号
+	 *
+	 */
+	struct Current {
+		ThreadPool* pool;
+		std::size_t worker;
+	};
+
+	std::size_t m_concurrency;			// 作業者の数
+	std::unique_ptr<Slot[]> m_slots;	// 作業者ごとの未処理の区間
+	std::vector<std::thread> m_threads; // 作業スレッド (作業者 1 以降)
+	std::mutex m_job_mutex;				// 実行中の処理の排他
+	std::mutex m_mutex;					// 以下の保護
+	std::condition_variable m_wake;		// 処理の開始, 終了要求
+	std::condition_variable m_done;		// 作業スレッドの終了
+	const RangeTask* m_task;			// 実行中の処理
+	std::size_t m_grain;				// 1区間の最大の要素数
+	std::uint64_t m_generation;			// 開始した処理の数
+	std::size_t m_running;				// 処理中の作業スレッドの数
+	bool m_stop;						// 終了要求
+	std::atomic<bool> m_failed;			// 例外が発生したか
+	std::mutex m_error_mutex;			// m_error の保護
+	std::exception_ptr m_error;			// 最初に発生した例外
+
+	static auto currentWorker() -> Current& {
+		thread_local Current current{nullptr, 0};
+		return current;
+	}
+
+	auto workerLoop(std::size_t worker) -> void {
+		currentWorker() = Current{this, worker};
+		std::uint64_t seen = 0;
+		for (;;) {
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+				if (m_stop) {
+					return;
+				}
+				seen = m_generation;
+			}
+			work(worker);
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (--m_running == 0) {
+					m_done.notify_one();
+				}
+			}
+		}
+	}
+
+	auto work(std::size_t worker) -> void {
+		std::size_t begin = 0;
+		std::size_t end = 0;
+		while (!m_failed.load(std::memory_order_relaxed) && (take(worker, begin, end) || steal(worker, begin, end))) {
+			try {
+				(*m_task)(begin, end, worker);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(m_error_mutex);
+				if (!m_error) {
+					m_error = std::current_exception();
+				}
+				m_failed.store(true, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/**
+	 * @brief 自分の区間の先頭から grain 個を取り出す
+	 *
+	 */
+	auto take(std::size_t worker, std::size_t& begin, std::size_t& end) -> bool {
+		Slot& slot = m_slots[worker];
+		std::lock_guard<std::mutex> lock(slot.mutex);
+		if (slot.begin >= slot.end) {
+			return false;
+		}
+		begin = slot.begin;
+		end = std::min(slot.end, slot.begin + m_grain);
+		slot.begin = end;
+		return true;
+	}
+
+	/**
+	 * @brief 他の作業者の区間の後半を奪い, その先頭から grain 個を取り出す
+	 * @note 奪った区間の残りは自分の区間とし, 他の作業者から奪えるようにする
+	 *
+	 */
+	auto steal(std::size_t worker, std::size_t& begin, std::size_t& end) -> bool {
+		for (std::size_t i = 1; i < m_concurrency; i++) {
+			Slot& victim = m_slots[(worker + i) % m_concurrency];
+			std::size_t first;
+			std::size_t last;
+			{
+				std::lock_guard<std::mutex> lock(victim.mutex);
+				const std::size_t remaining = victim.end > victim.begin ? victim.end - victim.begin : 0;
+				if (remaining == 0) {
+					continue;
+				}
+				const std::size_t stolen = remaining <= m_grain ? remaining : std::max(m_grain, remaining / 2);
+				last = victim.end;
+				first = last - stolen;
+				victim.end = first;
+			}
+			begin = first;
+			end = std::min(last, first + m_grain);
+			Slot& own = m_slots[worker];
+			std::lock_guard<std::mutex> lock(own.mutex);
+			own.begin = end;
+			own.end = last;
+			return true;
+		}
+		return false;
+	}
+};
+
+/**
+ * @brief 作業者ごとの作業領域
+ * @note 作業者の番号 (Executor::parallelFor の worker) で参照する. 要素はキャッシュラインごとに配置し, 作業者間の偽共有を避ける
+ *
+ * @tparam T 作業領域の型
+ */
+template <class T>
+class WorkerLocal {
+  public:
+	explicit WorkerLocal(const Executor& executor) : m_slots(executor.concurrency()) {}
+
+	auto operator[](std::size_t worker) -> T& { return m_slots[worker].value; }
+
+	auto operator[](std::size_t worker) const -> const T& { return m_slots[worker].value; }
+
+	auto size() const -> std::size_t { return m_slots.size(); }
+
+  private:
+	struct alignas(64) Slot {
+		T value{};
+	};
+
+	std::vector<Slot> m_slots; // 作業者ごとの作業領域
+};
+
+SATFIND_NAMESPACE_END
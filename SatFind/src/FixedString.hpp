@@ -0,0 +1,97 @@
+/**
+ * @file FixedString.hpp
+ * @author fugu133
+ * @brief 固定長の領域に文字列を保持するクラス
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "Essential.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief 最大N文字の文字列をオブジェクト内に保持する
+ * @note ヒープ領域を使用しないため, 代入やコピーでメモリ確保が発生しない. 終端のヌル文字を含めて N + 1 バイトを使用する
+ *
+ * @tparam N 最大文字数
+ */
+template <std::size_t N>
+class FixedString {
+  public:
+	FixedString() : m_size(0) { m_data[0] = '\0'; }
+
+	FixedString(std::string_view str) : FixedString() { assign(str); }
+
+	FixedString(const std::string& str) : FixedString(std::string_view(str)) {}
+
+	FixedString(const char* str) : FixedString(std::string_view(str)) {}
+
+	/**
+	 * @brief 文字列を代入する
+	 *
+	 * @param str 文字列 (N文字以下)
+	 */
+	auto assign(std::string_view str) -> void {
+		if (str.size() > N) {
+			throw std::length_error("FixedString capacity exceeded");
+		}
+		if (!str.empty()) {
+			std::memcpy(m_data, str.data(), str.size());
+		}
+		m_size = str.size();
+		m_data[m_size] = '\0';
+	}
+
+	auto operator=(std::string_view str) -> FixedString& {
+		assign(str);
+		return *this;
+	}
+
+	auto size() const -> std::size_t { return m_size; }
+
+	auto length() const -> std::size_t { return m_size; }
+
+	auto empty() const -> bool { return m_size == 0; }
+
+	static constexpr auto capacity() -> std::size_t { return N; }
+
+	auto data() const -> const char* { return m_data; }
+
+	auto c_str() const -> const char* { return m_data; }
+
+	auto begin() const -> const char* { return m_data; }
+
+	auto end() const -> const char* { return m_data + m_size; }
+
+	auto operator[](std::size_t i) const -> char { return m_data[i]; }
+
+	auto view() const -> std::string_view { return std::string_view(m_data, m_size); }
+
+	auto str() const -> std::string { return std::string(m_data, m_size); }
+
+	operator std::string_view() const { return view(); }
+
+	friend auto operator==(const FixedString& lhs, std::string_view rhs) -> bool { return lhs.view() == rhs; }
+
+	friend auto operator!=(const FixedString& lhs, std::string_view rhs) -> bool { return lhs.view() != rhs; }
+
+	friend std::ostream& operator<<(std::ostream& os, const FixedString& str) { return os << str.view(); }
+
+  private:
+	char m_data[N + 1];	 // 文字列 (ヌル終端)
+	std::size_t m_size; // 文字数
+};
+
+SATFIND_NAMESPACE_END
@@ -11,13 +11,21 @@
 
 #pragma once
 
+#include <vector>
+
 #include "Coordinate.hpp"
 #include "Essential.hpp"
+#include "Executor.hpp"
+#include "OrbitalElements.hpp"
+#include "TimeGrid.hpp"
+#include "Tracing.hpp"
 
 SATFIND_NAMESPACE_BEGIN
 
 class GroundObserver {
   public:
+	static constexpr std::size_t grid_grain = 1024; // 並列計算での時刻列の作業単位の時刻数
+
 	/**
 	 * @brief Construct a new Ground Observer object
 	 *
@@ -42,12 +50,88 @@ class GroundObserver {
 	GroundObserver(const Wgs84& wgs84) : GroundObserver(wgs84.elements()) {}
 
 	Topocentric lookUpPosition(const Eci& s_position) const {
+		return lookUp(s_position.epoch(), s_position.epoch().greenwichSiderealTime().radians(), observerEcef(), s_position.elements());
+	};
+
+	/**
+	 * @brief 時刻列の各時刻での衛星の見え方を計算する
+	 * @note 恒星時は時刻列の計算済みの値を使い, 観測者のECEF位置は一度だけ計算する
+	 *
+	 * @param grid 時刻列
+	 * @param states 各時刻の衛星の位置・速度 (TEME)
+	 * @return std::vector<Topocentric>
+	 */
+	auto lookUpPositions(const TimeGrid& grid, const std::vector<StateVector>& states) const -> std::vector<Topocentric> {
+		if (states.size() != grid.size()) {
+			throw OrbitException("Number of states does not match the time grid", OrbitException::ParameterOutOfRange);
+		}
+
+		Tracing::Span span("pass", "GroundObserver::lookUpPositions", "epochs", static_cast<std::int64_t>(states.size()));
+		const auto& gmst = grid.greenwichSiderealTimes();
+		const Eigen::Vector3d r_observer = observerEcef();
+
+		std::vector<Topocentric> ret;
+		ret.reserve(states.size());
+		for (std::size_t i = 0; i < states.size(); i++) {
+			ret.push_back(lookUp(states[i].epoch(), gmst[i], r_observer, states[i].position));
+		}
+		return ret;
+	}
+
+	/**
+	 * @brief 時刻列の各時刻での衛星の見え方を並列に計算する
+	 * @note 時刻列を grid_grain 個ずつの区間に分けて実行器に渡す
+	 *
+	 * @param grid 時刻列
+	 * @param states 各時刻の衛星の位置・速度 (TEME)
+	 * @param executor 実行器
+	 * @return std::vector<Topocentric>
+	 */
+	auto lookUpPositions(const TimeGrid& grid, const std::vector<StateVector>& states, Executor& executor) const
+	  -> std::vector<Topocentric> {
+		if (states.size() != grid.size()) {
+			throw OrbitException("Number of states does not match the time grid", OrbitException::ParameterOutOfRange);
+		}
+
+		Tracing::Span span("pass", "GroundObserver::lookUpPositions", "epochs", static_cast<std::int64_t>(states.size()));
+		const auto& gmst = grid.greenwichSiderealTimes();
+		const Eigen::Vector3d r_observer = observerEcef();
+
+		// 既定の構築子は現在時刻を取得するため, 要素は1つの値から複製して確保する
+		std::vector<Topocentric> ret(states.size(), Topocentric(DateTime(), TopocentricPosition{Angle::zero(), Angle::zero(), 0.0}));
+		executor.parallelFor(states.size(), grid_grain, [&](std::size_t begin, std::size_t end, std::size_t) {
+			for (std::size_t i = begin; i < end; i++) {
+				ret[i] = lookUp(states[i].epoch(), gmst[i], r_observer, states[i].position);
+			}
+		});
+		return ret;
+	}
+
+  private:
+	Wgs84Position m_position;
+
+	auto observerEcef() const -> Eigen::Vector3d { return Wgs84{DateTime(), m_position}.toEcef().elements(); }
+
+	/**
+	 * @brief 衛星の見え方を計算する
+	 *
+	 * @param epoch 時刻
+	 * @param gmst グリニッジ恒星時 [rad]
+	 * @param r_observer 観測者のECEF位置 [m]
+	 * @param s_position 衛星のECI位置 [m]
+	 * @return Topocentric
+	 */
+	auto lookUp(const DateTime& epoch, double gmst, const Eigen::Vector3d& r_observer, const Eigen::Vector3d& s_position) const
+	  -> Topocentric {
 		// 地方恒星時
-		auto lst = s_position.epoch().localSiderealTime(m_position.longitude);
+		const Angle lst = Radian{gmst} + m_position.longitude;
 
 		// 観測者から衛星への位置ベクトル
-		auto g_position = Wgs84{s_position.epoch(), m_position}.toEci();
-		Eigen::Vector3d r_eci = s_position.elements() - g_position.elements();
+		const double cos_gmst = std::cos(gmst);
+		const double sin_gmst = std::sin(gmst);
+		const Eigen::Vector3d g_position{r_observer.x() * cos_gmst - r_observer.y() * sin_gmst,
+										 r_observer.x() * sin_gmst + r_observer.y() * cos_gmst, r_observer.z()};
+		Eigen::Vector3d r_eci = s_position - g_position;
 
 		// ESU座標系に変換
 		decltype(r_eci) r_esu;
@@ -71,11 +155,8 @@ class GroundObserver {
 		aer.elevation = Radian(std::asin(r_esu.z() / aer.range));
 
 		// 位置ベクトルを極座標系に変換
-		return Topocentric{s_position.epoch(), aer};
-	};
-
-  private:
-	Wgs84Position m_position;
+		return Topocentric{epoch, aer};
+	}
 };
 
 SATFIND_NAMESPACE_END
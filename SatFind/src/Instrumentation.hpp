@@ -0,0 +1,294 @@
+/**
+ * @file Instrumentation.hpp
+ * @author fugu133
+ * @brief 伝搬処理の計測カウンタ
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Essential.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief 伝搬処理の計測カウンタとタイマ
+ * @note SATFIND_ENABLE_INSTRUMENTATION を定義してビルドした場合のみ計測する. 未定義の場合は記録用の関数が空になり, 伝搬処理に
+ *       追加の命令は生成されない (snapshot() はすべて 0 を返す).
+ *       カウンタはプロセス全体で共有し, std::memory_order_relaxed の原子操作で更新するため, 複数のスレッドから伝搬しても数え漏れは
+ *       ない. 段階ごとの計時は std::chrono::steady_clock を1段階あたり2回読むため, 有効にすると1回の伝搬が数十〜数百 ns 遅くなる
+ *       (時計の読み出し速度による)
+ * @remark SATFIND_ENABLE_INSTRUMENTATION はすべての翻訳単位で同じように定義すること
+ */
+class Instrumentation {
+  public:
+	/**
+	 * @brief 伝搬モデルの種別
+	 */
+	enum class Regime : std::size_t {
+		Sgp4,			 // SGP4
+		Sgp4Simple,		 // SGP4 (近地点高度 220 km 未満の簡易モデル)
+		Sdp4,			 // SDP4 (共鳴なし)
+		Sdp4HalfDay,	 // SDP4 (半日周期の共鳴)
+		Sdp4Synchronous, // SDP4 (1日周期の共鳴)
+	};
+
+	/**
+	 * @brief 計時する処理の段階
+	 */
+	enum class Stage : std::size_t {
+		Propagate,			// 1回の伝搬全体
+		DeepSpaceSecular,	// 深宇宙の永年項と共鳴の数値積分
+		DeepSpacePeriodics, // 深宇宙の長周期項
+		Kepler,				// ケプラー方程式と短周期項, 位置・速度の計算
+	};
+
+	static constexpr std::size_t regime_count = 5;
+	static constexpr std::size_t stage_count = 4;
+	static constexpr std::size_t max_iterations = 10;									// ケプラー方程式, 測地緯度の最大反復回数
+	static constexpr std::size_t error_count = OrbitException::EmptyElementHistory + 1; // OrbitException のエラーコード数
+
+#if defined(SATFIND_ENABLE_INSTRUMENTATION)
+	static constexpr bool enabled = true;
+#else
+	static constexpr bool enabled = false;
+#endif
+
+	/**
+	 * @brief ある時点のカウンタの値
+	 * @note 各カウンタは独立に読むため, 伝搬中に取得した場合は合計が一致しないことがある
+	 */
+	struct Snapshot {
+		std::array<std::uint64_t, regime_count> calls{};				   // 伝搬モデルごとの呼び出し回数
+		std::uint64_t integrator_steps = 0;								   // 共鳴の数値積分で進めた 720 分ステップ数
+		std::uint64_t integrator_restarts = 0;							   // 数値積分を元期からやり直した回数
+		std::array<std::uint64_t, max_iterations + 1> kepler_iterations{}; // ケプラー方程式の反復回数の分布 (添字が回数)
+		std::uint64_t kepler_not_converged = 0;							   // 最大回数で収束しなかった回数
+		std::array<std::uint64_t, max_iterations + 1> wgs84_iterations{};  // 測地緯度の反復回数の分布 (添字が回数)
+		std::array<std::uint64_t, error_count> errors{};				   // OrbitException のエラーコードごとの送出回数
+		std::array<std::uint64_t, stage_count> stage_calls{};			   // 段階ごとの計時回数
+		std::array<std::uint64_t, stage_count> stage_nanoseconds{};		   // 段階ごとの合計時間 [ns]
+
+		/**
+		 * @brief すべてのカウンタを名前と値の組で列挙する
+		 * @note 名前は "propagator.calls.sgp4", "propagator.kepler_iterations.3" のようにドットで区切る. メトリクス収集系への
+		 *       書き出しを想定する
+		 *
+		 * @tparam F void(const std::string& name, std::uint64_t value) として呼び出せる型
+		 * @param f 各カウンタについて呼び出す関数
+		 */
+		template <class F>
+		auto forEach(F&& f) const -> void {
+			static constexpr const char* regime_names[regime_count] = {"sgp4", "sgp4_simple", "sdp4", "sdp4_half_day", "sdp4_synchronous"};
+			static constexpr const char* stage_names[stage_count] = {"propagate", "deep_space_secular", "deep_space_periodics", "kepler"};
+			static constexpr const char* error_names[error_count] = {"eccentricity_out_of_range",
+																	  "inclination_out_of_range",
+																	  "long_period_prediction_error",
+																	  "short_period_prediction_error",
+																	  "parameter_out_of_range",
+																	  "object_decayed",
+																	  "catalog_number_mismatch",
+																	  "empty_element_history"};
+
+			for (std::size_t i = 0; i < regime_count; i++) {
+				f(std::string("propagator.calls.") + regime_names[i], calls[i]);
+			}
+			f(std::string("propagator.integrator_steps"), integrator_steps);
+			f(std::string("propagator.integrator_restarts"), integrator_restarts);
+			for (std::size_t i = 1; i <= max_iterations; i++) {
+				f("propagator.kepler_iterations." + std::to_string(i), kepler_iterations[i]);
+			}
+			f(std::string("propagator.kepler_not_converged"), kepler_not_converged);
+			for (std::size_t i = 1; i <= max_iterations; i++) {
+				f("coordinate.wgs84_iterations." + std::to_string(i), wgs84_iterations[i]);
+			}
+			for (std::size_t i = 0; i < error_count; i++) {
+				f(std::string("propagator.errors.") + error_names[i], errors[i]);
+			}
+			for (std::size_t i = 0; i < stage_count; i++) {
+				f(std::string("propagator.stage_calls.") + stage_names[i], stage_calls[i]);
+				f(std::string("propagator.stage_nanoseconds.") + stage_names[i], stage_nanoseconds[i]);
+			}
+		}
+	};
+
+	/**
+	 * @brief 段階の所要時間を計るスコープ
+	 * @note 構築から破棄 (または stop()) までの時間を記録する. 例外で抜けた場合も記録する
+	 */
+	class StageTimer {
+	  public:
+#if defined(SATFIND_ENABLE_INSTRUMENTATION)
+		explicit StageTimer(Stage stage) : m_stage(stage), m_start(std::chrono::steady_clock::now()), m_running(true) {}
+
+		~StageTimer() { stop(); }
+
+		auto stop() -> void {
+			if (m_running) {
+				m_running = false;
+				const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start);
+				addStage(m_stage, static_cast<std::uint64_t>(elapsed.count()));
+			}
+		}
+
+	  private:
+		Stage m_stage;
+		std::chrono::steady_clock::time_point m_start;
+		bool m_running;
+#else
+		explicit StageTimer(Stage) {}
+
+		auto stop() -> void {}
+#endif
+	  public:
+		StageTimer(const StageTimer&) = delete;
+		auto operator=(const StageTimer&) -> StageTimer& = delete;
+	};
+
+	/**
+	 * @brief 現在のカウンタの値を取得する
+	 *
+	 * @return Snapshot カウンタの値
+	 */
+	static auto snapshot() -> Snapshot {
+		Snapshot s;
+#if defined(SATFIND_ENABLE_INSTRUMENTATION)
+		const auto& c = counters();
+		load(c.calls, s.calls);
+		s.integrator_steps = c.integrator_steps.load(std::memory_order_relaxed);
+		s.integrator_restarts = c.integrator_restarts.load(std::memory_order_relaxed);
+		load(c.kepler_iterations, s.kepler_iterations);
+		s.kepler_not_converged = c.kepler_not_converged.load(std::memory_order_relaxed);
+		load(c.wgs84_iterations, s.wgs84_iterations);
+		load(c.errors, s.errors);
+		load(c.stage_calls, s.stage_calls);
+		load(c.stage_nanoseconds, s.stage_nanoseconds);
+#endif
+		return s;
+	}
+
+	/**
+	 * @brief すべてのカウンタを 0 に戻す
+	 */
+	static auto reset() -> void {
+#if defined(SATFIND_ENABLE_INSTRUMENTATION)
+		auto& c = counters();
+		clear(c.calls);
+		c.integrator_steps.store(0, std::memory_order_relaxed);
+		c.integrator_restarts.store(0, std::memory_order_relaxed);
+		clear(c.kepler_iterations);
+		c.kepler_not_converged.store(0, std::memory_order_relaxed);
+		clear(c.wgs84_iterations);
+		clear(c.errors);
+		clear(c.stage_calls);
+		clear(c.stage_nanoseconds);
+#endif
+	}
+
+	/* 以下は伝搬処理から呼び出す記録用の関数 */
+
+	static auto addCall([[maybe_unused]] Regime regime) -> void {
+#if defined(SATFIND_ENABLE_INSTRUMENTATION)
+		increment(counters().calls[static_cast<std::size_t>(regime)]);
+#endif
+	}
+
+	static auto addIntegratorStep() -> void {
+#if defined(SATFIND_ENABLE_INSTRUMENTATION)
+		increment(counters().integrator_steps);
+#endif
+	}
+
+	static auto addIntegratorRestart() -> void {
+#if defined(SATFIND_ENABLE_INSTRUMENTATION)
+		increment(counters().integrator_restarts);
+#endif
+	}
+
+	static auto addKeplerIterations([[maybe_unused]] int iterations, [[maybe_unused]] bool converged) -> void {
+#if defined(SATFIND_ENABLE_INSTRUMENTATION)
+		increment(counters().kepler_iterations[clampIterations(iterations)]);
+		if (!converged) {
+			increment(counters().kepler_not_converged);
+		}
+#endif
+	}
+
+	static auto addWgs84Iterations([[maybe_unused]] int iterations) -> void {
+#if defined(SATFIND_ENABLE_INSTRUMENTATION)
+		increment(counters().wgs84_iterations[clampIterations(iterations)]);
+#endif
+	}
+
+	static auto addError([[maybe_unused]] int error_code) -> void {
+#if defined(SATFIND_ENABLE_INSTRUMENTATION)
+		if (error_code >= 0 && static_cast<std::size_t>(error_code) < error_count) {
+			increment(counters().errors[static_cast<std::size_t>(error_code)]);
+		}
+#endif
+	}
+
+  private:
+#if defined(SATFIND_ENABLE_INSTRUMENTATION)
+	using Counter = std::atomic<std::uint64_t>;
+
+	/**
+	 * @brief カウンタの実体
+	 * @note 呼び出し回数と段階の計時は毎回更新されるため, 他のカウンタとキャッシュラインを分ける
+	 */
+	struct Counters {
+		alignas(64) std::array<Counter, regime_count> calls{};
+		alignas(64) std::array<Counter, max_iterations + 1> kepler_iterations{};
+		Counter kepler_not_converged{0};
+		alignas(64) std::array<Counter, stage_count> stage_calls{};
+		std::array<Counter, stage_count> stage_nanoseconds{};
+		alignas(64) std::array<Counter, max_iterations + 1> wgs84_iterations{};
+		alignas(64) Counter integrator_steps{0};
+		Counter integrator_restarts{0};
+		std::array<Counter, error_count> errors{};
+	};
+
+	static auto counters() -> Counters& {
+		static Counters c;
+		return c;
+	}
+
+	static auto increment(Counter& counter, std::uint64_t value = 1) -> void { counter.fetch_add(value, std::memory_order_relaxed); }
+
+	static auto addStage(Stage stage, std::uint64_t nanoseconds) -> void {
+		increment(counters().stage_calls[static_cast<std::size_t>(stage)]);
+		increment(counters().stage_nanoseconds[static_cast<std::size_t>(stage)], nanoseconds);
+	}
+
+	static auto clampIterations(int iterations) -> std::size_t {
+		return iterations < 0 ? 0 : iterations > static_cast<int>(max_iterations) ? max_iterations : static_cast<std::size_t>(iterations);
+	}
+
+	template <std::size_t N>
+	static auto load(const std::array<Counter, N>& from, std::array<std::uint64_t, N>& to) -> void {
+		for (std::size_t i = 0; i < N; i++) {
+			to[i] = from[i].load(std::memory_order_relaxed);
+		}
+	}
+
+	template <std::size_t N>
+	static auto clear(std::array<Counter, N>& counters) -> void {
+		for (auto& c : counters) {
+			c.store(0, std::memory_order_relaxed);
+		}
+	}
+#endif
+};
+
+SATFIND_NAMESPACE_END
@@ -0,0 +1,185 @@
+/**
+ * @file LiveCatalog.hpp
+ * @author fugu133
+ * @brief 伝搬を止めずに更新できる衛星カタログ
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Essential.hpp"
+#include "OmmReader.hpp"
+#include "SatelliteCatalog.hpp"
+#include "Tle.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief カタログに適用する差分
+ * @note 追加・更新は, カタログ番号が未登録の場合は追加し, 登録済みの場合は元期が新しいときのみ置き換える
+ */
+struct CatalogDelta {
+	std::vector<Tle> elements;		// 追加・更新する TLE
+	std::vector<OmmRecord> records; // 追加・更新する OMM レコード
+	std::vector<int> removals;		// 削除するカタログ番号
+
+	auto empty() const -> bool { return elements.empty() && records.empty() && removals.empty(); }
+};
+
+/**
+ * @brief 伝搬を止めずに更新できる衛星カタログ
+ * @note 読み手は snapshot() で変更されないカタログ (スナップショット) を取得して使用する. 更新は現在のスナップショットの複製に
+ *       差分を適用して新しいスナップショットを作り, ポインタの交換で公開する. 読み手は更新を待たず, 更新途中の状態を見ることもない.
+ *       古いスナップショットは最後の読み手が参照を手放した時点で解放される
+ * @remark ハンドルはスナップショットごとに有効. 削除を含む差分を適用した場合, 新しいスナップショットではハンドルが変わることがある
+ */
+class LiveCatalog {
+  public:
+	using Snapshot = std::shared_ptr<const SatelliteCatalog>;
+
+	LiveCatalog() : LiveCatalog(SatelliteCatalog()) {}
+
+	/**
+	 * @brief Construct a new Live Catalog object
+	 *
+	 * @param catalog 初期カタログ
+	 */
+	explicit LiveCatalog(SatelliteCatalog catalog) : m_version(0) { store(std::make_shared<const SatelliteCatalog>(std::move(catalog))); }
+
+	LiveCatalog(const LiveCatalog&) = delete;
+	auto operator=(const LiveCatalog&) -> LiveCatalog& = delete;
+
+	/**
+	 * @brief 現在のスナップショットを取得する
+	 * @note 取得したスナップショットは参照を保持している間, 更新の影響を受けない
+	 *
+	 * @return Snapshot スナップショット
+	 */
+	auto snapshot() const -> Snapshot { return load(); }
+
+	/**
+	 * @brief 更新の回数
+	 * @note publish() と apply() で新しいスナップショットを公開するたびに1増える
+	 *
+	 */
+	auto version() const -> std::uint64_t { return m_version.load(std::memory_order_acquire); }
+
+	/**
+	 * @brief カタログ全体を置き換える
+	 *
+	 * @param catalog 新しいカタログ
+	 * @return Snapshot 公開したスナップショット
+	 */
+	auto publish(SatelliteCatalog catalog) -> Snapshot {
+		const std::lock_guard<std::mutex> lock(m_update_mutex);
+		return publishLocked(std::make_shared<const SatelliteCatalog>(std::move(catalog)));
+	}
+
+	/**
+	 * @brief 差分を適用する
+	 * @note 更新は直列に行う. 伝搬器の初期化に失敗した要素 (OrbitException) は適用しない
+	 *
+	 * @param delta 差分
+	 * @return Snapshot 公開したスナップショット
+	 */
+	auto apply(const CatalogDelta& delta) -> Snapshot {
+		const std::lock_guard<std::mutex> lock(m_update_mutex);
+		const Snapshot current = load();
+		if (delta.empty()) {
+			return current;
+		}
+
+		auto next = std::make_shared<SatelliteCatalog>(withoutRemovals(*current, delta.removals));
+		for (const auto& tle : delta.elements) {
+			if (isNewer(*next, tle.catalogNumber(), tle.epoch())) {
+				tryAdd(*next, tle);
+			}
+		}
+		for (const auto& record : delta.records) {
+			if (isNewer(*next, record.norad_cat_id, record.epoch)) {
+				tryAdd(*next, record);
+			}
+		}
+
+		return publishLocked(std::move(next));
+	}
+
+  private:
+#if defined(__cpp_lib_atomic_shared_ptr)
+	std::atomic<Snapshot> m_snapshot; // 公開中のスナップショット
+#else
+	Snapshot m_snapshot; // 公開中のスナップショット (std::atomic_load / std::atomic_store で操作する)
+#endif
+	std::atomic<std::uint64_t> m_version; // 更新の回数
+	std::mutex m_update_mutex;			  // 更新を直列にする
+
+	auto load() const -> Snapshot {
+#if defined(__cpp_lib_atomic_shared_ptr)
+		return m_snapshot.load(std::memory_order_acquire);
+#else
+		return std::atomic_load_explicit(&m_snapshot, std::memory_order_acquire);
+#endif
+	}
+
+	auto store(Snapshot snapshot) -> void {
+#if defined(__cpp_lib_atomic_shared_ptr)
+		m_snapshot.store(std::move(snapshot), std::memory_order_release);
+#else
+		std::atomic_store_explicit(&m_snapshot, std::move(snapshot), std::memory_order_release);
+#endif
+	}
+
+	auto publishLocked(Snapshot snapshot) -> Snapshot {
+		store(snapshot);
+		m_version.fetch_add(1, std::memory_order_acq_rel);
+		return snapshot;
+	}
+
+	/**
+	 * @brief 削除するカタログ番号を除いた複製を作る
+	 * @note 削除がない場合はそのまま複製し, ハンドルを保つ
+	 *
+	 */
+	static auto withoutRemovals(const SatelliteCatalog& catalog, std::vector<int> removals) -> SatelliteCatalog {
+		if (removals.empty()) {
+			return catalog;
+		}
+		std::sort(removals.begin(), removals.end());
+
+		SatelliteCatalog result;
+		result.reserve(catalog.size());
+		for (SatelliteCatalog::Handle h = 0; h < catalog.size(); h++) {
+			const auto& entry = catalog.entry(h);
+			if (!std::binary_search(removals.begin(), removals.end(), entry.catalog_number)) {
+				result.add(entry, catalog.propagator(h));
+			}
+		}
+		return result;
+	}
+
+	static auto isNewer(const SatelliteCatalog& catalog, int catalog_number, const DateTime& epoch) -> bool {
+		const auto handle = catalog.find(catalog_number);
+		return handle == SatelliteCatalog::invalid_handle || epoch > catalog.entry(handle).epoch;
+	}
+
+	template <class Element>
+	static auto tryAdd(SatelliteCatalog& catalog, const Element& element) -> void {
+		try {
+			catalog.add(element);
+		} catch (const OrbitException&) {
+		}
+	}
+};
+
+SATFIND_NAMESPACE_END
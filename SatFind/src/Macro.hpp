@@ -43,6 +43,14 @@
 	}                                               \
 }
 
+// SATFIND_COMPILED_LIBRARY を定義した場合は *Impl.hpp の定義をヘッダから取り込まず, ライブラリ (satfind) で一度だけコンパイルする
+#if defined(SATFIND_COMPILED_LIBRARY)
+#define SATFIND_INLINE
+#else
+#define SATFIND_HEADER_ONLY
+#define SATFIND_INLINE inline
+#endif
+
 #define SATFIND_REQUEST_VERSION_CHECK(major, minor, patch) \
 	(SATFIND_VERSION_MAJOR >= major && SATFIND_VERSION_MINOR >= minor && SATFIND_VERSION_PATCH >= patch)
 
@@ -0,0 +1,137 @@
+/**
+ * @file MappedFile.hpp
+ * @author fugu133
+ * @brief 読み込み専用のメモリマップドファイル
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SATFIND_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Essential.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief 読み込み専用のメモリマップドファイル
+ * @note POSIX 環境では mmap でファイル全体を写像し, それ以外の環境ではファイル全体をバッファに読み込む.
+ *       いずれの場合も view() で得た領域はオブジェクトが破棄されるまで有効
+ */
+class MappedFile {
+  public:
+	MappedFile() : m_data(nullptr), m_size(0) {}
+
+	/**
+	 * @brief Construct a new Mapped File object
+	 *
+	 * @param path ファイルパス
+	 */
+	explicit MappedFile(const std::string& path) : MappedFile() { open(path); }
+
+	MappedFile(const MappedFile&) = delete;
+	auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+	MappedFile(MappedFile&& other) noexcept : MappedFile() { swap(other); }
+
+	auto operator=(MappedFile&& other) noexcept -> MappedFile& {
+		if (this != &other) {
+			close();
+			swap(other);
+		}
+		return *this;
+	}
+
+	~MappedFile() { close(); }
+
+	auto data() const -> const char* { return m_data; }
+
+	auto size() const -> std::size_t { return m_size; }
+
+	auto empty() const -> bool { return m_size == 0; }
+
+	auto view() const -> std::string_view { return std::string_view(m_data, m_size); }
+
+  private:
+	const char* m_data;		   // 先頭アドレス
+	std::size_t m_size;		   // バイト数
+	std::vector<char> m_buffer; // mmap を使用できない場合の読み込み先
+
+	auto open(const std::string& path) -> void {
+#if defined(SATFIND_HAS_MMAP)
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			throw IoException("Cannot open file: " + path, IoException::FileOpenError);
+		}
+
+		struct stat st;
+		if (::fstat(fd, &st) != 0) {
+			::close(fd);
+			throw IoException("Cannot stat file: " + path, IoException::FileOpenError);
+		}
+
+		m_size = static_cast<std::size_t>(st.st_size);
+		if (m_size == 0) {
+			::close(fd);
+			return;
+		}
+
+		void* addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if (addr == MAP_FAILED) {
+			m_size = 0;
+			throw IoException("Cannot map file: " + path, IoException::FileMapError);
+		}
+		::madvise(addr, m_size, MADV_SEQUENTIAL);
+		m_data = static_cast<const char*>(addr);
+#else
+		std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+		if (!ifs) {
+			throw IoException("Cannot open file: " + path, IoException::FileOpenError);
+		}
+		m_buffer.resize(static_cast<std::size_t>(ifs.tellg()));
+		ifs.seekg(0);
+		if (!ifs.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()))) {
+			throw IoException("Cannot read file: " + path, IoException::FileReadError);
+		}
+		m_data = m_buffer.data();
+		m_size = m_buffer.size();
+#endif
+	}
+
+	auto close() -> void {
+#if defined(SATFIND_HAS_MMAP)
+		if (m_data != nullptr && m_buffer.empty()) {
+			::munmap(const_cast<char*>(m_data), m_size);
+		}
+#endif
+		m_data = nullptr;
+		m_size = 0;
+		m_buffer.clear();
+	}
+
+	auto swap(MappedFile& other) noexcept -> void {
+		std::swap(m_data, other.m_data);
+		std::swap(m_size, other.m_size);
+		std::swap(m_buffer, other.m_buffer);
+	}
+};
+
+SATFIND_NAMESPACE_END
@@ -0,0 +1,724 @@
+/**
+ * @file OmmReader.hpp
+ * @author fugu133
+ * @brief CCSDS OMM (Orbit Mean-Elements Message) の読み込み
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DateTime.hpp"
+#include "Essential.hpp"
+#include "FixedString.hpp"
+#include "MappedFile.hpp"
+#include "OrbitalElements.hpp"
+#include "Tracing.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief OMM の表現形式
+ *
+ */
+enum class OmmFormat {
+	Auto, // 内容から判定する
+	Kvn,  // Keyword = Value 形式
+	Xml,  // XML 形式
+	Csv,  // 見出し行付きの CSV 形式 (CelesTrak / Space-Track の GP データ)
+};
+
+/**
+ * @brief OMM の1レコード
+ * @note 角度と平均運動の単位は TLE と同じ. 文字列はオブジェクト内に保持するため, レコードの複製でメモリ確保は発生しない
+ */
+struct OmmRecord {
+	FixedString<64> object_name; // 衛星名
+	FixedString<16> object_id;	 // 国際識別符号 (例: 1998-067A)
+	int norad_cat_id;			 // カタログ番号 (9桁まで)
+	char classification;		 // 機密区分
+	int ephemeris_type;			 // 軌道モデル
+	int element_set_no;			 // 要素セット番号
+	std::int64_t rev_at_epoch;	 // 元期における周回数
+	DateTime epoch;				 // 元期 (UTC)
+	double mean_motion;			 // 平均運動 [rev/day]
+	double eccentricity;		 // 離心率
+	double inclination;			 // 軌道傾斜角 [deg]
+	double ra_of_asc_node;		 // 昇交点赤経 [deg]
+	double arg_of_pericenter;	 // 近地点引数 [deg]
+	double mean_anomaly;		 // 平均近点角 [deg]
+	double b_star;				 // B* 抗力項 [1/earth radii]
+	double mean_motion_dot;		 // 平均運動の1次微分 / 2 [rev/day^2]
+	double mean_motion_ddot;	 // 平均運動の2次微分 / 6 [rev/day^3]
+
+	static constexpr int max_norad_cat_id = 999999999; // カタログ番号の最大値 (9桁)
+
+	OmmRecord()
+	  : norad_cat_id(0),
+		classification('U'),
+		ephemeris_type(0),
+		element_set_no(0),
+		rev_at_epoch(0),
+		epoch(),
+		mean_motion(0.0),
+		eccentricity(0.0),
+		inclination(0.0),
+		ra_of_asc_node(0.0),
+		arg_of_pericenter(0.0),
+		mean_anomaly(0.0),
+		b_star(0.0),
+		mean_motion_dot(0.0),
+		mean_motion_ddot(0.0) {}
+
+	/**
+	 * @brief SGP4/SDP4 の軌道要素に変換する
+	 * @note TLE 文字列を経由しない
+	 *
+	 * @return OrbitalElements 軌道要素
+	 */
+	auto toOrbitalElements() const -> OrbitalElements {
+		return OrbitalElements::fromMeanElements(epoch, mean_motion, eccentricity, inclination, ra_of_asc_node, arg_of_pericenter,
+												 mean_anomaly, b_star);
+	}
+};
+
+/**
+ * @brief OMM 中の不正なレコード
+ *
+ */
+struct OmmError {
+	std::size_t line_number; // レコード先頭の行番号 (1始まり)
+	std::string message;	 // エラーメッセージ
+};
+
+/**
+ * @brief CCSDS OMM の読み込み
+ * @note KVN, XML, CSV の各形式のバルクファイルを先頭から1回走査して読み込む. ファイルはメモリマップし, 値は std::from_chars で
+ *       直接変換するため, 1レコードあたりのメモリ確保は結果の格納以外に発生しない
+ * @remark 不正なレコードは読み飛ばして errors() に記録し, 読み込みを中断しない. JSON 形式には対応しない
+ */
+class OmmReader {
+  public:
+	/**
+	 * @brief Construct a new Omm Reader object
+	 *
+	 * @param format 表現形式
+	 */
+	explicit OmmReader(OmmFormat format = OmmFormat::Auto) : m_format(format) {}
+
+	/**
+	 * @brief Construct a new Omm Reader object
+	 *
+	 * @param path OMM ファイルのパス
+	 * @param format 表現形式
+	 */
+	explicit OmmReader(const std::string& path, OmmFormat format = OmmFormat::Auto) : m_format(format) { readFile(path); }
+
+	/**
+	 * @brief OMM ファイルを読み込む
+	 * @note 読み込んだレコードは records() の末尾に追加する
+	 *
+	 * @param path OMM ファイルのパス
+	 * @return std::size_t 読み込んだレコードの数
+	 */
+	auto readFile(const std::string& path) -> std::size_t {
+		const MappedFile file(path);
+		return read(file.view());
+	}
+
+	/**
+	 * @brief OMM 文字列を読み込む
+	 * @note 読み込んだレコードは records() の末尾に追加する
+	 *
+	 * @param text OMM の内容
+	 * @return std::size_t 読み込んだレコードの数
+	 */
+	auto read(std::string_view text) -> std::size_t {
+		Tracing::Span span("catalog", "OmmReader::read", "bytes", static_cast<std::int64_t>(text.size()));
+		const std::size_t first = m_records.size();
+		const OmmFormat format = m_format == OmmFormat::Auto ? detectFormat(text) : m_format;
+		m_records.reserve(first + text.size() / recordSizeHint(format));
+
+		forEachRecord(
+		  text, format, [this](std::size_t, const OmmRecord& record) { m_records.push_back(record); },
+		  [this](std::size_t line_number, std::string message) { m_errors.push_back({line_number, std::move(message)}); });
+
+		return m_records.size() - first;
+	}
+
+	/**
+	 * @brief 読み込んだレコードを取得する
+	 *
+	 */
+	auto records() const -> const std::vector<OmmRecord>& { return m_records; }
+
+	/**
+	 * @brief 読み込んだレコードを取り出す
+	 * @note 取り出した後は records() は空になる
+	 *
+	 */
+	auto takeRecords() -> std::vector<OmmRecord> { return std::move(m_records); }
+
+	/**
+	 * @brief 読み込んだレコードを軌道要素に変換する
+	 *
+	 * @return std::vector<OrbitalElements> 軌道要素
+	 */
+	auto elements() const -> std::vector<OrbitalElements> {
+		std::vector<OrbitalElements> elements;
+		elements.reserve(m_records.size());
+		for (const auto& record : m_records) {
+			elements.push_back(record.toOrbitalElements());
+		}
+		return elements;
+	}
+
+	/**
+	 * @brief 読み飛ばした不正なレコードを取得する
+	 *
+	 */
+	auto errors() const -> const std::vector<OmmError>& { return m_errors; }
+
+	auto clear() -> void {
+		m_records.clear();
+		m_errors.clear();
+	}
+
+	/**
+	 * @brief 内容から表現形式を判定する
+	 * @note 先頭の空白と BOM を除いた最初の文字が '<' であれば XML, 最初の行が '=' を含めば KVN, それ以外は CSV とする
+	 *
+	 * @param text OMM の内容
+	 * @return OmmFormat 表現形式
+	 */
+	static auto detectFormat(std::string_view text) -> OmmFormat {
+		if (text.substr(0, 3) == "\xEF\xBB\xBF") {
+			text.remove_prefix(3);
+		}
+		const std::size_t first = text.find_first_not_of(" \t\r\n");
+		if (first == std::string_view::npos) {
+			return OmmFormat::Csv;
+		}
+		if (text[first] == '<') {
+			return OmmFormat::Xml;
+		}
+		const std::string_view line = text.substr(first, text.find('\n', first) - first);
+		return line.find('=') != std::string_view::npos ? OmmFormat::Kvn : OmmFormat::Csv;
+	}
+
+	/**
+	 * @brief OMM を先頭から走査し, レコードごとに関数を呼び出す
+	 * @note 各レコードは呼び出しの間だけ有効な一時オブジェクトとして渡す
+	 *
+	 * @param text OMM の内容
+	 * @param format 表現形式 (Auto の場合は内容から判定する)
+	 * @param record record(先頭行番号, レコード)
+	 * @param error error(先頭行番号, メッセージ)
+	 */
+	template <class RecordFunction, class ErrorFunction>
+	static auto forEachRecord(std::string_view text, OmmFormat format, RecordFunction&& record, ErrorFunction&& error) -> void {
+		if (text.substr(0, 3) == "\xEF\xBB\xBF") {
+			text.remove_prefix(3);
+		}
+		switch (format == OmmFormat::Auto ? detectFormat(text) : format) {
+			case OmmFormat::Kvn:
+				parseKvn(text, record, error);
+				break;
+			case OmmFormat::Xml:
+				parseXml(text, record, error);
+				break;
+			default:
+				parseCsv(text, record, error);
+				break;
+		}
+	}
+
+  private:
+	std::vector<OmmRecord> m_records; // 読み込んだレコード
+	std::vector<OmmError> m_errors;	  // 読み飛ばしたレコード
+	OmmFormat m_format;				  // 表現形式
+
+	// 1レコードのおおよそのバイト数 (要素数の見積もりに使用)
+	static auto recordSizeHint(OmmFormat format) -> std::size_t {
+		switch (format) {
+			case OmmFormat::Kvn:
+				return 1024;
+			case OmmFormat::Xml:
+				return 1536;
+			default:
+				return 192;
+		}
+	}
+
+	enum class Field : std::uint8_t {
+		Unknown,
+		ObjectName,
+		ObjectId,
+		MeanElementTheory,
+		TimeSystem,
+		Epoch,
+		MeanMotion,
+		Eccentricity,
+		Inclination,
+		RaOfAscNode,
+		ArgOfPericenter,
+		MeanAnomaly,
+		EphemerisType,
+		ClassificationType,
+		NoradCatId,
+		ElementSetNo,
+		RevAtEpoch,
+		BStar,
+		MeanMotionDot,
+		MeanMotionDdot,
+	};
+
+	struct FieldName {
+		std::string_view key;
+		Field field;
+	};
+
+	static constexpr FieldName field_names[] = {
+	  {"OBJECT_NAME", Field::ObjectName},
+	  {"OBJECT_ID", Field::ObjectId},
+	  {"MEAN_ELEMENT_THEORY", Field::MeanElementTheory},
+	  {"TIME_SYSTEM", Field::TimeSystem},
+	  {"EPOCH", Field::Epoch},
+	  {"MEAN_MOTION", Field::MeanMotion},
+	  {"ECCENTRICITY", Field::Eccentricity},
+	  {"INCLINATION", Field::Inclination},
+	  {"RA_OF_ASC_NODE", Field::RaOfAscNode},
+	  {"ARG_OF_PERICENTER", Field::ArgOfPericenter},
+	  {"MEAN_ANOMALY", Field::MeanAnomaly},
+	  {"EPHEMERIS_TYPE", Field::EphemerisType},
+	  {"CLASSIFICATION_TYPE", Field::ClassificationType},
+	  {"NORAD_CAT_ID", Field::NoradCatId},
+	  {"ELEMENT_SET_NO", Field::ElementSetNo},
+	  {"REV_AT_EPOCH", Field::RevAtEpoch},
+	  {"BSTAR", Field::BStar},
+	  {"MEAN_MOTION_DOT", Field::MeanMotionDot},
+	  {"MEAN_MOTION_DDOT", Field::MeanMotionDdot},
+	};
+
+	// SGP4 の初期化に必要な要素
+	static constexpr std::uint32_t required_fields = (1u << static_cast<int>(Field::Epoch)) | (1u << static_cast<int>(Field::MeanMotion)) |
+													 (1u << static_cast<int>(Field::Eccentricity)) |
+													 (1u << static_cast<int>(Field::Inclination)) |
+													 (1u << static_cast<int>(Field::RaOfAscNode)) |
+													 (1u << static_cast<int>(Field::ArgOfPericenter)) |
+													 (1u << static_cast<int>(Field::MeanAnomaly));
+
+	static auto fieldOf(std::string_view key) -> Field {
+		for (const auto& name : field_names) {
+			if (name.key == key) {
+				return name.field;
+			}
+		}
+		return Field::Unknown;
+	}
+
+	static auto keyOf(Field field) -> std::string_view {
+		for (const auto& name : field_names) {
+			if (name.field == field) {
+				return name.key;
+			}
+		}
+		return {};
+	}
+
+	/**
+	 * @brief 1レコード分の値を受け取り OmmRecord を組み立てる
+	 *
+	 */
+	class RecordBuilder {
+	  public:
+		RecordBuilder() : m_line_number(0), m_seen(0), m_active(false) {}
+
+		auto active() const -> bool { return m_active; }
+
+		auto lineNumber() const -> std::size_t { return m_line_number; }
+
+		auto begin(std::size_t line_number) -> void {
+			m_record = OmmRecord();
+			m_line_number = line_number;
+			m_seen = 0;
+			m_active = true;
+			m_error.clear();
+		}
+
+		/**
+		 * @brief 値を設定する
+		 * @note 変換できない値はレコード全体を不正とし, 最初のエラーのみを保持する
+		 *
+		 * @param field 要素
+		 * @param value 値の文字列
+		 */
+		auto set(Field field, std::string_view value) -> void {
+			if (field == Field::Unknown || !m_error.empty()) {
+				return;
+			}
+			if (!assign(field, value)) {
+				m_error = "Invalid value for " + std::string(keyOf(field)) + ": " + std::string(value);
+				return;
+			}
+			m_seen |= 1u << static_cast<int>(field);
+		}
+
+		/**
+		 * @brief レコードを確定する
+		 *
+		 * @param record record(先頭行番号, レコード)
+		 * @param error error(先頭行番号, メッセージ)
+		 */
+		template <class RecordFunction, class ErrorFunction>
+		auto finish(RecordFunction& record, ErrorFunction& error) -> void {
+			if (!m_active) {
+				return;
+			}
+			m_active = false;
+
+			if (m_error.empty() && (m_seen & required_fields) != required_fields) {
+				m_error = "Missing required field:";
+				for (const auto& name : field_names) {
+					if ((required_fields & ~m_seen) & (1u << static_cast<int>(name.field))) {
+						m_error += ' ';
+						m_error += name.key;
+					}
+				}
+			}
+			if (m_error.empty() && !(m_record.eccentricity >= 0.0 && m_record.eccentricity < 1.0)) {
+				m_error = "Eccentricity out of range";
+			}
+			if (m_error.empty() && !(m_record.mean_motion > 0.0)) {
+				m_error = "Mean motion must be positive";
+			}
+
+			if (m_error.empty()) {
+				record(m_line_number, static_cast<const OmmRecord&>(m_record));
+			} else {
+				error(m_line_number, std::move(m_error));
+				m_error.clear();
+			}
+		}
+
+	  private:
+		OmmRecord m_record;		   // 組み立て中のレコード
+		std::size_t m_line_number; // レコード先頭の行番号
+		std::uint32_t m_seen;	   // 設定済みの要素
+		bool m_active;			   // レコードの途中か
+		std::string m_error;	   // 最初のエラー (エラーがない場合は空)
+
+		auto assign(Field field, std::string_view value) -> bool {
+			switch (field) {
+				case Field::ObjectName:
+					return assignText(m_record.object_name, value);
+				case Field::ObjectId:
+					return assignText(m_record.object_id, value);
+				case Field::MeanElementTheory:
+					return value == "SGP4" || value == "SGP/SGP4";
+				case Field::TimeSystem:
+					return value == "UTC";
+				case Field::Epoch:
+					try {
+						m_record.epoch = DateTime::parse(value);
+						return true;
+					} catch (const DateTimeException&) {
+						return false;
+					}
+				case Field::MeanMotion:
+					return toNumber(value, m_record.mean_motion);
+				case Field::Eccentricity:
+					return toNumber(value, m_record.eccentricity);
+				case Field::Inclination:
+					return toNumber(value, m_record.inclination);
+				case Field::RaOfAscNode:
+					return toNumber(value, m_record.ra_of_asc_node);
+				case Field::ArgOfPericenter:
+					return toNumber(value, m_record.arg_of_pericenter);
+				case Field::MeanAnomaly:
+					return toNumber(value, m_record.mean_anomaly);
+				case Field::EphemerisType:
+					return toNumber(value, m_record.ephemeris_type);
+				case Field::ClassificationType:
+					if (value.size() != 1) {
+						return false;
+					}
+					m_record.classification = value[0];
+					return true;
+				case Field::NoradCatId:
+					return toNumber(value, m_record.norad_cat_id) && m_record.norad_cat_id >= 0 &&
+						   m_record.norad_cat_id <= OmmRecord::max_norad_cat_id;
+				case Field::ElementSetNo:
+					return toNumber(value, m_record.element_set_no);
+				case Field::RevAtEpoch:
+					return toNumber(value, m_record.rev_at_epoch);
+				case Field::BStar:
+					return toNumber(value, m_record.b_star);
+				case Field::MeanMotionDot:
+					return toNumber(value, m_record.mean_motion_dot);
+				case Field::MeanMotionDdot:
+					return toNumber(value, m_record.mean_motion_ddot);
+				default:
+					return true;
+			}
+		}
+
+		/**
+		 * @brief 文字列を設定する
+		 * @note XML の定義済み実体参照 (&amp; など) を展開する
+		 *
+		 */
+		template <std::size_t N>
+		static auto assignText(FixedString<N>& dst, std::string_view value) -> bool {
+			char buf[N];
+			std::size_t n = 0;
+			for (std::size_t i = 0; i < value.size(); i++) {
+				char c = value[i];
+				if (c == '&') {
+					const std::string_view rest = value.substr(i);
+					std::size_t skip = 0;
+					for (const auto& [entity, ch] : entities) {
+						if (rest.substr(0, entity.size()) == entity) {
+							c = ch;
+							skip = entity.size() - 1;
+							break;
+						}
+					}
+					i += skip;
+				}
+				if (n == N) {
+					return false;
+				}
+				buf[n++] = c;
+			}
+			dst.assign(std::string_view(buf, n));
+			return true;
+		}
+
+		struct Entity {
+			std::string_view name;
+			char value;
+		};
+
+		static constexpr Entity entities[] = {{"&amp;", '&'}, {"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&apos;", '\''}};
+
+		template <class T>
+		static auto toNumber(std::string_view str, T& value) -> bool {
+			if (!str.empty() && str[0] == '+') {
+				str.remove_prefix(1);
+			}
+			const char* last = str.data() + str.size();
+			const auto [ptr, ec] = std::from_chars(str.data(), last, value);
+			return ec == std::errc() && ptr == last;
+		}
+	};
+
+	/**
+	 * @brief 行ごとに関数を呼び出す
+	 *
+	 * @param text 内容
+	 * @param line line(行番号, 前後の空白を除いた行)
+	 */
+	template <class LineFunction>
+	static auto forEachLine(std::string_view text, LineFunction&& line) -> void {
+		std::size_t line_number = 0;
+		std::size_t pos = 0;
+		while (pos < text.size()) {
+			const char* begin = text.data() + pos;
+			const char* newline = static_cast<const char*>(std::memchr(begin, '\n', text.size() - pos));
+			const std::size_t length = newline != nullptr ? static_cast<std::size_t>(newline - begin) : text.size() - pos;
+			pos += length + 1;
+			line_number++;
+
+			const std::string_view str = trim(std::string_view(begin, length));
+			if (!str.empty()) {
+				line(line_number, str);
+			}
+		}
+	}
+
+	/**
+	 * @brief KVN 形式を解析する
+	 * @note CCSDS_OMM_VERS の行でレコードを区切る. 値の後ろの単位 ([deg] など) と COMMENT 行は無視する
+	 *
+	 */
+	template <class RecordFunction, class ErrorFunction>
+	static auto parseKvn(std::string_view text, RecordFunction& record, ErrorFunction& error) -> void {
+		RecordBuilder builder;
+		forEachLine(text, [&](std::size_t line_number, std::string_view line) {
+			if (line.substr(0, 7) == "COMMENT") {
+				return;
+			}
+			const std::size_t eq = line.find('=');
+			if (eq == std::string_view::npos) {
+				builder.finish(record, error);
+				error(line_number, "Invalid KVN line: " + std::string(line));
+				return;
+			}
+			const std::string_view key = trim(line.substr(0, eq));
+			std::string_view value = trim(line.substr(eq + 1));
+			if (!value.empty() && value.back() == ']') {
+				const std::size_t bracket = value.rfind('[');
+				if (bracket != std::string_view::npos) {
+					value = trim(value.substr(0, bracket));
+				}
+			}
+
+			if (key == "CCSDS_OMM_VERS") {
+				builder.finish(record, error);
+				builder.begin(line_number);
+				return;
+			}
+			const Field field = fieldOf(key);
+			if (field == Field::Unknown) {
+				return;
+			}
+			if (!builder.active()) {
+				builder.begin(line_number);
+			}
+			builder.set(field, value);
+		});
+		builder.finish(record, error);
+	}
+
+	/**
+	 * @brief CSV 形式を解析する
+	 * @note 最初の行を見出し行として列と要素を対応付け, 以降の1行を1レコードとする. 二重引用符で囲んだ値はそのまま取り出す
+	 *
+	 */
+	template <class RecordFunction, class ErrorFunction>
+	static auto parseCsv(std::string_view text, RecordFunction& record, ErrorFunction& error) -> void {
+		std::vector<Field> columns;
+		bool has_header = false;
+		RecordBuilder builder;
+
+		forEachLine(text, [&](std::size_t line_number, std::string_view line) {
+			if (!has_header) {
+				forEachCsvField(line, [&](std::string_view key) { columns.push_back(fieldOf(key)); });
+				has_header = true;
+				return;
+			}
+
+			builder.begin(line_number);
+			std::size_t column = 0;
+			forEachCsvField(line, [&](std::string_view value) {
+				if (column < columns.size() && !value.empty()) {
+					builder.set(columns[column], value);
+				}
+				column++;
+			});
+			builder.finish(record, error);
+		});
+	}
+
+	template <class FieldFunction>
+	static auto forEachCsvField(std::string_view line, FieldFunction&& field) -> void {
+		std::size_t pos = 0;
+		while (pos <= line.size()) {
+			std::string_view value;
+			if (pos < line.size() && line[pos] == '"') {
+				const std::size_t close = line.find('"', pos + 1);
+				const std::size_t end = close != std::string_view::npos ? close : line.size();
+				value = line.substr(pos + 1, end - pos - 1);
+				pos = line.find(',', end);
+			} else {
+				const std::size_t comma = line.find(',', pos);
+				value = trim(line.substr(pos, comma - pos));
+				pos = comma;
+			}
+			field(value);
+			if (pos == std::string_view::npos) {
+				break;
+			}
+			pos++;
+		}
+	}
+
+	/**
+	 * @brief XML 形式を解析する
+	 * @note omm 要素でレコードを区切り, その内側の要素名が OMM のキーワードと一致する要素の内容を値とする. 木構造は構築しない
+	 *
+	 */
+	template <class RecordFunction, class ErrorFunction>
+	static auto parseXml(std::string_view text, RecordFunction& record, ErrorFunction& error) -> void {
+		RecordBuilder builder;
+		std::size_t line_number = 1;
+		std::size_t counted = 0; // line_number を数え終えた位置
+		const auto lineAt = [&](std::size_t offset) {
+			line_number += static_cast<std::size_t>(std::count(text.data() + counted, text.data() + offset, '\n'));
+			counted = offset;
+			return line_number;
+		};
+
+		std::size_t pos = 0;
+		while (pos < text.size()) {
+			const char* lt = static_cast<const char*>(std::memchr(text.data() + pos, '<', text.size() - pos));
+			if (lt == nullptr) {
+				break;
+			}
+			const std::size_t tag = static_cast<std::size_t>(lt - text.data());
+
+			if (text.substr(tag, 4) == "<!--") {
+				const std::size_t end = text.find("-->", tag + 4);
+				pos = end != std::string_view::npos ? end + 3 : text.size();
+				continue;
+			}
+
+			const std::size_t gt = text.find('>', tag + 1);
+			if (gt == std::string_view::npos) {
+				break;
+			}
+			pos = gt + 1;
+
+			const bool closing = text[tag + 1] == '/';
+			const std::size_t name_begin = tag + (closing ? 2 : 1);
+			const std::size_t name_end = std::min(text.find_first_of(" \t\r\n/>", name_begin), gt);
+			const std::string_view name = text.substr(name_begin, name_end - name_begin);
+			if (name.empty() || name[0] == '?' || name[0] == '!') {
+				continue;
+			}
+
+			if (name == "omm") {
+				builder.finish(record, error);
+				if (!closing) {
+					builder.begin(lineAt(tag));
+				}
+				continue;
+			}
+			if (closing || text[gt - 1] == '/' || !builder.active()) {
+				continue;
+			}
+
+			const Field field = fieldOf(name);
+			if (field == Field::Unknown) {
+				continue;
+			}
+			const std::size_t end = text.find('<', pos);
+			const std::size_t value_end = end != std::string_view::npos ? end : text.size();
+			builder.set(field, trim(text.substr(pos, value_end - pos)));
+			pos = value_end;
+		}
+		builder.finish(record, error);
+	}
+
+	static auto trim(std::string_view str) -> std::string_view {
+		std::size_t first = 0;
+		std::size_t last = str.size();
+		while (first < last && (str[first] == ' ' || str[first] == '\t' || str[first] == '\r' || str[first] == '\n')) first++;
+		while (last > first && (str[last - 1] == ' ' || str[last - 1] == '\t' || str[last - 1] == '\r' || str[last - 1] == '\n')) last--;
+		return str.substr(first, last - first);
+	}
+};
+
+SATFIND_NAMESPACE_END
@@ -0,0 +1,12 @@
+/**
+ * @file OrbitalElements.cpp
+ * @author fugu133
+ * @brief ケプラー軌道要素と位置・速度の相互変換 (satfind ライブラリ)
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "OrbitalElementsImpl.hpp"
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "AngleHelper.hpp"
+#include "Coordinate.hpp"
 #include "DateTime.hpp"
 #include "Eigen/Geometry"
 #include "Essential.hpp"
@@ -53,20 +54,42 @@ struct OrbitalElements {
 
 	OrbitalElements(const Tle& tle) : OrbitalElements() { fromTle(tle); }
 
+	/**
+	 * @brief 平均要素から軌道要素を構築する
+	 * @note TLE を経由せずに, CCSDS OMM などで配布される SGP4 平均要素から直接構築する. 単位は TLE の各要素と同じ
+	 *
+	 * @param epoch 元期
+	 * @param mean_motion 平均運動 [rev/day]
+	 * @param eccentricity 離心率
+	 * @param inclination 軌道傾斜角 [deg]
+	 * @param ascending_node 昇交点赤経 [deg]
+	 * @param argument_perigee 近地点引数 [deg]
+	 * @param mean_anomaly 平均近点角 [deg]
+	 * @param b_star B* 抗力項 [1/earth radii]
+	 * @return OrbitalElements 軌道要素
+	 */
+	static auto fromMeanElements(const DateTime& epoch, double mean_motion, double eccentricity, double inclination, double ascending_node,
+								 double argument_perigee, double mean_anomaly, double b_star) -> OrbitalElements {
+		OrbitalElements e;
+		e.mean_anomaly = AngleHelper::degreeToRadian(mean_anomaly);
+		e.ascending_node = AngleHelper::degreeToRadian(ascending_node);
+		e.argument_perigee = AngleHelper::degreeToRadian(argument_perigee);
+		e.eccentricity = eccentricity;
+		e.inclination = AngleHelper::degreeToRadian(inclination);
+		e.mean_motion = mean_motion * constant::pi2 / constant::minutes_per_day;
+		e.b_star = b_star;
+		e.epoch = epoch;
+		e.recover();
+		return e;
+	}
+
   private:
 	void fromTle(const Tle& tle) {
-		// TLEから抽出
-		{
-			mean_anomaly = AngleHelper::degreeToRadian(tle.meanAnomaly());
-			ascending_node = AngleHelper::degreeToRadian(tle.rightAscendingNode());
-			argument_perigee = AngleHelper::degreeToRadian(tle.argumentPerigee());
-			eccentricity = tle.eccentricity();
-			inclination = AngleHelper::degreeToRadian(tle.inclination());
-			mean_motion = tle.meanMotion() * constant::pi2 / constant::minutes_per_day;
-			b_star = tle.bStar();
-			epoch = tle.epoch();
-		}
-		
+		*this = fromMeanElements(tle.epoch(), tle.meanMotion(), tle.eccentricity(), tle.inclination(), tle.rightAscendingNode(),
+								 tle.argumentPerigee(), tle.meanAnomaly(), tle.bStar());
+	}
+
+	void recover() {
 		// original mean motion (xnodp), semimajor axis (aodp)
 		const double a1 = std::pow(constant::xke / mean_motion, constant::tow_third);
 		const double cosio = std::cos(inclination);
@@ -87,6 +110,18 @@ struct OrbitalElements {
 	}
 };
 
+/**
+ * @brief 時刻付きの位置・速度
+ * @note 一括計算用の軽量な型. 座標系は計算した関数に従う
+ */
+struct StateVector {
+	std::int64_t ticks;		  // 時刻 [ticks]
+	Eigen::Vector3d position; // [m]
+	Eigen::Vector3d velocity; // [m/s]
+
+	auto epoch() const -> DateTime { return DateTime(ticks); }
+};
+
 struct KeplerianOrbitalElements {
 	DateTime epoch;
 	double semi_major_axis;
@@ -157,107 +192,8 @@ struct CartesianOrbitalElements {
 	}
 };
 
-void KeplerianOrbitalElements::fromCartesianOrbitalElements(const CartesianOrbitalElements& e) {
-	*this = e.toKeplerianOrbitalElements();
-}
-
-CartesianOrbitalElements KeplerianOrbitalElements::toCartesianOrbitalElements() const {
-	CartesianOrbitalElements c_e;
-
-	// Calculate the eccentric anomaly from Kepler equation
-	double E0 = mean_anomaly.radians() + eccentricity * sin(mean_anomaly.radians());
-	double E = 0;
-	double delta_E = 1e3;
-	for (int i = 0; i < 10 || std::abs(delta_E) > 1e-15; i++) {
-		delta_E = (E0 - eccentricity * sin(E0) - mean_anomaly.radians()) / (1 - eccentricity * std::cos(E0));
-		E = E0 - delta_E;
-		E0 = E;
-	}
-
-	// Calculate the position in the perifocal frame
-	Eigen::Vector3d r_pqw = Eigen::Vector3d::Zero();
-	r_pqw.x() = semi_major_axis * (std::cos(E) - eccentricity);
-	r_pqw.y() = semi_major_axis * std::sqrt(1.0 - eccentricity * eccentricity) * std::sin(E);
-
-	// Calculate the velocity in the perifocal frame
-	const double c = std::sqrt(constant::mu * 1e9 / semi_major_axis) / (1 - eccentricity * std::cos(E));
-	Eigen::Vector3d v_pqw = Eigen::Vector3d::Zero();
-	v_pqw.x() = -c * std::sin(E);
-	v_pqw.y() = c * std::sqrt(1.0 - eccentricity * eccentricity) * std::cos(E);
-
-	// Calculate the rotation matrix from the perifocal frame to the ECI frame
-	Eigen::Matrix3d R_pqw_to_eci = Eigen::Matrix3d::Zero();
-	const double cos_raan = right_ascension_of_ascending_node.cos();
-	const double sin_raan = right_ascension_of_ascending_node.sin();
-	const double cos_arg_per = argument_of_perigee.cos();
-	const double sin_arg_per = argument_of_perigee.sin();
-	const double cos_incl = inclination.cos();
-	const double sin_incl = inclination.sin();
-	R_pqw_to_eci(0, 0) = cos_raan * cos_arg_per - sin_raan * sin_arg_per * cos_incl;
-	R_pqw_to_eci(0, 1) = -cos_raan * sin_arg_per - sin_raan * cos_arg_per * cos_incl;
-	R_pqw_to_eci(0, 2) = sin_raan * sin_incl;
-	R_pqw_to_eci(1, 0) = sin_raan * cos_arg_per + cos_raan * sin_arg_per * cos_incl;
-	R_pqw_to_eci(1, 1) = -sin_raan * sin_arg_per + cos_raan * cos_arg_per * cos_incl;
-	R_pqw_to_eci(1, 2) = -cos_raan * sin_incl;
-	R_pqw_to_eci(2, 0) = sin_arg_per * sin_incl;
-	R_pqw_to_eci(2, 1) = cos_arg_per * sin_incl;
-	R_pqw_to_eci(2, 2) = cos_incl;
-
-	// Copy the epoch
-	c_e.epoch = epoch;
-
-	// Conversion position to the ECI frame
-	c_e.position = Eci(epoch, R_pqw_to_eci * r_pqw);
-
-	// Conversion velocity to the ECI frame
-	c_e.velocity = Eci(epoch, R_pqw_to_eci * v_pqw);
-
-	return c_e;
-}
-
-void CartesianOrbitalElements::fromKeplerianOrbitalElements(const KeplerianOrbitalElements& e) {
-	*this = e.toCartesianOrbitalElements();
-}
-
-KeplerianOrbitalElements CartesianOrbitalElements::toKeplerianOrbitalElements() const {
-	KeplerianOrbitalElements k_e;
-	k_e.epoch = epoch;													// epoch
-	Eigen::Vector3d h = position.elements().cross(velocity.elements()); // orbital momentum vector [m^2/s]
-	Eigen::Vector3d n(-h.y(), h.x(), 0);								// node line vector [m^2/s]
-	Eigen::Vector3d e = velocity.elements().cross(h) / (constant::mu * 1e9) - position.elements().normalized(); // eccentricity vector
-	k_e.eccentricity = e.norm();
-	k_e.inclination = Radian{acos(h.z() / h.norm())}; // inclination [rad]
-
-	k_e.true_anomaly = Radian{acos(e.dot(position.elements()) / (e.norm() * position.elements().norm()))}; // true anomaly [rad]
-	if (position.elements().dot(velocity.elements()) < 0) {
-		k_e.true_anomaly = Radian{constant::pi2} - k_e.true_anomaly;
-	}
-
-	k_e.argument_of_latitude =
-	  Radian{acos(n.dot(position.elements()) / (n.norm() * position.elements().norm()))}; // argument of latitude [rad]
-	if (position.z() < 0) {
-		k_e.argument_of_latitude = Radian{constant::pi2} - k_e.argument_of_latitude;
-	}
-
-	double E =
-	  2 * atan(sqrt((1 - k_e.eccentricity) / (1 + k_e.eccentricity)) * tan(k_e.true_anomaly.radians() / 2)); // eccentric anomaly [rad]
-	k_e.mean_anomaly = Radian{AngleHelper::wrapRadian(E - k_e.eccentricity * sin(E))};						 // mean anomaly [rad]
-
-	k_e.argument_of_perigee = Radian{acos(n.dot(e) / (n.norm() * e.norm()))}; // argument of perigee [rad]
-	if (e.z() < 0) {
-		k_e.argument_of_perigee = Radian{constant::pi2} - k_e.argument_of_perigee;
-	}
-
-	k_e.right_ascension_of_ascending_node = Radian{acos(n.x() / n.norm())}; // right ascension of ascending node [rad]
-	if (n.y() < 0) {
-		k_e.right_ascension_of_ascending_node = Radian{constant::pi2} - k_e.right_ascension_of_ascending_node;
-	}
-
-	k_e.semi_major_axis = pow(h.norm(), 2) / (constant::mu * 1e9 * (1 - pow(k_e.eccentricity, 2))); // semi-major axis [m]
-
-	k_e.mean_motion = Radian{sqrt(constant::mu * 1e9 / pow(k_e.semi_major_axis, 3))}; // mean motion [rad/s]
-
-	return k_e;
-}
+SATFIND_NAMESPACE_END
 
-SATFIND_NAMESPACE_END
\ No newline at end of file
+#if defined(SATFIND_HEADER_ONLY)
+#include "OrbitalElementsImpl.hpp"
+#endif
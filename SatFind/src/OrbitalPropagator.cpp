@@ -0,0 +1,12 @@
+/**
+ * @file OrbitalPropagator.cpp
+ * @author fugu133
+ * @brief SGP4/SDP4 の初期化と伝搬 (satfind ライブラリ)
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "OrbitalPropagatorImpl.hpp"
@@ -0,0 +1,507 @@
+/**
+ * @file PreciseFrame.hpp
+ * @author fugu133
+ * @brief TEME から ITRF/GCRF への精密座標変換
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "AngleHelper.hpp"
+#include "Coordinate.hpp"
+#include "DateTime.hpp"
+#include "EarthOrientation.hpp"
+#include "Eigen/Geometry"
+#include "Essential.hpp"
+#include "Executor.hpp"
+#include "OrbitalElements.hpp"
+#include "Polynomial.hpp"
+#include "TimeGrid.hpp"
+#include "TimeScale.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+class Itrf : public CoordinateBase<Eigen::Vector3d> {
+  public:
+	Itrf() : CoordinateBase(DateTime::now(), Eigen::Vector3d::Zero(), CoordinateType::Itrf) {}
+	Itrf(const DateTime& dt, const Eigen::Vector3d& d) : CoordinateBase(dt, d, CoordinateType::Itrf) {}
+	Itrf(const DateTime& dt, double x, double y, double z) : CoordinateBase(dt, Eigen::Vector3d{x, y, z}, CoordinateType::Itrf) {}
+
+	const double& x() const { return m_data.x(); }
+	const double& y() const { return m_data.y(); }
+	const double& z() const { return m_data.z(); }
+
+	Ecef toEcef() const { return Ecef(m_epoch, m_data); }
+	Wgs84 toWgs84() const { return toEcef().toWgs84(); }
+
+	std::string toString() const override {
+		std::stringstream ss;
+		ss << "ITRF(t = " << m_epoch.toString() << ", x = " << m_data.x() << " [m], y = " << m_data.y() << " [m], z = " << m_data.z()
+		   << " [m])";
+		return ss.str();
+	}
+
+	friend auto operator<<(std::ostream& os, const Itrf& itrf) -> std::ostream& {
+		os << itrf.toString();
+		return os;
+	}
+};
+
+class Gcrf : public CoordinateBase<Eigen::Vector3d> {
+  public:
+	Gcrf() : CoordinateBase(DateTime::now(), Eigen::Vector3d::Zero(), CoordinateType::Gcrf) {}
+	Gcrf(const DateTime& dt, const Eigen::Vector3d& d) : CoordinateBase(dt, d, CoordinateType::Gcrf) {}
+	Gcrf(const DateTime& dt, double x, double y, double z) : CoordinateBase(dt, Eigen::Vector3d{x, y, z}, CoordinateType::Gcrf) {}
+
+	const double& x() const { return m_data.x(); }
+	const double& y() const { return m_data.y(); }
+	const double& z() const { return m_data.z(); }
+
+	std::string toString() const override {
+		std::stringstream ss;
+		ss << "GCRF(t = " << m_epoch.toString() << ", x = " << m_data.x() << " [m], y = " << m_data.y() << " [m], z = " << m_data.z()
+		   << " [m])";
+		return ss.str();
+	}
+
+	friend auto operator<<(std::ostream& os, const Gcrf& gcrf) -> std::ostream& {
+		os << gcrf.toString();
+		return os;
+	}
+};
+
+/**
+ * @brief 精密座標系での位置・速度
+ *
+ * @tparam Frame 座標系
+ */
+template <class Frame>
+struct FrameState {
+	DateTime epoch;
+	Frame position; // [m]
+	Frame velocity; // [m/s]
+};
+
+using ItrfState = FrameState<Itrf>;
+using GcrfState = FrameState<Gcrf>;
+
+/**
+ * @brief ある時刻における TEME → ITRF/GCRF の回転
+ * @ref Vallado, D. A., et al., Revisiting Spacetrack Report #3, AIAA 2006-6753, 2006.
+ * @remark 章動は IAU1980 理論の主要30項で打ち切る (打ち切り誤差は 0.01 秒角程度)
+ */
+struct FrameRotation {
+	DateTime epoch;				   // 時刻 (UTC)
+	Eigen::Matrix3d teme_to_gcrf;  // TEME → GCRF (歳差・章動・分点差)
+	Eigen::Matrix3d pef_to_itrf;   // PEF → ITRF (極運動)
+	double ut1_utc;				   // UT1-UTC [s]
+	double earth_rotation_rate;	   // 地球自転角速度 [rad/s]
+
+	/**
+	 * @brief 指定した時刻の回転を計算する
+	 *
+	 * @param utc 時刻 (UTC)
+	 * @param eop 時刻での地球姿勢パラメータ
+	 * @return FrameRotation
+	 */
+	static auto compute(const DateTime& utc, const EopRecord& eop) -> FrameRotation {
+		FrameRotation ret;
+		ret.epoch = utc;
+		ret.ut1_utc = eop.ut1_utc;
+		ret.earth_rotation_rate = earth_angular_velocity * (1.0 - eop.lod / (1000.0 * constant::seconds_per_day));
+
+		const double xp = AngleHelper::arcsecToRadian(eop.x_pole);
+		const double yp = AngleHelper::arcsecToRadian(eop.y_pole);
+		ret.pef_to_itrf = rotX(-yp) * rotY(-xp);
+
+		// 歳差・章動は TT で評価する
+		const double T = Instant(utc, TimeScale::UTC).to(TimeScale::TT).dateTime().j2000() / constant::jd_century;
+
+		const double zeta = AngleHelper::arcsecToRadian(Polynomial::deg3(T, 0.0, 2306.2181, 0.30188, 0.017998));
+		const double theta = AngleHelper::arcsecToRadian(Polynomial::deg3(T, 0.0, 2004.3109, -0.42665, -0.041833));
+		const double z = AngleHelper::arcsecToRadian(Polynomial::deg3(T, 0.0, 2306.2181, 1.09468, 0.018203));
+
+		double dpsi = 0.0;
+		double deps = 0.0;
+		const double mean_eps = meanObliquity(T);
+		nutation(T, dpsi, deps);
+		dpsi += AngleHelper::arcsecToRadian(eop.dpsi / 1000.0);
+		deps += AngleHelper::arcsecToRadian(eop.deps / 1000.0);
+		const double true_eps = mean_eps + deps;
+
+		// TEMEの分点差には運動学項を含めない
+		const double eqe = dpsi * std::cos(mean_eps);
+
+		const Eigen::Matrix3d precession = rotZ(-z) * rotY(theta) * rotZ(-zeta); // J2000 → MOD
+		const Eigen::Matrix3d nut = rotX(-true_eps) * rotZ(-dpsi) * rotX(mean_eps);	 // MOD → TOD
+		ret.teme_to_gcrf = precession.transpose() * nut.transpose() * rotZ(-eqe);
+
+		return ret;
+	}
+
+	/**
+	 * @brief グリニッジ平均恒星時 (UT1) を取得する
+	 *
+	 * @return double グリニッジ平均恒星時 [rad]
+	 */
+	auto gmst() const -> double { return (epoch + Seconds(ut1_utc)).greenwichSiderealTime().radians(); }
+
+	/**
+	 * @brief TEME → PEF の回転行列を取得する
+	 *
+	 */
+	auto temeToPef() const -> Eigen::Matrix3d { return rotZ(gmst()); }
+
+	/**
+	 * @brief TEME → ITRF の回転行列を取得する
+	 *
+	 */
+	auto temeToItrf() const -> Eigen::Matrix3d { return pef_to_itrf * temeToPef(); }
+
+	auto toPef(const Eci& teme) const -> Ecef { return Ecef(teme.epoch(), temeToPef() * teme.elements()); }
+
+	auto toItrf(const Eci& teme) const -> Itrf { return Itrf(teme.epoch(), temeToItrf() * teme.elements()); }
+
+	auto toGcrf(const Eci& teme) const -> Gcrf { return Gcrf(teme.epoch(), teme_to_gcrf * teme.elements()); }
+
+	/**
+	 * @brief TEMEの位置・速度をITRFに変換する
+	 *
+	 * @param r_teme TEME位置 [m]
+	 * @param v_teme TEME速度 [m/s]
+	 * @param r_itrf ITRF位置 [m]
+	 * @param v_itrf ITRF速度 [m/s]
+	 */
+	auto applyTemeToItrf(const Eigen::Vector3d& r_teme, const Eigen::Vector3d& v_teme, Eigen::Vector3d& r_itrf,
+						 Eigen::Vector3d& v_itrf) const -> void {
+		applyTemeToItrf(r_teme, v_teme, gmst(), r_itrf, v_itrf);
+	}
+
+	/**
+	 * @brief 計算済みの恒星時を用いてTEMEの位置・速度をITRFに変換する
+	 *
+	 * @param r_teme TEME位置 [m]
+	 * @param v_teme TEME速度 [m/s]
+	 * @param gmst グリニッジ平均恒星時 (UT1) [rad]
+	 * @param r_itrf ITRF位置 [m]
+	 * @param v_itrf ITRF速度 [m/s]
+	 */
+	auto applyTemeToItrf(const Eigen::Vector3d& r_teme, const Eigen::Vector3d& v_teme, double gmst, Eigen::Vector3d& r_itrf,
+						 Eigen::Vector3d& v_itrf) const -> void {
+		const Eigen::Matrix3d st = rotZ(gmst);
+		const Eigen::Vector3d r_pef = st * r_teme;
+		const Eigen::Vector3d v_pef = st * v_teme - Eigen::Vector3d(0.0, 0.0, earth_rotation_rate).cross(r_pef);
+		r_itrf = pef_to_itrf * r_pef;
+		v_itrf = pef_to_itrf * v_pef;
+	}
+
+	auto toItrf(const Eci& r_teme, const Eci& v_teme) const -> ItrfState {
+		Eigen::Vector3d r, v;
+		applyTemeToItrf(r_teme.elements(), v_teme.elements(), r, v);
+		return ItrfState{r_teme.epoch(), Itrf(r_teme.epoch(), r), Itrf(r_teme.epoch(), v)};
+	}
+
+	auto toGcrf(const Eci& r_teme, const Eci& v_teme) const -> GcrfState {
+		return GcrfState{r_teme.epoch(), toGcrf(r_teme), toGcrf(v_teme)};
+	}
+
+	/**
+	 * @brief 平均黄道傾斜角 (IAU1980) を取得する
+	 *
+	 * @param T J2000.0からのユリウス世紀 (TT)
+	 * @return double 平均黄道傾斜角 [rad]
+	 */
+	static auto meanObliquity(double T) -> double {
+		return AngleHelper::arcsecToRadian(Polynomial::deg3(T, 84381.448, -46.8150, -0.00059, 0.001813));
+	}
+
+	/**
+	 * @brief IAU1980 章動 (主要項) を計算する
+	 * @ref Meeus, Jean, Astronomical Algorithms (2nd Ed.). Richmond: Willmann-Bell, Inc., 2009, Ch. 22.
+	 *
+	 * @param T J2000.0からのユリウス世紀 (TT)
+	 * @param dpsi 黄経の章動 Δψ [rad]
+	 * @param deps 黄道傾斜の章動 Δε [rad]
+	 * @return double 月の昇交点黄経 Ω [rad]
+	 */
+	static auto nutation(double T, double& dpsi, double& deps) -> double {
+		const double D = AngleHelper::degreeToWrapRadian(Polynomial::deg3(T, 297.85036, 445267.111480, -0.0019142, 1.0 / 189474.0));
+		const double M = AngleHelper::degreeToWrapRadian(Polynomial::deg3(T, 357.52772, 35999.050340, -0.0001603, -1.0 / 300000.0));
+		const double Mp = AngleHelper::degreeToWrapRadian(Polynomial::deg3(T, 134.96298, 477198.867398, 0.0086972, 1.0 / 56250.0));
+		const double F = AngleHelper::degreeToWrapRadian(Polynomial::deg3(T, 93.27191, 483202.017538, -0.0036825, 1.0 / 327270.0));
+		const double Omega = AngleHelper::degreeToWrapRadian(Polynomial::deg3(T, 125.04452, -1934.136261, 0.0020708, 1.0 / 450000.0));
+
+		double sum_psi = 0.0;
+		double sum_eps = 0.0;
+		for (const auto& term : nutation_terms) {
+			const double arg = term.d * D + term.m * M + term.mp * Mp + term.f * F + term.omega * Omega;
+			sum_psi += (term.psi + term.psi_t * T) * std::sin(arg);
+			sum_eps += (term.eps + term.eps_t * T) * std::cos(arg);
+		}
+
+		dpsi = AngleHelper::arcsecToRadian(sum_psi * 1.0e-4);
+		deps = AngleHelper::arcsecToRadian(sum_eps * 1.0e-4);
+		return Omega;
+	}
+
+	/**
+	 * @brief x軸回りの座標回転行列
+	 *
+	 */
+	static auto rotX(double a) -> Eigen::Matrix3d { return Eigen::AngleAxisd(-a, Eigen::Vector3d::UnitX()).toRotationMatrix(); }
+
+	/**
+	 * @brief y軸回りの座標回転行列
+	 *
+	 */
+	static auto rotY(double a) -> Eigen::Matrix3d { return Eigen::AngleAxisd(-a, Eigen::Vector3d::UnitY()).toRotationMatrix(); }
+
+	/**
+	 * @brief z軸回りの座標回転行列
+	 *
+	 */
+	static auto rotZ(double a) -> Eigen::Matrix3d { return Eigen::AngleAxisd(-a, Eigen::Vector3d::UnitZ()).toRotationMatrix(); }
+
+  private:
+	static constexpr double earth_angular_velocity = 7.292115146706979e-5; // 地球自転角速度 [rad/s]
+
+	struct NutationTerm {
+		int d, m, mp, f, omega; // 引数の係数 (D, M, M', F, Ω)
+		double psi, psi_t;		// Δψ の係数 [0.0001 arcsec]
+		double eps, eps_t;		// Δε の係数 [0.0001 arcsec]
+	};
+
+	static constexpr NutationTerm nutation_terms[] = {
+	  {0, 0, 0, 0, 1, -171996, -174.2, 92025, 8.9},
+	  {-2, 0, 0, 2, 2, -13187, -1.6, 5736, -3.1},
+	  {0, 0, 0, 2, 2, -2274, -0.2, 977, -0.5},
+	  {0, 0, 0, 0, 2, 2062, 0.2, -895, 0.5},
+	  {0, 1, 0, 0, 0, 1426, -3.4, 54, -0.1},
+	  {0, 0, 1, 0, 0, 712, 0.1, -7, 0.0},
+	  {-2, 1, 0, 2, 2, -517, 1.2, 224, -0.6},
+	  {0, 0, 0, 2, 1, -386, -0.4, 200, 0.0},
+	  {0, 0, 1, 2, 2, -301, 0.0, 129, -0.1},
+	  {-2, -1, 0, 2, 2, 217, -0.5, -95, 0.3},
+	  {-2, 0, 1, 0, 0, -158, 0.0, 0, 0.0},
+	  {-2, 0, 0, 2, 1, 129, 0.1, -70, 0.0},
+	  {0, 0, -1, 2, 2, 123, 0.0, -53, 0.0},
+	  {2, 0, 0, 0, 0, 63, 0.0, 0, 0.0},
+	  {0, 0, 1, 0, 1, 63, 0.1, -33, 0.0},
+	  {2, 0, -1, 2, 2, -59, 0.0, 26, 0.0},
+	  {0, 0, -1, 0, 1, -58, -0.1, 32, 0.0},
+	  {0, 0, 1, 2, 1, -51, 0.0, 27, 0.0},
+	  {-2, 0, 2, 0, 0, 48, 0.0, 0, 0.0},
+	  {0, 0, -2, 2, 1, 46, 0.0, -24, 0.0},
+	  {2, 0, 0, 2, 2, -38, 0.0, 16, 0.0},
+	  {0, 0, 2, 2, 2, -31, 0.0, 13, 0.0},
+	  {0, 0, 2, 0, 0, 29, 0.0, 0, 0.0},
+	  {-2, 0, 1, 2, 2, 29, 0.0, -12, 0.0},
+	  {0, 0, 0, 2, 0, 26, 0.0, 0, 0.0},
+	  {-2, 0, 0, 2, 0, -22, 0.0, 0, 0.0},
+	  {0, 0, -1, 2, 1, 21, 0.0, -10, 0.0},
+	  {0, 2, 0, 0, 0, 17, -0.1, 0, 0.0},
+	  {2, 0, -1, 0, 1, 16, 0.0, -8, 0.0},
+	  {-2, 2, 0, 2, 2, -16, 0.1, 7, 0.0},
+	};
+};
+
+/**
+ * @brief 回転行列のキャッシュ
+ * @note 期間内を等間隔のノードで区切り, 歳差・章動・極運動の行列をノード間で線形補間する.
+ *       地球自転角 (GMST) とUT1-UTCは時刻ごとに評価するため, 精度はノード間隔にほとんど依存しない
+ */
+class FrameRotationCache {
+  public:
+	static constexpr std::size_t grid_grain = 1024; // 並列計算での時刻列の作業単位の時刻数
+
+	/**
+	 * @brief Construct a new Frame Rotation Cache object
+	 * @note 補間のためノードは開始時刻が終了時刻と等しい場合も2つ以上作る
+	 * @exception EarthOrientationException 終了時刻が開始時刻より前, またはノード間隔が正でない場合
+	 *
+	 * @param eop 地球姿勢パラメータ
+	 * @param begin 開始時刻 (UTC)
+	 * @param end 終了時刻 (UTC)
+	 * @param node_interval ノード間隔
+	 */
+	FrameRotationCache(const EarthOrientationParameters& eop, const DateTime& begin, const DateTime& end,
+					   const TimeSpan& node_interval = Hours(1))
+	  : m_eop(eop.slice(begin, end)), m_begin_ticks(begin.ticks()), m_step_ticks(node_interval.ticks()) {
+		if (m_step_ticks <= 0 || end < begin) {
+			throw EarthOrientationException("Invalid cache range", EarthOrientationException::OutOfRange);
+		}
+
+		const std::int64_t nodes = std::max<std::int64_t>((end.ticks() - begin.ticks() + m_step_ticks - 1) / m_step_ticks + 1, 2);
+		m_nodes.reserve(static_cast<std::size_t>(nodes));
+		for (std::int64_t i = 0; i < nodes; i++) {
+			const DateTime node(m_begin_ticks + i * m_step_ticks);
+			m_nodes.push_back(FrameRotation::compute(node, m_eop.at(node)));
+		}
+	}
+
+	/**
+	 * @brief 指定した時刻の回転を取得する
+	 * @remark キャッシュ範囲外の時刻は端のノードから外挿する
+	 *
+	 * @param utc 時刻 (UTC)
+	 * @return FrameRotation
+	 */
+	auto rotation(const DateTime& utc) const -> FrameRotation {
+		double w;
+		const std::size_t i = lowerNode(utc.ticks(), w);
+		const FrameRotation& a = m_nodes[i];
+		const FrameRotation& b = m_nodes[i + 1];
+
+		const EopRecord eop = m_eop.at(utc);
+
+		FrameRotation r;
+		r.epoch = utc;
+		r.teme_to_gcrf = a.teme_to_gcrf + w * (b.teme_to_gcrf - a.teme_to_gcrf);
+		r.pef_to_itrf = a.pef_to_itrf + w * (b.pef_to_itrf - a.pef_to_itrf);
+		r.ut1_utc = eop.ut1_utc;
+		r.earth_rotation_rate = a.earth_rotation_rate + w * (b.earth_rotation_rate - a.earth_rotation_rate);
+		return r;
+	}
+
+	auto toPef(const Eci& teme) const -> Ecef { return rotation(teme.epoch()).toPef(teme); }
+
+	auto toItrf(const Eci& teme) const -> Itrf { return rotation(teme.epoch()).toItrf(teme); }
+
+	auto toGcrf(const Eci& teme) const -> Gcrf { return rotation(teme.epoch()).toGcrf(teme); }
+
+	auto toItrf(const Eci& r_teme, const Eci& v_teme) const -> ItrfState { return rotation(r_teme.epoch()).toItrf(r_teme, v_teme); }
+
+	auto toGcrf(const Eci& r_teme, const Eci& v_teme) const -> GcrfState { return rotation(r_teme.epoch()).toGcrf(r_teme, v_teme); }
+
+	/**
+	 * @brief 時刻列の各時刻の位置・速度をTEMEからITRFに変換する
+	 * @note 恒星時は時刻列の計算済みの値 (UTC) にUT1-UTC分の回転を加えて求める
+	 *
+	 * @param grid 時刻列 (UTC)
+	 * @param teme 各時刻の位置・速度 (TEME)
+	 * @return std::vector<StateVector> 位置・速度 (ITRF)
+	 */
+	auto toItrf(const TimeGrid& grid, const std::vector<StateVector>& teme) const -> std::vector<StateVector> {
+		checkSize(grid, teme);
+		const auto& gmst = grid.greenwichSiderealTimes();
+
+		std::vector<StateVector> ret(teme.size());
+		toItrfRange(gmst, teme, 0, teme.size(), ret);
+		return ret;
+	}
+
+	/**
+	 * @brief 時刻列の各時刻の位置・速度をTEMEからGCRFに変換する
+	 *
+	 * @param grid 時刻列 (UTC)
+	 * @param teme 各時刻の位置・速度 (TEME)
+	 * @return std::vector<StateVector> 位置・速度 (GCRF)
+	 */
+	auto toGcrf(const TimeGrid& grid, const std::vector<StateVector>& teme) const -> std::vector<StateVector> {
+		checkSize(grid, teme);
+
+		std::vector<StateVector> ret(teme.size());
+		toGcrfRange(teme, 0, teme.size(), ret);
+		return ret;
+	}
+
+	/**
+	 * @brief 時刻列の各時刻の位置・速度をTEMEからITRFに並列に変換する
+	 * @note 時刻列を grid_grain 個ずつの区間に分けて実行器に渡す
+	 *
+	 * @param grid 時刻列 (UTC)
+	 * @param teme 各時刻の位置・速度 (TEME)
+	 * @param executor 実行器
+	 * @return std::vector<StateVector> 位置・速度 (ITRF)
+	 */
+	auto toItrf(const TimeGrid& grid, const std::vector<StateVector>& teme, Executor& executor) const -> std::vector<StateVector> {
+		checkSize(grid, teme);
+		const auto& gmst = grid.greenwichSiderealTimes();
+
+		std::vector<StateVector> ret(teme.size());
+		executor.parallelFor(teme.size(), grid_grain,
+							 [&](std::size_t begin, std::size_t end, std::size_t) { toItrfRange(gmst, teme, begin, end, ret); });
+		return ret;
+	}
+
+	/**
+	 * @brief 時刻列の各時刻の位置・速度をTEMEからGCRFに並列に変換する
+	 * @note 時刻列を grid_grain 個ずつの区間に分けて実行器に渡す
+	 *
+	 * @param grid 時刻列 (UTC)
+	 * @param teme 各時刻の位置・速度 (TEME)
+	 * @param executor 実行器
+	 * @return std::vector<StateVector> 位置・速度 (GCRF)
+	 */
+	auto toGcrf(const TimeGrid& grid, const std::vector<StateVector>& teme, Executor& executor) const -> std::vector<StateVector> {
+		checkSize(grid, teme);
+
+		std::vector<StateVector> ret(teme.size());
+		executor.parallelFor(teme.size(), grid_grain,
+							 [&](std::size_t begin, std::size_t end, std::size_t) { toGcrfRange(teme, begin, end, ret); });
+		return ret;
+	}
+
+	auto eop() const -> const EarthOrientationParameters& { return m_eop; }
+
+  private:
+	static constexpr double gmst_rate = 1.00273790935 * constant::pi2 / constant::seconds_per_day; // 恒星時の進み [rad/s (UT1)]
+
+	EarthOrientationParameters m_eop; // キャッシュ期間のEOP
+	std::int64_t m_begin_ticks;		  // 先頭ノードの時刻 [ticks]
+	std::int64_t m_step_ticks;		  // ノード間隔 [ticks]
+	std::vector<FrameRotation> m_nodes;
+
+	/**
+	 * @brief 指定した時刻を挟むノード番号と補間係数を求める
+	 *
+	 * @param ticks 時刻 [ticks]
+	 * @param w 補間係数
+	 * @return std::size_t 手前側のノード番号
+	 */
+	auto lowerNode(std::int64_t ticks, double& w) const -> std::size_t {
+		const std::int64_t offset = ticks - m_begin_ticks;
+		std::int64_t i = offset >= 0 ? offset / m_step_ticks : -1;
+		i = std::clamp<std::int64_t>(i, 0, static_cast<std::int64_t>(m_nodes.size()) - 2);
+		w = static_cast<double>(offset - i * m_step_ticks) / static_cast<double>(m_step_ticks);
+		return static_cast<std::size_t>(i);
+	}
+
+	auto interpolatedTemeToGcrf(std::int64_t ticks) const -> Eigen::Matrix3d {
+		double w;
+		const std::size_t i = lowerNode(ticks, w);
+		return m_nodes[i].teme_to_gcrf + w * (m_nodes[i + 1].teme_to_gcrf - m_nodes[i].teme_to_gcrf);
+	}
+
+	auto toItrfRange(const std::vector<double>& gmst, const std::vector<StateVector>& teme, std::size_t begin, std::size_t end,
+					 std::vector<StateVector>& itrf) const -> void {
+		for (std::size_t i = begin; i < end; i++) {
+			const FrameRotation r = rotation(teme[i].epoch());
+			itrf[i].ticks = teme[i].ticks;
+			r.applyTemeToItrf(teme[i].position, teme[i].velocity, gmst[i] + r.ut1_utc * gmst_rate, itrf[i].position, itrf[i].velocity);
+		}
+	}
+
+	auto toGcrfRange(const std::vector<StateVector>& teme, std::size_t begin, std::size_t end, std::vector<StateVector>& gcrf) const
+	  -> void {
+		for (std::size_t i = begin; i < end; i++) {
+			const Eigen::Matrix3d m = interpolatedTemeToGcrf(teme[i].ticks);
+			gcrf[i] = StateVector{teme[i].ticks, m * teme[i].position, m * teme[i].velocity};
+		}
+	}
+
+	static auto checkSize(const TimeGrid& grid, const std::vector<StateVector>& states) -> void {
+		if (states.size() != grid.size()) {
+			throw EarthOrientationException("Number of states does not match the time grid", EarthOrientationException::OutOfRange);
+		}
+	}
+};
+
+SATFIND_NAMESPACE_END
@@ -0,0 +1,733 @@
+/**
+ * @file SatelliteCatalog.hpp
+ * @author fugu133
+ * @brief カタログ番号・国際識別符号・名前で検索できる衛星カタログ
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Essential.hpp"
+#include "Executor.hpp"
+#include "FixedString.hpp"
+#include "OmmReader.hpp"
+#include "OrbitalPropagator.hpp"
+#include "TimeGrid.hpp"
+#include "Tle.hpp"
+#include "Tracing.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief 衛星カタログ
+ * @note 初期化済みの伝搬器を連続した領域に保持し, ハンドル (格納順の添字) で参照する. カタログ番号と国際識別符号は
+ *       オープンアドレス法のハッシュ表, 名前はトライグラム索引で検索する
+ * @remark ハンドルはカタログが破棄されるまで有効で, 同じカタログ番号の要素を追加した場合も変わらない
+ */
+class SatelliteCatalog {
+  public:
+	using Handle = std::uint32_t;
+
+	static constexpr Handle invalid_handle = std::numeric_limits<Handle>::max();
+	static constexpr std::size_t state_grain = 256; // 並列計算での同時刻の作業単位の衛星数
+	static constexpr std::size_t grid_block = 1440; // 並列計算での時刻列の作業単位の時刻数
+
+	/**
+	 * @brief 1衛星分の識別情報
+	 *
+	 */
+	struct Entry {
+		int catalog_number;			// カタログ番号
+		FixedString<64> name;		// 衛星名
+		FixedString<16> designator; // 国際識別符号 (TLE 形式, 例: 98067A)
+		DateTime epoch;				// 元期
+	};
+
+	SatelliteCatalog() = default;
+
+	/**
+	 * @brief Construct a new Satellite Catalog object
+	 * @note 伝搬器の初期化に失敗した要素 (OrbitException) は追加しない
+	 *
+	 * @param elements TLE
+	 */
+	explicit SatelliteCatalog(const std::vector<Tle>& elements) {
+		Tracing::Span span("catalog", "SatelliteCatalog::SatelliteCatalog", "elements", static_cast<std::int64_t>(elements.size()));
+		reserve(elements.size());
+		for (const auto& tle : elements) {
+			tryAdd(tle);
+		}
+	}
+
+	/**
+	 * @brief Construct a new Satellite Catalog object
+	 * @note 伝搬器の初期化に失敗した要素 (OrbitException) は追加しない
+	 *
+	 * @param records OMM レコード
+	 */
+	explicit SatelliteCatalog(const std::vector<OmmRecord>& records) {
+		Tracing::Span span("catalog", "SatelliteCatalog::SatelliteCatalog", "elements", static_cast<std::int64_t>(records.size()));
+		reserve(records.size());
+		for (const auto& record : records) {
+			tryAdd(record);
+		}
+	}
+
+	/**
+	 * @brief Construct a new Satellite Catalog object
+	 * @note 伝搬器の初期化を並列に行い, 要素の順に追加する. 初期化に失敗した要素 (OrbitException) は追加しない
+	 *
+	 * @param elements TLE
+	 * @param executor 実行器
+	 */
+	SatelliteCatalog(const std::vector<Tle>& elements, Executor& executor) {
+		Tracing::Span span("catalog", "SatelliteCatalog::SatelliteCatalog", "elements", static_cast<std::int64_t>(elements.size()));
+		addAll(elements, executor);
+	}
+
+	/**
+	 * @brief Construct a new Satellite Catalog object
+	 * @note 伝搬器の初期化を並列に行い, 要素の順に追加する. 初期化に失敗した要素 (OrbitException) は追加しない
+	 *
+	 * @param records OMM レコード
+	 * @param executor 実行器
+	 */
+	SatelliteCatalog(const std::vector<OmmRecord>& records, Executor& executor) {
+		Tracing::Span span("catalog", "SatelliteCatalog::SatelliteCatalog", "elements", static_cast<std::int64_t>(records.size()));
+		addAll(records, executor);
+	}
+
+	auto reserve(std::size_t n) -> void {
+		m_entries.reserve(n);
+		m_propagators.reserve(n);
+		m_catalog_index.reserve(n);
+		m_designator_index.reserve(n);
+		m_name_index.reserve(n);
+	}
+
+	/**
+	 * @brief 衛星を追加する
+	 * @note 同じカタログ番号の衛星がある場合は置き換え, 同じハンドルを返す
+	 * @exception OrbitException 伝搬器の初期化に失敗した場合
+	 *
+	 * @param tle TLE
+	 * @return Handle ハンドル
+	 */
+	auto add(const Tle& tle) -> Handle { return add(makeEntry(tle), OrbitalPropagator(tle)); }
+
+	/**
+	 * @brief 衛星を追加する
+	 * @note 同じカタログ番号の衛星がある場合は置き換え, 同じハンドルを返す
+	 * @exception OrbitException 伝搬器の初期化に失敗した場合
+	 *
+	 * @param record OMM レコード
+	 * @return Handle ハンドル
+	 */
+	auto add(const OmmRecord& record) -> Handle { return add(makeEntry(record), OrbitalPropagator(record.toOrbitalElements())); }
+
+	/**
+	 * @brief 衛星を追加する
+	 * @note 同じカタログ番号の衛星がある場合は置き換え, 同じハンドルを返す
+	 *
+	 * @param entry 識別情報
+	 * @param propagator 初期化済みの伝搬器
+	 * @return Handle ハンドル
+	 */
+	auto add(const Entry& entry, const OrbitalPropagator& propagator) -> Handle {
+		const Handle existing = find(entry.catalog_number);
+		if (existing != invalid_handle) {
+			Entry& old = m_entries[existing];
+			if (old.designator != entry.designator.view()) {
+				m_designator_index.erase(hashText(old.designator), existing);
+				m_designator_index.insert(hashText(entry.designator), existing);
+			}
+			if (old.name != entry.name.view()) {
+				m_name_index.erase(hashName(old.name), existing);
+				unindexName(existing);
+				old.name = entry.name;
+				indexName(existing);
+				m_name_index.insert(hashName(entry.name), existing);
+			}
+			old = entry;
+			m_propagators[existing] = propagator;
+			return existing;
+		}
+
+		if (m_entries.size() >= invalid_handle) {
+			throw std::length_error("SatelliteCatalog capacity exceeded");
+		}
+		const Handle handle = static_cast<Handle>(m_entries.size());
+		m_entries.push_back(entry);
+		m_propagators.push_back(propagator);
+		m_catalog_index.insert(hashNumber(entry.catalog_number), handle);
+		m_designator_index.insert(hashText(entry.designator), handle);
+		m_name_index.insert(hashName(entry.name), handle);
+		indexName(handle);
+		return handle;
+	}
+
+	auto size() const -> std::size_t { return m_entries.size(); }
+
+	auto empty() const -> bool { return m_entries.empty(); }
+
+	/**
+	 * @brief カタログ番号で検索する
+	 *
+	 * @param catalog_number カタログ番号
+	 * @return Handle ハンドル (見つからない場合は invalid_handle)
+	 */
+	auto find(int catalog_number) const -> Handle {
+		return m_catalog_index.find(hashNumber(catalog_number), [&](Handle h) { return m_entries[h].catalog_number == catalog_number; });
+	}
+
+	/**
+	 * @brief 国際識別符号で検索する
+	 * @note TLE 形式 (98067A) と OMM 形式 (1998-067A) のいずれも受け付ける
+	 *
+	 * @param designator 国際識別符号
+	 * @return Handle ハンドル (見つからない場合は invalid_handle)
+	 */
+	auto findByDesignator(std::string_view designator) const -> Handle {
+		const FixedString<16> key = normalizeDesignator(designator);
+		return m_designator_index.find(hashText(key), [&](Handle h) { return m_entries[h].designator == key.view(); });
+	}
+
+	/**
+	 * @brief 名前が一致する衛星を検索する
+	 * @note 大文字と小文字を区別しない. 同名の衛星が複数ある場合はいずれか1つを返す (すべて取得する場合は searchName() を使用する)
+	 *
+	 * @param name 衛星名
+	 * @return Handle ハンドル (見つからない場合は invalid_handle)
+	 */
+	auto findByName(std::string_view name) const -> Handle {
+		return m_name_index.find(hashName(name), [&](Handle h) { return equalsIgnoreCase(m_entries[h].name.view(), name); });
+	}
+
+	/**
+	 * @brief 名前に文字列を含む衛星を検索する
+	 * @note 大文字と小文字を区別しない. 3文字以上の場合はトライグラム索引で候補を絞り込む
+	 *
+	 * @param text 検索する文字列
+	 * @param limit 最大件数
+	 * @return std::vector<Handle> ハンドル (昇順)
+	 */
+	auto searchName(std::string_view text, std::size_t limit = std::numeric_limits<std::size_t>::max()) const -> std::vector<Handle> {
+		return collect(text, limit, [&](Handle h) { return findIgnoreCase(m_entries[h].name.view(), text) != std::string_view::npos; });
+	}
+
+	/**
+	 * @brief 名前が文字列で始まる衛星を検索する
+	 * @note 大文字と小文字を区別しない
+	 *
+	 * @param prefix 接頭辞
+	 * @param limit 最大件数
+	 * @return std::vector<Handle> ハンドル (昇順)
+	 */
+	auto searchPrefix(std::string_view prefix, std::size_t limit = std::numeric_limits<std::size_t>::max()) const
+	  -> std::vector<Handle> {
+		return collect(prefix.substr(0, trigram_length), limit, [&](Handle h) {
+			const std::string_view name = m_entries[h].name.view();
+			return name.size() >= prefix.size() && equalsIgnoreCase(name.substr(0, prefix.size()), prefix);
+		});
+	}
+
+	auto contains(Handle handle) const -> bool { return handle < m_entries.size(); }
+
+	auto entry(Handle handle) const -> const Entry& { return m_entries[handle]; }
+
+	auto propagator(Handle handle) -> OrbitalPropagator& { return m_propagators[handle]; }
+
+	auto propagator(Handle handle) const -> const OrbitalPropagator& { return m_propagators[handle]; }
+
+	auto entries() const -> const std::vector<Entry>& { return m_entries; }
+
+	auto propagators() const -> const std::vector<OrbitalPropagator>& { return m_propagators; }
+
+	/**
+	 * @brief 衛星の位置・速度 (TEME) を計算する
+	 *
+	 * @param handle ハンドル
+	 * @param time 時刻
+	 * @return CartesianOrbitalElements 位置・速度 (TEME)
+	 */
+	auto trackFlightObject(Handle handle, const DateTime& time) -> CartesianOrbitalElements {
+		return m_propagators[handle].trackFlightObject(time);
+	}
+
+	/**
+	 * @brief 複数の衛星の同時刻の位置・速度 (TEME) を計算する
+	 *
+	 * @param handles ハンドル
+	 * @param time 時刻
+	 * @param states 出力先 (handles.size() 個以上)
+	 */
+	auto trackFlightObject(std::span<const Handle> handles, const DateTime& time, StateVector* states) -> void {
+		Tracing::Span span("propagation", "SatelliteCatalog::trackFlightObject", "satellites", static_cast<std::int64_t>(handles.size()));
+		for (std::size_t i = 0; i < handles.size(); i++) {
+			const auto e = m_propagators[handles[i]].trackFlightObject(time);
+			states[i] = StateVector{time.ticks(), e.position.elements(), e.velocity.elements()};
+		}
+	}
+
+	/**
+	 * @brief 複数の衛星の同時刻の位置・速度 (TEME) を計算する
+	 *
+	 * @param handles ハンドル
+	 * @param time 時刻
+	 * @return std::vector<StateVector> 位置・速度 (TEME)
+	 */
+	auto trackFlightObject(std::span<const Handle> handles, const DateTime& time) -> std::vector<StateVector> {
+		std::vector<StateVector> states(handles.size());
+		trackFlightObject(handles, time, states.data());
+		return states;
+	}
+
+	/**
+	 * @brief 衛星の位置・速度 (TEME) を計算する
+	 * @note カタログを変更しないため, 複数のスレッドから同時に呼び出せる
+	 *
+	 * @param handle ハンドル
+	 * @param time 時刻
+	 * @return CartesianOrbitalElements 位置・速度 (TEME)
+	 */
+	auto trackFlightObject(Handle handle, const DateTime& time) const -> CartesianOrbitalElements {
+		return m_propagators[handle].trackFlightObject(time);
+	}
+
+	/**
+	 * @brief 複数の衛星の同時刻の位置・速度 (TEME) を計算する
+	 * @note カタログを変更しないため, 複数のスレッドから同時に呼び出せる
+	 *
+	 * @param handles ハンドル
+	 * @param time 時刻
+	 * @param states 出力先 (handles.size() 個以上)
+	 */
+	auto trackFlightObject(std::span<const Handle> handles, const DateTime& time, StateVector* states) const -> void {
+		Tracing::Span span("propagation", "SatelliteCatalog::trackFlightObject", "satellites", static_cast<std::int64_t>(handles.size()));
+		for (std::size_t i = 0; i < handles.size(); i++) {
+			const auto e = m_propagators[handles[i]].trackFlightObject(time);
+			states[i] = StateVector{time.ticks(), e.position.elements(), e.velocity.elements()};
+		}
+	}
+
+	auto trackFlightObject(std::span<const Handle> handles, const DateTime& time) const -> std::vector<StateVector> {
+		std::vector<StateVector> states(handles.size());
+		trackFlightObject(handles, time, states.data());
+		return states;
+	}
+
+	/**
+	 * @brief 複数の衛星の同時刻の位置・速度 (TEME) を並列に計算する
+	 * @note 衛星を state_grain 個ずつの区間に分けて実行器に渡す
+	 *
+	 * @param handles ハンドル
+	 * @param time 時刻
+	 * @param states 出力先 (handles.size() 個以上)
+	 * @param executor 実行器
+	 */
+	auto trackFlightObject(std::span<const Handle> handles, const DateTime& time, StateVector* states, Executor& executor) const
+	  -> void {
+		executor.parallelFor(handles.size(), state_grain, [&](std::size_t begin, std::size_t end, std::size_t) {
+			trackFlightObject(handles.subspan(begin, end - begin), time, states + begin);
+		});
+	}
+
+	/**
+	 * @brief 複数の衛星の時刻列の各時刻での位置・速度 (TEME) を並列に計算する
+	 * @note (衛星, grid_block 個の時刻の区間) を作業単位として実行器に渡す. 作業単位ごとに伝搬器を複製するため,
+	 *       深宇宙の共鳴積分の状態は作業単位の間で共有しない
+	 * @exception OrbitException 伝搬に失敗した場合 (減衰など)
+	 *
+	 * @param handles ハンドル
+	 * @param grid 時刻列
+	 * @param states 出力先 (handles.size() * grid.size() 個以上, i 番目の衛星の k 番目の時刻は states[i * grid.size() + k])
+	 * @param executor 実行器
+	 */
+	auto trackFlightObject(std::span<const Handle> handles, const TimeGrid& grid, StateVector* states, Executor& executor) const
+	  -> void {
+		const std::size_t blocks = (grid.size() + grid_block - 1) / grid_block;
+		executor.parallelFor(handles.size() * blocks, 1, [&](std::size_t begin, std::size_t end, std::size_t) {
+			for (std::size_t unit = begin; unit < end; unit++) {
+				const std::size_t i = unit / blocks;
+				const std::size_t first = unit % blocks * grid_block;
+				OrbitalPropagator propagator = m_propagators[handles[i]];
+				propagator.trackFlightObject(TimeGrid(grid.at(first), grid.step(), std::min(grid_block, grid.size() - first)),
+											 states + i * grid.size() + first);
+			}
+		});
+	}
+
+	auto trackFlightObject(std::span<const Handle> handles, const TimeGrid& grid, Executor& executor) const -> std::vector<StateVector> {
+		std::vector<StateVector> states(handles.size() * grid.size());
+		trackFlightObject(handles, grid, states.data(), executor);
+		return states;
+	}
+
+	/**
+	 * @brief 国際識別符号を TLE 形式に正規化する
+	 * @note "1998-067A" は "98067A" とし, 前後の空白を除いて大文字にする
+	 *
+	 * @param designator 国際識別符号
+	 * @return FixedString<16> 正規化した国際識別符号
+	 */
+	static auto normalizeDesignator(std::string_view designator) -> FixedString<16> {
+		designator = trim(designator);
+		char buf[16];
+		std::size_t n = 0;
+		if (designator.size() > 5 && designator[4] == '-') {
+			buf[n++] = designator[2];
+			buf[n++] = designator[3];
+			designator.remove_prefix(5);
+		}
+		for (const char c : designator) {
+			if (n == sizeof(buf)) {
+				break;
+			}
+			buf[n++] = toUpper(c);
+		}
+		return FixedString<16>(std::string_view(buf, n));
+	}
+
+  private:
+	/**
+	 * @brief オープンアドレス法 (線形探索) のハッシュ表
+	 * @note キーのハッシュ値とハンドルの組を保持し, キーの比較は呼び出し側で行う. 削除は後方シフトで行うため墓標を残さない
+	 */
+	class HashIndex {
+	  public:
+		HashIndex() : m_size(0), m_shift(64) {}
+
+		auto reserve(std::size_t n) -> void {
+			if (n * 2 > m_slots.size()) {
+				rehash(n * 2);
+			}
+		}
+
+		template <class Equal>
+		auto find(std::uint64_t hash, Equal&& equal) const -> Handle {
+			if (m_slots.empty()) {
+				return invalid_handle;
+			}
+			const std::size_t mask = m_slots.size() - 1;
+			for (std::size_t i = position(hash);; i = (i + 1) & mask) {
+				const Slot& slot = m_slots[i];
+				if (slot.handle == invalid_handle) {
+					return invalid_handle;
+				}
+				if (slot.hash == hash && equal(slot.handle)) {
+					return slot.handle;
+				}
+			}
+		}
+
+		auto insert(std::uint64_t hash, Handle handle) -> void {
+			if ((m_size + 1) * 2 > m_slots.size()) {
+				rehash(std::max<std::size_t>(m_slots.size() * 2, 16));
+			}
+			place(hash, handle);
+			m_size++;
+		}
+
+		auto erase(std::uint64_t hash, Handle handle) -> void {
+			if (m_slots.empty()) {
+				return;
+			}
+			const std::size_t mask = m_slots.size() - 1;
+			std::size_t i = position(hash);
+			while (m_slots[i].handle != handle) {
+				if (m_slots[i].handle == invalid_handle) {
+					return;
+				}
+				i = (i + 1) & mask;
+			}
+
+			// 後続のスロットを本来の位置に近づける
+			for (std::size_t j = (i + 1) & mask; m_slots[j].handle != invalid_handle; j = (j + 1) & mask) {
+				const std::size_t home = position(m_slots[j].hash);
+				if (((j - home) & mask) >= ((j - i) & mask)) {
+					m_slots[i] = m_slots[j];
+					i = j;
+				}
+			}
+			m_slots[i].handle = invalid_handle;
+			m_size--;
+		}
+
+	  private:
+		struct Slot {
+			std::uint64_t hash;
+			Handle handle;
+		};
+
+		std::vector<Slot> m_slots; // スロット (要素数は2の累乗)
+		std::size_t m_size;		   // 使用中のスロット数
+		int m_shift;			   // 64 - log2(スロット数)
+
+		auto position(std::uint64_t hash) const -> std::size_t {
+			return static_cast<std::size_t>((hash * 0x9E3779B97F4A7C15ull) >> m_shift);
+		}
+
+		auto place(std::uint64_t hash, Handle handle) -> void {
+			const std::size_t mask = m_slots.size() - 1;
+			std::size_t i = position(hash);
+			while (m_slots[i].handle != invalid_handle) i = (i + 1) & mask;
+			m_slots[i] = Slot{hash, handle};
+		}
+
+		auto rehash(std::size_t n) -> void {
+			std::size_t capacity = 16;
+			int bits = 4;
+			while (capacity < n) {
+				capacity *= 2;
+				bits++;
+			}
+			std::vector<Slot> old(capacity, Slot{0, invalid_handle});
+			old.swap(m_slots);
+			m_shift = 64 - bits;
+			for (const Slot& slot : old) {
+				if (slot.handle != invalid_handle) {
+					place(slot.hash, slot.handle);
+				}
+			}
+		}
+	};
+
+	static constexpr std::size_t trigram_length = 3;
+	static constexpr std::size_t init_grain = 64; // 並列初期化の作業単位の要素数
+
+	std::vector<Entry> m_entries;				 // 識別情報
+	std::vector<OrbitalPropagator> m_propagators; // 伝搬器 (m_entries と同じ順序)
+	HashIndex m_catalog_index;					 // カタログ番号の索引
+	HashIndex m_designator_index;				 // 国際識別符号の索引
+	HashIndex m_name_index;						 // 名前 (大文字に変換) の索引
+	HashIndex m_trigram_index;					 // トライグラムから m_postings の添字への索引
+	std::vector<std::uint32_t> m_trigrams;		 // m_postings に対応するトライグラム
+	std::vector<std::vector<Handle>> m_postings;  // トライグラムを名前に含む衛星 (昇順)
+
+	static auto makeEntry(const Tle& tle) -> Entry {
+		return Entry{tle.catalogNumber(), trim(tle.name()), normalizeDesignator(tle.internationalDesignator()), tle.epoch()};
+	}
+
+	static auto makeEntry(const OmmRecord& record) -> Entry {
+		return Entry{record.norad_cat_id, record.object_name.view(), normalizeDesignator(record.object_id.view()), record.epoch};
+	}
+
+	static auto makePropagator(const Tle& tle) -> OrbitalPropagator { return OrbitalPropagator(tle); }
+
+	static auto makePropagator(const OmmRecord& record) -> OrbitalPropagator { return OrbitalPropagator(record.toOrbitalElements()); }
+
+	/**
+	 * @brief 伝搬器を並列に初期化し, 要素の順に追加する
+	 *
+	 */
+	template <class Element>
+	auto addAll(const std::vector<Element>& elements, Executor& executor) -> void {
+		std::vector<std::optional<OrbitalPropagator>> propagators(elements.size());
+		executor.parallelFor(elements.size(), init_grain, [&](std::size_t begin, std::size_t end, std::size_t) {
+			for (std::size_t i = begin; i < end; i++) {
+				try {
+					propagators[i].emplace(makePropagator(elements[i]));
+				} catch (const OrbitException&) {
+				}
+			}
+		});
+		reserve(elements.size());
+		for (std::size_t i = 0; i < elements.size(); i++) {
+			if (propagators[i]) {
+				add(makeEntry(elements[i]), *propagators[i]);
+			}
+		}
+	}
+
+	auto tryAdd(const Tle& tle) -> void {
+		try {
+			add(tle);
+		} catch (const OrbitException&) {
+		}
+	}
+
+	auto tryAdd(const OmmRecord& record) -> void {
+		try {
+			add(record);
+		} catch (const OrbitException&) {
+		}
+	}
+
+	/**
+	 * @brief 名前のトライグラムを索引に登録する
+	 *
+	 */
+	auto indexName(Handle handle) -> void {
+		const std::string_view name = m_entries[handle].name.view();
+		for (std::size_t i = 0; i + trigram_length <= name.size(); i++) {
+			const std::uint32_t trigram = trigramAt(name, i);
+			Handle posting = m_trigram_index.find(trigram, [&](Handle p) { return m_trigrams[p] == trigram; });
+			if (posting == invalid_handle) {
+				posting = static_cast<Handle>(m_postings.size());
+				m_trigrams.push_back(trigram);
+				m_postings.emplace_back();
+				m_trigram_index.insert(trigram, posting);
+			}
+			insertSorted(m_postings[posting], handle);
+		}
+	}
+
+	/**
+	 * @brief 名前のトライグラムを索引から削除する
+	 *
+	 */
+	auto unindexName(Handle handle) -> void {
+		const std::string_view name = m_entries[handle].name.view();
+		for (std::size_t i = 0; i + trigram_length <= name.size(); i++) {
+			const std::uint32_t trigram = trigramAt(name, i);
+			const Handle posting = m_trigram_index.find(trigram, [&](Handle p) { return m_trigrams[p] == trigram; });
+			if (posting != invalid_handle) {
+				eraseSorted(m_postings[posting], handle);
+			}
+		}
+	}
+
+	/**
+	 * @brief 名前に文字列を含む可能性のある衛星を列挙する
+	 * @note 3文字以上の場合は最も出現数の少ないトライグラムの該当衛星, それ未満の場合は全衛星を昇順に列挙する
+	 *
+	 * @param text 検索する文字列
+	 * @param candidate candidate(ハンドル) -> 列挙を続ける場合は true
+	 */
+	template <class CandidateFunction>
+	auto forEachNameCandidate(std::string_view text, CandidateFunction&& candidate) const -> void {
+		if (text.size() < trigram_length) {
+			for (Handle h = 0; h < m_entries.size(); h++) {
+				if (!candidate(h)) {
+					return;
+				}
+			}
+			return;
+		}
+
+		const std::vector<Handle>* smallest = nullptr;
+		for (std::size_t i = 0; i + trigram_length <= text.size(); i++) {
+			const std::uint32_t trigram = trigramAt(text, i);
+			const Handle posting = m_trigram_index.find(trigram, [&](Handle p) { return m_trigrams[p] == trigram; });
+			if (posting == invalid_handle) {
+				return;
+			}
+			if (smallest == nullptr || m_postings[posting].size() < smallest->size()) {
+				smallest = &m_postings[posting];
+			}
+		}
+		for (const Handle h : *smallest) {
+			if (!candidate(h)) {
+				return;
+			}
+		}
+	}
+
+	template <class Predicate>
+	auto collect(std::string_view text, std::size_t limit, Predicate&& predicate) const -> std::vector<Handle> {
+		std::vector<Handle> handles;
+		if (limit == 0) {
+			return handles;
+		}
+		forEachNameCandidate(text, [&](Handle h) {
+			if (predicate(h)) {
+				handles.push_back(h);
+			}
+			return handles.size() < limit;
+		});
+		return handles;
+	}
+
+	static auto insertSorted(std::vector<Handle>& handles, Handle handle) -> void {
+		if (handles.empty() || handles.back() < handle) {
+			handles.push_back(handle);
+			return;
+		}
+		const auto it = std::lower_bound(handles.begin(), handles.end(), handle);
+		if (it == handles.end() || *it != handle) {
+			handles.insert(it, handle);
+		}
+	}
+
+	static auto eraseSorted(std::vector<Handle>& handles, Handle handle) -> void {
+		const auto it = std::lower_bound(handles.begin(), handles.end(), handle);
+		if (it != handles.end() && *it == handle) {
+			handles.erase(it);
+		}
+	}
+
+	static auto trigramAt(std::string_view str, std::size_t i) -> std::uint32_t {
+		return (static_cast<std::uint32_t>(static_cast<unsigned char>(toUpper(str[i]))) << 16) |
+			   (static_cast<std::uint32_t>(static_cast<unsigned char>(toUpper(str[i + 1]))) << 8) |
+			   static_cast<std::uint32_t>(static_cast<unsigned char>(toUpper(str[i + 2])));
+	}
+
+	static auto toUpper(char c) -> char { return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c; }
+
+	static auto equalsIgnoreCase(std::string_view lhs, std::string_view rhs) -> bool {
+		if (lhs.size() != rhs.size()) {
+			return false;
+		}
+		for (std::size_t i = 0; i < lhs.size(); i++) {
+			if (toUpper(lhs[i]) != toUpper(rhs[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static auto findIgnoreCase(std::string_view str, std::string_view text) -> std::size_t {
+		if (text.size() > str.size()) {
+			return std::string_view::npos;
+		}
+		for (std::size_t i = 0; i + text.size() <= str.size(); i++) {
+			if (equalsIgnoreCase(str.substr(i, text.size()), text)) {
+				return i;
+			}
+		}
+		return std::string_view::npos;
+	}
+
+	static auto hashNumber(int number) -> std::uint64_t { return static_cast<std::uint64_t>(static_cast<std::uint32_t>(number)); }
+
+	// FNV-1a
+	static auto hashText(std::string_view str) -> std::uint64_t {
+		std::uint64_t h = 0xCBF29CE484222325ull;
+		for (const char c : str) {
+			h = (h ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+		}
+		return h;
+	}
+
+	static auto hashName(std::string_view str) -> std::uint64_t {
+		std::uint64_t h = 0xCBF29CE484222325ull;
+		for (const char c : str) {
+			h = (h ^ static_cast<unsigned char>(toUpper(c))) * 0x100000001B3ull;
+		}
+		return h;
+	}
+
+	static auto trim(std::string_view str) -> std::string_view {
+		std::size_t first = 0;
+		std::size_t last = str.size();
+		while (first < last && str[first] == ' ') first++;
+		while (last > first && str[last - 1] == ' ') last--;
+		return str.substr(first, last - first);
+	}
+};
+
+SATFIND_NAMESPACE_END
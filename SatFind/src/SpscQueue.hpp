@@ -0,0 +1,167 @@
+/**
+ * @file SpscQueue.hpp
+ * @author fugu133
+ * @brief 単一生産者・単一消費者の有界キュー
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Essential.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief 単一生産者・単一消費者の有界キュー
+ * @note 環状バッファの読み出し位置と書き込み位置をそれぞれ一方のスレッドのみが更新するため, ロックを使用しない.
+ *       満杯または空の場合は std::atomic::wait で相手の更新を待つ. 終了の通知は位置の最上位ビットで表し, 待機中の相手を起こす
+ * @remark push() は1つのスレッド, pop() は別の1つのスレッドからのみ呼び出す. 要素は配列のブロックなど大きめの単位を想定する
+ *
+ * @tparam T 要素の型 (デフォルト構築とムーブ代入が可能)
+ */
+template <class T>
+class SpscQueue {
+  public:
+	/**
+	 * @brief Construct a new Spsc Queue object
+	 *
+	 * @param capacity 最大要素数 (1以上)
+	 */
+	explicit SpscQueue(std::size_t capacity) : m_head(0), m_tail(0), m_slots(capacity) {
+		if (capacity == 0) {
+			throw std::invalid_argument("SpscQueue capacity must be positive");
+		}
+	}
+
+	SpscQueue(const SpscQueue&) = delete;
+	auto operator=(const SpscQueue&) -> SpscQueue& = delete;
+
+	auto capacity() const -> std::size_t { return m_slots.size(); }
+
+	/**
+	 * @brief 要素を追加する (生産者)
+	 * @note 満杯の場合は空きができるまで待つ
+	 *
+	 * @param value 要素
+	 * @return bool 追加できたか (消費者が cancel() した場合は false)
+	 */
+	auto push(T value) -> bool {
+		const std::size_t tail = m_tail.load(std::memory_order_relaxed) & ~closed_bit;
+		for (;;) {
+			const std::size_t head = m_head.load(std::memory_order_acquire);
+			if (head & closed_bit) {
+				return false;
+			}
+			if (tail - head < m_slots.size()) {
+				break;
+			}
+			m_head.wait(head, std::memory_order_acquire);
+		}
+		m_slots[tail % m_slots.size()] = std::move(value);
+		m_tail.store(tail + 1, std::memory_order_release);
+		m_tail.notify_one();
+		return true;
+	}
+
+	/**
+	 * @brief 要素を追加する (生産者)
+	 * @note 満杯の場合は待たずに false を返す
+	 *
+	 * @param value 要素 (追加できなかった場合は変更しない)
+	 * @return bool 追加できたか
+	 */
+	auto tryPush(T& value) -> bool {
+		const std::size_t tail = m_tail.load(std::memory_order_relaxed) & ~closed_bit;
+		const std::size_t head = m_head.load(std::memory_order_acquire);
+		if ((head & closed_bit) || tail - head >= m_slots.size()) {
+			return false;
+		}
+		m_slots[tail % m_slots.size()] = std::move(value);
+		m_tail.store(tail + 1, std::memory_order_release);
+		m_tail.notify_one();
+		return true;
+	}
+
+	/**
+	 * @brief 要素を取り出す (消費者)
+	 * @note 空の場合は要素が追加されるか close() されるまで待つ
+	 *
+	 * @param value 取り出した要素の格納先
+	 * @return bool 取り出せたか (close() 済みで空の場合は false)
+	 */
+	auto pop(T& value) -> bool {
+		const std::size_t head = m_head.load(std::memory_order_relaxed) & ~closed_bit;
+		for (;;) {
+			const std::size_t tail = m_tail.load(std::memory_order_acquire);
+			if ((tail & ~closed_bit) != head) {
+				break;
+			}
+			if (tail & closed_bit) {
+				return false;
+			}
+			m_tail.wait(tail, std::memory_order_acquire);
+		}
+		value = std::move(m_slots[head % m_slots.size()]);
+		m_head.store(head + 1, std::memory_order_release);
+		m_head.notify_one();
+		return true;
+	}
+
+	/**
+	 * @brief 要素を取り出す (消費者)
+	 * @note 空の場合は待たずに false を返す
+	 *
+	 * @param value 取り出した要素の格納先
+	 * @return bool 取り出せたか
+	 */
+	auto tryPop(T& value) -> bool {
+		const std::size_t head = m_head.load(std::memory_order_relaxed) & ~closed_bit;
+		const std::size_t tail = m_tail.load(std::memory_order_acquire);
+		if ((tail & ~closed_bit) == head) {
+			return false;
+		}
+		value = std::move(m_slots[head % m_slots.size()]);
+		m_head.store(head + 1, std::memory_order_release);
+		m_head.notify_one();
+		return true;
+	}
+
+	/**
+	 * @brief これ以上要素を追加しないことを通知する (生産者)
+	 * @note 消費者は残りの要素を取り出した後, pop() で false を受け取る
+	 *
+	 */
+	auto close() -> void {
+		m_tail.fetch_or(closed_bit, std::memory_order_release);
+		m_tail.notify_all();
+	}
+
+	/**
+	 * @brief これ以上要素を取り出さないことを通知する (消費者)
+	 * @note 生産者の push() は待機中のものを含めて false を返す
+	 *
+	 */
+	auto cancel() -> void {
+		m_head.fetch_or(closed_bit, std::memory_order_release);
+		m_head.notify_all();
+	}
+
+  private:
+	static constexpr std::size_t closed_bit = std::size_t(1) << (sizeof(std::size_t) * 8 - 1); // 終了を表すビット
+
+	alignas(64) std::atomic<std::size_t> m_head; // 読み出し位置 (消費者が更新する)
+	alignas(64) std::atomic<std::size_t> m_tail; // 書き込み位置 (生産者が更新する)
+	alignas(64) std::vector<T> m_slots;			 // 環状バッファ
+};
+
+SATFIND_NAMESPACE_END
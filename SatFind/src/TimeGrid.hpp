@@ -0,0 +1,276 @@
+/**
+ * @file TimeGrid.hpp
+ * @author fugu133
+ * @brief 等間隔の時刻列を表すクラス
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "AngleHelper.hpp"
+#include "DateTime.hpp"
+#include "DeltaT.hpp"
+#include "Essential.hpp"
+#include "Polynomial.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief 等間隔の時刻列
+ * @note 開始時刻, 刻み幅, 点数で時刻列を表す. ティック数, ユリウス日, グリニッジ恒星時, ΔT の配列は
+ *       初めて参照したときに一度だけ計算し, 以降は同じ配列を返す
+ * @remark 恒星時は日ごとに変わる項のみを計算し直し, 時刻ごとに独立に計算しない. ΔT は DeltaT の表を参照する
+ */
+class TimeGrid {
+  public:
+	/**
+	 * @brief Construct a new Time Grid object
+	 *
+	 * @param start 開始時刻
+	 * @param step 刻み幅 (正)
+	 * @param count 点数
+	 */
+	TimeGrid(const DateTime& start, const TimeSpan& step, std::size_t count)
+	  : m_start_ticks(start.ticks()), m_step_ticks(step.ticks()), m_count(count), m_cache(std::make_unique<Cache>()) {
+		if (m_step_ticks <= 0) {
+			throw DateTimeException("Time grid step must be positive", DateTimeException::InvalidTimeGrid);
+		}
+	}
+
+	/**
+	 * @brief Construct a new Time Grid object
+	 * @note 計算済みの配列はコピーしない
+	 *
+	 */
+	TimeGrid(const TimeGrid& other) : TimeGrid(other.start(), other.step(), other.size()) {}
+
+	auto operator=(const TimeGrid& other) -> TimeGrid& {
+		m_start_ticks = other.m_start_ticks;
+		m_step_ticks = other.m_step_ticks;
+		m_count = other.m_count;
+		m_cache = std::make_unique<Cache>();
+		return *this;
+	}
+
+	/**
+	 * @brief 半開区間 [begin, end) を刻み幅で区切った時刻列を作成する
+	 *
+	 * @param begin 開始時刻
+	 * @param end 終了時刻 (含まない)
+	 * @param step 刻み幅 (正)
+	 * @return TimeGrid
+	 */
+	static auto range(const DateTime& begin, const DateTime& end, const TimeSpan& step) -> TimeGrid {
+		if (step.ticks() <= 0) {
+			throw DateTimeException("Time grid step must be positive", DateTimeException::InvalidTimeGrid);
+		}
+		const std::int64_t span = end.ticks() - begin.ticks();
+		const std::size_t count = span > 0 ? static_cast<std::size_t>((span + step.ticks() - 1) / step.ticks()) : 0;
+		return TimeGrid(begin, step, count);
+	}
+
+	auto size() const -> std::size_t { return m_count; }
+
+	auto empty() const -> bool { return m_count == 0; }
+
+	auto start() const -> DateTime { return DateTime(m_start_ticks); }
+
+	auto step() const -> TimeSpan { return TimeSpan(m_step_ticks); }
+
+	/**
+	 * @brief 最終点の時刻を取得する
+	 *
+	 */
+	auto back() const -> DateTime { return DateTime(tickAt(m_count - 1)); }
+
+	/**
+	 * @brief i番目の時刻を取得する
+	 *
+	 * @param i 番号
+	 * @return DateTime
+	 */
+	auto at(std::size_t i) const -> DateTime { return DateTime(tickAt(i)); }
+
+	auto operator[](std::size_t i) const -> DateTime { return at(i); }
+
+	/**
+	 * @brief ティック数の配列を取得する
+	 *
+	 * @return const std::vector<std::int64_t>& ティック数 [us]
+	 */
+	auto ticks() const -> const std::vector<std::int64_t>& {
+		std::call_once(m_cache->ticks_flag, [this] {
+			m_cache->ticks.resize(m_count);
+			std::int64_t t = m_start_ticks;
+			for (auto& v : m_cache->ticks) {
+				v = t;
+				t += m_step_ticks;
+			}
+		});
+		return m_cache->ticks;
+	}
+
+	/**
+	 * @brief ユリウス日の配列を取得する
+	 * @note 整数日と日の端数を分けて足し合わせるため, DateTime::julianDay() より丸め誤差が小さい
+	 *
+	 * @return const std::vector<double>& ユリウス日 [day]
+	 */
+	auto julianDays() const -> const std::vector<double>& {
+		std::call_once(m_cache->julian_days_flag, [this] {
+			m_cache->julian_days.resize(m_count);
+			forEachDay([this](std::size_t i, std::int64_t days, std::int64_t time_part_ticks) {
+				m_cache->julian_days[i] = (static_cast<double>(days) + constant::jd_at_gc_era) +
+										  static_cast<double>(time_part_ticks) / static_cast<double>(constant::ticks_per_day);
+			});
+		});
+		return m_cache->julian_days;
+	}
+
+	/**
+	 * @brief グリニッジ恒星時の配列を取得する
+	 * @note DateTime::greenwichSiderealTime() と同じ式で, 0h UT の項を日ごとに1度だけ計算する
+	 *
+	 * @return const std::vector<double>& グリニッジ恒星時 [rad]
+	 */
+	auto greenwichSiderealTimes() const -> const std::vector<double>& {
+		std::call_once(m_cache->gmst_flag, [this] {
+			m_cache->gmst.resize(m_count);
+			std::int64_t current_day = -1;
+			double gt0 = 0.0;
+			forEachDay([&](std::size_t i, std::int64_t days, std::int64_t time_part_ticks) {
+				if (days != current_day) {
+					const double jd0 = static_cast<double>(days) + constant::jd_at_gc_era;
+					const double t = (jd0 - constant::jd_at_j2000_epoch) / constant::jd_century;
+					gt0 = 24110.54841 + t * (8640184.812866 + t * (0.093104 - t * 6.2E-6));
+					current_day = days;
+				}
+				const double jdf = static_cast<double>(time_part_ticks) / static_cast<double>(constant::ticks_per_day);
+				m_cache->gmst[i] = AngleHelper::degreeToWrapRadian((gt0 + jdf * 1.00273790935 * constant::seconds_per_day) / 240.0);
+			});
+		});
+		return m_cache->gmst;
+	}
+
+	/**
+	 * @brief ΔT の配列を取得する
+	 * @note DateTime::deltaT() と同じく DeltaT::current() の表を参照する
+	 *
+	 * @return const std::vector<double>& ΔT [s]
+	 */
+	auto deltaTs() const -> const std::vector<double>& {
+		std::call_once(m_cache->delta_t_flag, [this] {
+			m_cache->delta_t.resize(m_count);
+			const DeltaT& table = DeltaT::current();
+			std::int64_t t = m_start_ticks;
+			for (auto& v : m_cache->delta_t) {
+				v = table.seconds(DateTime(t));
+				t += m_step_ticks;
+			}
+		});
+		return m_cache->delta_t;
+	}
+
+	/**
+	 * @brief 基準時刻からの経過時間の配列を取得する
+	 * @note 基準時刻ごとに異なるため結果は保持しない
+	 *
+	 * @param epoch 基準時刻
+	 * @return std::vector<double> 経過時間 [min]
+	 */
+	auto minutesSince(const DateTime& epoch) const -> std::vector<double> {
+		std::vector<double> ret(m_count);
+		std::int64_t offset = m_start_ticks - epoch.ticks();
+		for (auto& v : ret) {
+			v = static_cast<double>(offset) / static_cast<double>(constant::ticks_per_minute);
+			offset += m_step_ticks;
+		}
+		return ret;
+	}
+
+	/**
+	 * @brief 範囲for文で時刻を順に取得するためのイテレータ
+	 *
+	 */
+	class Iterator {
+	  public:
+		Iterator(std::int64_t ticks, std::int64_t step) : m_ticks(ticks), m_step(step) {}
+		auto operator*() const -> DateTime { return DateTime(m_ticks); }
+		auto operator++() -> Iterator& {
+			m_ticks += m_step;
+			return *this;
+		}
+		auto operator!=(const Iterator& other) const -> bool { return m_ticks != other.m_ticks; }
+		auto operator==(const Iterator& other) const -> bool { return m_ticks == other.m_ticks; }
+
+	  private:
+		std::int64_t m_ticks;
+		std::int64_t m_step;
+	};
+
+	auto begin() const -> Iterator { return Iterator(m_start_ticks, m_step_ticks); }
+
+	auto end() const -> Iterator { return Iterator(tickAt(m_count), m_step_ticks); }
+
+  private:
+	std::int64_t m_start_ticks; // 開始時刻 [ticks]
+	std::int64_t m_step_ticks;	// 刻み幅 [ticks]
+	std::size_t m_count;		// 点数
+
+	/**
+	 * @brief 遅延計算する配列
+	 * @note 複数スレッドから同時に参照しても一度だけ計算される
+	 */
+	struct Cache {
+		std::once_flag ticks_flag;
+		std::once_flag julian_days_flag;
+		std::once_flag gmst_flag;
+		std::once_flag delta_t_flag;
+		std::vector<std::int64_t> ticks;
+		std::vector<double> julian_days;
+		std::vector<double> gmst;
+		std::vector<double> delta_t;
+	};
+
+	std::unique_ptr<Cache> m_cache;
+
+	auto tickAt(std::size_t i) const -> std::int64_t { return m_start_ticks + static_cast<std::int64_t>(i) * m_step_ticks; }
+
+	/**
+	 * @brief 各点の通算日数と日内のティック数を除算なしで順に求める
+	 *
+	 * @param f f(番号, 0001-01-01 からの通算日数, 日内のティック数)
+	 */
+	template <class F>
+	auto forEachDay(F&& f) const -> void {
+		if (m_count == 0) {
+			return;
+		}
+
+		const std::int64_t step_days = m_step_ticks / constant::ticks_per_day;
+		const std::int64_t step_rest = m_step_ticks % constant::ticks_per_day;
+		std::int64_t days = m_start_ticks / constant::ticks_per_day;
+		std::int64_t rest = m_start_ticks % constant::ticks_per_day;
+
+		for (std::size_t i = 0; i < m_count; i++) {
+			f(i, days, rest);
+			days += step_days;
+			rest += step_rest;
+			if (rest >= constant::ticks_per_day) {
+				rest -= constant::ticks_per_day;
+				days++;
+			}
+		}
+	}
+};
+
+SATFIND_NAMESPACE_END
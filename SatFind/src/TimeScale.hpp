@@ -0,0 +1,500 @@
+/**
+ * @file TimeScale.hpp
+ * @author fugu133
+ * @brief 時刻系 (UTC, TAI, TT, UT1, GPS) とうるう秒の表
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DateTime.hpp"
+#include "DeltaT.hpp"
+#include "EarthOrientation.hpp"
+#include "Essential.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief 時刻系
+ *
+ */
+enum class TimeScale {
+	UTC, // 協定世界時
+	TAI, // 国際原子時
+	TT,	 // 地球時 (TAI + 32.184 s)
+	UT1, // 世界時 (地球自転角)
+	GPS, // GPS時 (TAI - 19 s)
+};
+
+/**
+ * @brief うるう秒の表 (TAI - UTC)
+ * @note 1972年以降のうるう秒を組み込みで持ち, IERS の Leap_Second.dat または NIST/IETF の leap-seconds.list で更新できる
+ * @remark 表の先頭 (1972-01-01) より前は先頭の値 (10 s) を用いる. うるう秒 (23:59:60) 自体は表現できない
+ */
+class LeapSecondTable {
+  public:
+	/**
+	 * @brief うるう秒の区間
+	 * @note [begin, end) の間は TAI - UTC が一定
+	 */
+	struct Interval {
+		std::int64_t begin;		   // 区間の開始 [ticks]
+		std::int64_t end;		   // 区間の終了 [ticks]
+		std::int64_t tai_minus_utc; // TAI - UTC [ticks]
+	};
+
+	/**
+	 * @brief Construct a new Leap Second Table object
+	 * @note 組み込みの表 (2017-01-01, TAI - UTC = 37 s まで) を用いる
+	 */
+	LeapSecondTable() : m_hint(0) {
+		for (const auto& [year, month, seconds] : builtin_leap_seconds) {
+			add(DateTime(year, month, 1, 0, 0, 0, 0), seconds);
+		}
+	}
+
+	LeapSecondTable(const LeapSecondTable& other) : m_entries(other.m_entries), m_hint(0) {}
+
+	auto operator=(const LeapSecondTable& other) -> LeapSecondTable& {
+		m_entries = other.m_entries;
+		m_hint.store(0, std::memory_order_relaxed);
+		return *this;
+	}
+
+	/**
+	 * @brief うるう秒のファイルを読み込む
+	 * @note IERS Leap_Second.dat (MJD 日 月 年 TAI-UTC) と leap-seconds.list (NTP秒 TAI-UTC) を受け付ける.
+	 *       '#' 以降はコメントとして扱う
+	 *
+	 * @param stream 入力ストリーム
+	 * @return LeapSecondTable
+	 */
+	static auto fromStream(std::istream& stream) -> LeapSecondTable {
+		LeapSecondTable ret;
+		ret.m_entries.clear();
+
+		std::string line;
+		while (std::getline(stream, line)) {
+			std::string_view body = line;
+			body = body.substr(0, body.find('#'));
+
+			double fields[5];
+			const std::size_t n = splitNumbers(body, fields);
+			if (n == 0) {
+				continue;
+			}
+
+			if (n == 2) {
+				// leap-seconds.list: 1900-01-01 からの秒数
+				const auto ntp_seconds = static_cast<std::int64_t>(fields[0]);
+				ret.add(DateTime(ntp_epoch_ticks + ntp_seconds * constant::ticks_per_second), static_cast<int>(fields[1]));
+			} else if (n == 5) {
+				// Leap_Second.dat: MJD, 日, 月, 年, TAI-UTC
+				ret.add(DateTime(static_cast<int>(fields[3]), static_cast<int>(fields[2]), static_cast<int>(fields[1]), 0, 0, 0, 0),
+						static_cast<int>(fields[4]));
+			} else {
+				throw DateTimeException("Invalid leap second record: " + line, DateTimeException::InvalidLeapSecond);
+			}
+		}
+
+		if (ret.m_entries.empty()) {
+			throw DateTimeException("Leap second file has no records", DateTimeException::InvalidLeapSecond);
+		}
+		return ret;
+	}
+
+	/**
+	 * @brief うるう秒のファイルを読み込む
+	 *
+	 * @param path ファイルパス
+	 * @return LeapSecondTable
+	 */
+	static auto fromFile(const std::string& path) -> LeapSecondTable {
+		std::ifstream ifs(path);
+		if (!ifs) {
+			throw DateTimeException("Cannot open leap second file: " + path, DateTimeException::InvalidLeapSecond);
+		}
+		return fromStream(ifs);
+	}
+
+	/**
+	 * @brief うるう秒を追加する
+	 * @note 時刻の昇順で追加すること
+	 *
+	 * @param utc うるう秒の適用開始時刻 (UTC)
+	 * @param tai_minus_utc 適用後の TAI - UTC [s]
+	 */
+	void add(const DateTime& utc, int tai_minus_utc) {
+		if (!m_entries.empty() && utc.ticks() <= m_entries.back().utc_ticks) {
+			throw DateTimeException("Leap second records must be in ascending order", DateTimeException::InvalidLeapSecond);
+		}
+		m_entries.push_back(Entry{utc.ticks(), tai_minus_utc * constant::ticks_per_second});
+	}
+
+	/**
+	 * @brief TAI - UTC を取得する
+	 *
+	 * @param utc 時刻 (UTC)
+	 * @return TimeSpan TAI - UTC
+	 */
+	auto taiMinusUtc(const DateTime& utc) const -> TimeSpan { return TimeSpan(utcInterval(utc.ticks()).tai_minus_utc); }
+
+	/**
+	 * @brief UTC の時刻を含む区間を取得する
+	 * @note 前回の区間を保持しておき, 同じ区間内なら探索しない
+	 *
+	 * @param utc_ticks 時刻 (UTC) [ticks]
+	 * @return Interval 区間 (UTC)
+	 */
+	auto utcInterval(std::int64_t utc_ticks) const -> Interval {
+		return find(utc_ticks, [](const Entry& e) { return e.utc_ticks; });
+	}
+
+	/**
+	 * @brief TAI の時刻を含む区間を取得する
+	 *
+	 * @param tai_ticks 時刻 (TAI) [ticks]
+	 * @return Interval 区間 (TAI)
+	 */
+	auto taiInterval(std::int64_t tai_ticks) const -> Interval {
+		return find(tai_ticks, [](const Entry& e) { return e.utc_ticks + e.tai_minus_utc; });
+	}
+
+	auto size() const -> std::size_t { return m_entries.size(); }
+
+	/**
+	 * @brief 時刻系の変換が参照する表を取得する
+	 *
+	 * @return const LeapSecondTable&
+	 */
+	static auto current() -> const LeapSecondTable& {
+		const LeapSecondTable* table = s_current.load(std::memory_order_acquire);
+		return table != nullptr ? *table : builtinTable();
+	}
+
+	/**
+	 * @brief 時刻系の変換が参照する表を置き換える
+	 * @note 置き換え前の表への参照は無効にならない
+	 *
+	 * @param table うるう秒の表
+	 */
+	static auto setCurrent(LeapSecondTable table) -> void {
+		static std::mutex mutex;
+		static std::vector<std::unique_ptr<const LeapSecondTable>> installed;
+
+		std::lock_guard<std::mutex> lock(mutex);
+		installed.push_back(std::make_unique<const LeapSecondTable>(std::move(table)));
+		s_current.store(installed.back().get(), std::memory_order_release);
+	}
+
+	/**
+	 * @brief 時刻系の変換が参照する表を組み込みの表に戻す
+	 *
+	 */
+	static auto resetCurrent() -> void { s_current.store(nullptr, std::memory_order_release); }
+
+  private:
+	struct Entry {
+		std::int64_t utc_ticks;		// 適用開始時刻 (UTC) [ticks]
+		std::int64_t tai_minus_utc; // TAI - UTC [ticks]
+	};
+
+	struct BuiltinLeapSecond {
+		int year;
+		int month;
+		int tai_minus_utc;
+	};
+
+	std::vector<Entry> m_entries;
+	mutable std::atomic<std::size_t> m_hint; // 前回参照した区間の番号
+
+	inline static std::atomic<const LeapSecondTable*> s_current{nullptr};
+
+	static constexpr std::int64_t ntp_epoch_ticks = 693595LL * constant::ticks_per_day; // 1900-01-01T00:00:00
+
+	static constexpr BuiltinLeapSecond builtin_leap_seconds[] = {
+	  {1972, 1, 10}, {1972, 7, 11}, {1973, 1, 12}, {1974, 1, 13}, {1975, 1, 14}, {1976, 1, 15}, {1977, 1, 16},
+	  {1978, 1, 17}, {1979, 1, 18}, {1980, 1, 19}, {1981, 7, 20}, {1982, 7, 21}, {1983, 7, 22}, {1985, 7, 23},
+	  {1988, 1, 24}, {1990, 1, 25}, {1991, 1, 26}, {1992, 7, 27}, {1993, 7, 28}, {1994, 7, 29}, {1996, 1, 30},
+	  {1997, 7, 31}, {1999, 1, 32}, {2006, 1, 33}, {2009, 1, 34}, {2012, 7, 35}, {2015, 7, 36}, {2017, 1, 37},
+	};
+
+	static auto builtinTable() -> const LeapSecondTable& {
+		static const LeapSecondTable table;
+		return table;
+	}
+
+	/**
+	 * @brief 時刻を含む区間を探す
+	 *
+	 * @param ticks 時刻 [ticks]
+	 * @param begin_of 区間の開始時刻を求める関数
+	 * @return Interval
+	 */
+	template <class BeginOf>
+	auto find(std::int64_t ticks, BeginOf begin_of) const -> Interval {
+		constexpr std::int64_t min_ticks = std::numeric_limits<std::int64_t>::min();
+		constexpr std::int64_t max_ticks = std::numeric_limits<std::int64_t>::max();
+		const std::size_t n = m_entries.size();
+
+		auto interval = [&](std::size_t i) -> Interval {
+			return Interval{i == 0 ? min_ticks : begin_of(m_entries[i]), i + 1 < n ? begin_of(m_entries[i + 1]) : max_ticks,
+							m_entries[i].tai_minus_utc};
+		};
+
+		std::size_t i = m_hint.load(std::memory_order_relaxed);
+		if (i < n) {
+			const Interval hit = interval(i);
+			if (ticks >= hit.begin && ticks < hit.end) {
+				return hit;
+			}
+		}
+
+		const auto it = std::upper_bound(m_entries.begin(), m_entries.end(), ticks,
+										 [&](std::int64_t t, const Entry& e) { return t < begin_of(e); });
+		i = it == m_entries.begin() ? 0 : static_cast<std::size_t>(std::distance(m_entries.begin(), it)) - 1;
+		m_hint.store(i, std::memory_order_relaxed);
+		return interval(i);
+	}
+
+	static auto splitNumbers(std::string_view line, double (&fields)[5]) -> std::size_t {
+		std::size_t n = 0;
+		std::size_t pos = 0;
+		while (n < 5) {
+			while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t' || line[pos] == '\r')) pos++;
+			if (pos >= line.size()) {
+				break;
+			}
+			const char* begin = line.data() + pos;
+			const auto [ptr, ec] = std::from_chars(begin, line.data() + line.size(), fields[n]);
+			if (ec != std::errc()) {
+				break;
+			}
+			pos += static_cast<std::size_t>(ptr - begin);
+			n++;
+		}
+		return n;
+	}
+};
+
+/**
+ * @brief 時刻系の付いた時刻
+ *
+ */
+class Instant {
+  public:
+	/**
+	 * @brief Construct a new Instant object
+	 *
+	 * @param dt 時刻
+	 * @param scale 時刻系
+	 */
+	Instant(const DateTime& dt, TimeScale scale = TimeScale::UTC) : m_time(dt), m_scale(scale) {}
+
+	auto dateTime() const -> const DateTime& { return m_time; }
+
+	auto scale() const -> TimeScale { return m_scale; }
+
+	/**
+	 * @brief 別の時刻系に変換する
+	 * @note UT1 は ΔT (DeltaT::current()) から UT1 = TT - ΔT として求める
+	 *
+	 * @param scale 変換先の時刻系
+	 * @return Instant
+	 */
+	auto to(TimeScale scale) const -> Instant { return Instant(DateTime(fromTai(toTai(nullptr), scale, nullptr)), scale); }
+
+	/**
+	 * @brief 別の時刻系に変換する
+	 * @note UT1 は EOP の UT1-UTC から求める
+	 *
+	 * @param scale 変換先の時刻系
+	 * @param eop 地球姿勢パラメータ
+	 * @return Instant
+	 */
+	auto to(TimeScale scale, const EarthOrientationParameters& eop) const -> Instant {
+		return Instant(DateTime(fromTai(toTai(&eop), scale, &eop)), scale);
+	}
+
+	/**
+	 * @brief 時刻系の固定の差 (TAI基準)
+	 *
+	 * @param scale 時刻系 (TAI, TT, GPS)
+	 * @return std::int64_t 時刻系の時刻 - TAI [ticks]
+	 */
+	static constexpr auto fixedOffsetFromTai(TimeScale scale) -> std::int64_t {
+		switch (scale) {
+			case TimeScale::TT:
+				return tt_minus_tai_ticks;
+			case TimeScale::GPS:
+				return gps_minus_tai_ticks;
+			default:
+				return 0;
+		}
+	}
+
+	friend auto operator<<(std::ostream& os, const Instant& instant) -> std::ostream& {
+		static constexpr const char* names[] = {"UTC", "TAI", "TT", "UT1", "GPS"};
+		return os << instant.m_time << " (" << names[static_cast<int>(instant.m_scale)] << ")";
+	}
+
+  private:
+	DateTime m_time;
+	TimeScale m_scale;
+
+	static constexpr std::int64_t tt_minus_tai_ticks = 32184000LL;	 // TT - TAI = 32.184 s
+	static constexpr std::int64_t gps_minus_tai_ticks = -19000000LL; // GPS - TAI = -19 s
+
+	auto toTai(const EarthOrientationParameters* eop) const -> std::int64_t {
+		const std::int64_t t = m_time.ticks();
+		switch (m_scale) {
+			case TimeScale::UTC:
+				return t + LeapSecondTable::current().utcInterval(t).tai_minus_utc;
+			case TimeScale::UT1:
+				if (eop != nullptr) {
+					const std::int64_t utc = t - secondsToTicks(eop->at(m_time).ut1_utc);
+					return utc + LeapSecondTable::current().utcInterval(utc).tai_minus_utc;
+				}
+				return t + secondsToTicks(DeltaT::current().seconds(m_time)) - tt_minus_tai_ticks;
+			default:
+				return t - fixedOffsetFromTai(m_scale);
+		}
+	}
+
+	static auto fromTai(std::int64_t tai, TimeScale scale, const EarthOrientationParameters* eop) -> std::int64_t {
+		switch (scale) {
+			case TimeScale::UTC:
+				return tai - LeapSecondTable::current().taiInterval(tai).tai_minus_utc;
+			case TimeScale::UT1:
+				if (eop != nullptr) {
+					const std::int64_t utc = tai - LeapSecondTable::current().taiInterval(tai).tai_minus_utc;
+					return utc + secondsToTicks(eop->at(DateTime(utc)).ut1_utc);
+				} else {
+					const std::int64_t tt = tai + tt_minus_tai_ticks;
+					return tt - secondsToTicks(DeltaT::current().seconds(DateTime(tt)));
+				}
+			default:
+				return tai + fixedOffsetFromTai(scale);
+		}
+	}
+
+	static auto secondsToTicks(double seconds) -> std::int64_t {
+		return static_cast<std::int64_t>(std::llround(seconds * constant::ticks_per_second));
+	}
+};
+
+/**
+ * @brief 時刻列の時刻系を一括で変換する
+ * @note うるう秒の区間を保持し, 区間内の時刻は加算1回で変換する. 時刻は昇順である必要はないが, 昇順の場合に最も速い
+ * @remark UT1 は一定の差で表せないため扱わない (Instant::to を用いる)
+ */
+class TimeScaleConverter {
+  public:
+	/**
+	 * @brief Construct a new Time Scale Converter object
+	 *
+	 * @param from 変換元の時刻系
+	 * @param to 変換先の時刻系
+	 * @param table うるう秒の表
+	 */
+	TimeScaleConverter(TimeScale from, TimeScale to, const LeapSecondTable& table = LeapSecondTable::current())
+	  : m_from(from), m_to(to), m_table(&table), m_begin(0), m_end(0), m_offset(0) {
+		if (from == TimeScale::UT1 || to == TimeScale::UT1) {
+			throw DateTimeException("UT1 cannot be converted by a piecewise constant offset", DateTimeException::InvalidTimeScale);
+		}
+
+		if (from != TimeScale::UTC && to != TimeScale::UTC) {
+			m_begin = std::numeric_limits<std::int64_t>::min();
+			m_end = std::numeric_limits<std::int64_t>::max();
+			m_offset = Instant::fixedOffsetFromTai(to) - Instant::fixedOffsetFromTai(from);
+		}
+	}
+
+	/**
+	 * @brief 時刻を変換する
+	 *
+	 * @param ticks 変換元の時刻 [ticks]
+	 * @return std::int64_t 変換先の時刻 [ticks]
+	 */
+	auto convert(std::int64_t ticks) -> std::int64_t {
+		if (ticks < m_begin || ticks >= m_end) {
+			refresh(ticks);
+		}
+		return ticks + m_offset;
+	}
+
+	auto convert(const DateTime& dt) -> DateTime { return DateTime(convert(dt.ticks())); }
+
+	/**
+	 * @brief 時刻列を変換する
+	 *
+	 * @param in 変換元の時刻 [ticks]
+	 * @param out 変換先の時刻 [ticks] (in と同じでもよい)
+	 * @param count 個数
+	 */
+	void convert(const std::int64_t* in, std::int64_t* out, std::size_t count) {
+		for (std::size_t i = 0; i < count; i++) {
+			out[i] = convert(in[i]);
+		}
+	}
+
+	/**
+	 * @brief 時刻列をその場で変換する
+	 *
+	 * @param times 時刻列
+	 */
+	void convert(std::vector<DateTime>& times) {
+		for (auto& dt : times) {
+			dt = convert(dt);
+		}
+	}
+
+  private:
+	TimeScale m_from;
+	TimeScale m_to;
+	const LeapSecondTable* m_table;
+	std::int64_t m_begin;  // 変換元の時刻系での区間の開始 [ticks]
+	std::int64_t m_end;	   // 変換元の時刻系での区間の終了 [ticks]
+	std::int64_t m_offset; // 区間内の差 (変換先 - 変換元) [ticks]
+
+	void refresh(std::int64_t ticks) {
+		if (m_from == TimeScale::UTC) {
+			const auto interval = m_table->utcInterval(ticks);
+			m_begin = interval.begin;
+			m_end = interval.end;
+			m_offset = m_to == TimeScale::UTC ? 0 : interval.tai_minus_utc + Instant::fixedOffsetFromTai(m_to);
+		} else {
+			// 変換先が UTC: 変換元の時刻系での区間に直す
+			const std::int64_t from_offset = Instant::fixedOffsetFromTai(m_from);
+			const auto interval = m_table->taiInterval(ticks - from_offset);
+			m_begin = saturatingAdd(interval.begin, from_offset);
+			m_end = saturatingAdd(interval.end, from_offset);
+			m_offset = -from_offset - interval.tai_minus_utc;
+		}
+	}
+
+	static auto saturatingAdd(std::int64_t a, std::int64_t b) -> std::int64_t {
+		if (a == std::numeric_limits<std::int64_t>::min() || a == std::numeric_limits<std::int64_t>::max()) {
+			return a;
+		}
+		return a + b;
+	}
+};
+
+SATFIND_NAMESPACE_END
@@ -11,38 +11,74 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "DateTime.hpp"
 #include "Essential.hpp"
+#include "FixedString.hpp"
 
 SATFIND_NAMESPACE_BEGIN
 
+/**
+ * @brief TLE の行の内容
+ * @note 各行の長さは固定のため, 行をオブジェクト内の固定長領域に保持する
+ */
 struct TleLineField {
-	std::string name;
-	std::string tle1;
-	std::string tle2;
+	static constexpr unsigned name_line_length = 24;
+	static constexpr unsigned tle_line1_length = 69;
+	static constexpr unsigned tle_line2_length = 69;
 
-	TleLineField() : name(""), tle1(""), tle2("") {}
+	FixedString<name_line_length> name;
+	FixedString<tle_line1_length> tle1;
+	FixedString<tle_line2_length> tle2;
 
-	TleLineField(const std::string& name, const std::string& tle1, const std::string& tle2) : name(name), tle1(tle1), tle2(tle2) {}
+	TleLineField() {}
 
-	TleLineField(const std::string& tle1, const std::string& tle2) : name(""), tle1(tle1), tle2(tle2) {}
+	TleLineField(std::string_view name, std::string_view tle1, std::string_view tle2) { assign(name, tle1, tle2); }
 
-	TleLineField(std::istream& tle) : name(""), tle1(""), tle2("") { read(tle); }
+	TleLineField(std::string_view tle1, std::string_view tle2) { assign({}, tle1, tle2); }
 
-	static constexpr unsigned name_line_length = 24;
-	static constexpr unsigned tle_line1_length = 69;
-	static constexpr unsigned tle_line2_length = 69;
+	TleLineField(std::istream& tle) { read(tle); }
 
 	std::string toString() const {
-		if (name.empty()) {
-			return tle1 + "\n" + tle2;
-		} else {
-			return name + "\n" + tle1 + "\n" + tle2;
+		std::string ret;
+		ret.reserve(name.size() + tle1.size() + tle2.size() + 2);
+		if (!name.empty()) {
+			ret.append(name.view()).append("\n");
 		}
+		ret.append(tle1.view()).append("\n").append(tle2.view());
+		return ret;
+	}
+
+	/**
+	 * @brief 各行を代入する
+	 * @note 名前行の末尾の空白は取り除く
+	 *
+	 * @param name オブジェクト名
+	 * @param tle1 TLE 1行目
+	 * @param tle2 TLE 2行目
+	 */
+	void assign(std::string_view name, std::string_view tle1, std::string_view tle2) {
+		while (!name.empty() && name.back() == ' ') name.remove_suffix(1);
+
+		if (name.length() > name_line_length) {
+			throw TleException("Invalid TLE name", TleException::InvalidTleName);
+		}
+		if (tle1.length() != tle_line1_length) {
+			throw TleException("Invalid TLE line 1", TleException::InvalidTle1);
+		}
+		if (tle2.length() != tle_line2_length) {
+			throw TleException("Invalid TLE line 2", TleException::InvalidTle2);
+		}
+
+		this->name = name;
+		this->tle1 = tle1;
+		this->tle2 = tle2;
 	}
 
 	void read(std::istream& tle) {
@@ -84,13 +120,9 @@ struct TleLineField {
 		}
 
 		if (has_name_line_tle) {
-			name = tle_lines[0];
-			tle1 = tle_lines[1];
-			tle2 = tle_lines[2];
+			assign(tle_lines[0], tle_lines[1], tle_lines[2]);
 		} else {
-			name = "";
-			tle1 = tle_lines[0];
-			tle2 = tle_lines[1];
+			assign({}, tle_lines[0], tle_lines[1]);
 		}
 	}
 
@@ -105,27 +137,103 @@ struct TleLineField {
 	}
 };
 
+/**
+ * @brief TLE のチェックサム (各行末尾の mod 10) の扱い
+ *
+ */
+enum class TleChecksum {
+	Verify, // 一致しない場合は TleException を送出する
+	Ignore	// 一致しなくても読み込む (Tle::checksumValid() で確認できる)
+};
+
 class Tle {
   public:
-	Tle() : m_tle_line_field({}) {}
-
-	Tle(const std::string& name, const std::string& tle1, const std::string& tle2) : m_tle_line_field({name, tle1, tle2}) {
-		initialize(m_tle_line_field);
+	Tle() {}
+
+	Tle(const std::string& name, const std::string& tle1, const std::string& tle2) { initialize(name, tle1, tle2, TleChecksum::Ignore); }
+
+	Tle(const std::string& tle1, const std::string& tle2) { initialize({}, tle1, tle2, TleChecksum::Ignore); }
+
+	Tle(const TleLineField& tle) { initialize(tle); }
+
+	Tle(std::istream& tle) { initialize(TleLineField(tle)); }
+
+	/**
+	 * @brief 各行の部分文字列から TLE を読み込む
+	 * @note カタログファイルをメモリマップした領域などを, 行を複製せずに直接読み込むために使用する
+	 *
+	 * @param name オブジェクト名 (空の場合はカタログ番号を代用)
+	 * @param tle1 TLE 1行目 (改行文字を含まない)
+	 * @param tle2 TLE 2行目 (改行文字を含まない)
+	 * @param checksum チェックサムの扱い
+	 * @return Tle
+	 */
+	static auto parse(std::string_view name, std::string_view tle1, std::string_view tle2, TleChecksum checksum = TleChecksum::Verify)
+	  -> Tle {
+		Tle tle;
+		tle.initialize(name, tle1, tle2, checksum);
+		return tle;
 	}
 
-	Tle(const std::string& tle1, const std::string& tle2) : m_tle_line_field({"", tle1, tle2}) { initialize(m_tle_line_field); }
+	/**
+	 * @brief TLE で表せるカタログ番号の最大値 (Alpha-5 の Z9999)
+	 *
+	 */
+	static constexpr int max_catalog_number = 339999;
+
+	/**
+	 * @brief TLE のカタログ番号欄 (5文字) を整数に変換する
+	 * @note 先頭が英字の場合は Alpha-5 形式として扱う. 英字は I と O を除いた A-Z で, A = 10, ..., Z = 33 を上位桁とし,
+	 *       残り4桁と合わせて 100000 以上の番号を表す (例: A0001 -> 100001, Z9999 -> 339999)
+	 * @exception TleException 数字または Alpha-5 として不正な場合
+	 *
+	 * @param str カタログ番号欄
+	 * @return int カタログ番号
+	 */
+	static auto toCatalogNumber(std::string_view str) -> int {
+		if (str.empty() || !isAlpha5Letter(str[0])) {
+			return toInteger(str);
+		}
+		if (str.length() != tle1_len_catalog_number || !std::all_of(str.begin() + 1, str.end(), isDigit)) {
+			throw TleException("Invalid Alpha-5 catalog number", TleException::InvalidCatalogNumber);
+		}
+		return alpha5LetterValue(str[0]) * 10000 + toInteger(str.substr(1));
+	}
 
-	Tle(const TleLineField& tle) : m_tle_line_field(tle) { initialize(m_tle_line_field); }
+	/**
+	 * @brief カタログ番号を TLE のカタログ番号欄 (5文字) に変換する
+	 * @note 100000 以上の番号は Alpha-5 形式で表す. 99999 以下は0埋めの5桁
+	 * @exception TleException 負の番号または max_catalog_number を超える番号の場合
+	 *
+	 * @param catalog_number カタログ番号
+	 * @param out 出力先 (5文字, 終端文字は付加しない)
+	 */
+	static auto formatCatalogNumber(int catalog_number, char* out) -> void {
+		if (catalog_number < 0 || catalog_number > max_catalog_number) {
+			throw TleException("Catalog number out of TLE range", TleException::InvalidCatalogNumber);
+		}
+		int low = catalog_number % 10000;
+		const int high = catalog_number / 10000;
+		for (int i = 4; i > 0; i--) {
+			out[i] = static_cast<char>('0' + low % 10);
+			low /= 10;
+		}
+		out[0] = high < 10 ? static_cast<char>('0' + high) : alpha5_letters[high - 10];
+	}
 
-	Tle(std::istream& tle) : m_tle_line_field(tle) { initialize(m_tle_line_field); }
+	auto tleName() const -> std::string { return m_tle_line_field.name.str(); }
 
-	auto tleName() const -> std::string { return m_tle_line_field.name; }
+	auto tleLine1() const -> std::string { return m_tle_line_field.tle1.str(); }
 
-	auto tleLine1() const -> std::string { return m_tle_line_field.tle1; }
+	auto tleLine2() const -> std::string { return m_tle_line_field.tle2.str(); }
 
-	auto tleLine2() const -> std::string { return m_tle_line_field.tle2; }
+	auto name() const -> std::string { return m_name.str(); }
 
-	auto name() const -> std::string { return m_name; }
+	/**
+	 * @brief 1行目と2行目のチェックサムがともに一致するか
+	 *
+	 */
+	auto checksumValid() const -> bool { return m_checksum_valid; }
 
 	auto catalogNumber() const -> int { return m_catalog_number; }
 
@@ -161,9 +269,9 @@ class Tle {
 
 	auto toString() const -> std::string {
 		std::string ret = "";
-		ret += "TLE Name: " + m_name + "\n";
-		ret += "TLE Line 1: " + m_tle_line_field.tle1 + "\n";
-		ret += "TLE Line 2: " + m_tle_line_field.tle2 + "\n";
+		ret += "TLE Name: " + m_name.str() + "\n";
+		ret += "TLE Line 1: " + m_tle_line_field.tle1.str() + "\n";
+		ret += "TLE Line 2: " + m_tle_line_field.tle2.str() + "\n";
 		ret += "Catalog Number: " + std::to_string(m_catalog_number) + "\n";
 		ret += "Classification: " + std::string(1, m_classification) + "\n";
 		ret += "International Designator: " + m_international_designator + "\n";
@@ -187,14 +295,14 @@ class Tle {
 		std::string ret = "";
 		{
 			std::string tle_name;
-			tle_name = m_name;
+			tle_name = m_name.str();
 			for (unsigned i = 0; i < TleLineField::name_line_length - m_name.length(); i++) {
 				tle_name += " ";
 			}
 			ret += tle_name + "\n";
 		}
-		ret += m_tle_line_field.tle1 + "\n";
-		ret += m_tle_line_field.tle2 + "\n";
+		ret += m_tle_line_field.tle1.str() + "\n";
+		ret += m_tle_line_field.tle2.str() + "\n";
 		return ret;
 	}
 
@@ -215,7 +323,7 @@ class Tle {
 	TleLineField m_tle_line_field; // TLE 行フィールド
 
 	/* TLE Data */
-	std::string m_name;						// オブジェクト名
+	FixedString<TleLineField::name_line_length> m_name; // オブジェクト名
 	int m_catalog_number;					// 衛星カタログ番号
 	char m_classification;					// 機密区分
 	std::string m_international_designator; // 国際設計識別符号
@@ -232,6 +340,7 @@ class Tle {
 	double m_mean_anomaly;					// 平均近点角 [deg]
 	double m_mean_motion;					// 平均運動 [rev/day]
 	int m_revolution_number;				// 軌道回数 (not used)
+	bool m_checksum_valid = false;			// チェックサムが一致するか
 
 	/* 要素位置 TLE1 */
 	static constexpr unsigned tle1_pos_catalog_number = 2;
@@ -275,137 +384,122 @@ class Tle {
 	static constexpr unsigned tle2_pos_revolution_number = 63;
 	static constexpr unsigned tle2_len_revolution_number = 5;
 
-	auto isLineValid(const std::string& line, const unsigned number) -> bool {
-		switch (number) {
-
-			case 0:
-				if (line.length() >= TleLineField::name_line_length) {
-					return false;
-				} else {
-					return true;
-				}
-
-			case 1:
-				if (line.length() != TleLineField::tle_line1_length) {
-					return false;
-				} else {
-					if (line[0] != '1') {
-						return false;
-					} else {
-						return true;
-					}
-				}
-
-			case 2:
-				if (line.length() != TleLineField::tle_line2_length) {
-					return false;
-				} else {
-					if (line[0] != '2') {
-						return false;
-					} else {
-						return true;
-					}
-				}
-
-			default: return false;
+	/**
+	 * @brief 行の長さと行番号を検査し, 同じ走査でチェックサムを求める
+	 * @note チェックサムは末尾を除く各桁の数字の和と '-' の個数の和の1の位
+	 *
+	 * @param line TLE の行
+	 * @param number 行番号 ('1' または '2')
+	 * @param error_code 長さまたは行番号が不正な場合のエラーコード
+	 * @return bool チェックサムが一致するか
+	 */
+	static auto inspectLine(std::string_view line, const char number, const int error_code) -> bool {
+		const std::size_t length = number == '1' ? TleLineField::tle_line1_length : TleLineField::tle_line2_length;
+		if (line.length() != length || line[0] != number) {
+			throw TleException(std::string("Invalid TLE line ") + number, error_code);
 		}
-	}
 
-	auto isSameCatalogNumber(const TleLineField& tle, int& catalog_number) -> bool {
-		const auto tle1_cat_num = tle.tle1.substr(tle1_pos_catalog_number, tle1_len_catalog_number);
-		const auto tle2_cat_num = tle.tle2.substr(tle2_pos_catalog_number, tle2_len_catalog_number);
-		if (tle1_cat_num == tle2_cat_num) {
-			catalog_number = toInteger(m_tle_line_field.tle1.substr(tle1_pos_catalog_number, tle1_len_catalog_number));
-			return true;
-		} else {
-			catalog_number = 0;
-			return false;
+		unsigned sum = 0;
+		for (std::size_t i = 0; i + 1 < line.length(); i++) {
+			sum += checksum_weight[static_cast<unsigned char>(line[i])];
 		}
+		return isDigit(line.back()) && sum % 10 == static_cast<unsigned>(line.back() - '0');
 	}
 
-	auto initialize(const TleLineField& tle) -> void {
+	auto initialize(const TleLineField& tle) -> void { initialize(tle.name, tle.tle1, tle.tle2, TleChecksum::Ignore); }
+
+	/**
+	 * @brief 各行の部分文字列 (string_view) から要素を読み込む
+	 * @note 部分文字列を複製せずに数値へ変換する
+	 *
+	 * @param name オブジェクト名 (空の場合はカタログ番号を代用)
+	 * @param tle1 TLE 1行目
+	 * @param tle2 TLE 2行目
+	 * @param checksum チェックサムの扱い
+	 */
+	auto initialize(std::string_view name, std::string_view tle1, std::string_view tle2, TleChecksum checksum) -> void {
 		/* TLE line validation */
 		{
-			if (isLineValid(tle.name, 0)) {
-				m_tle_line_field.name = tle.name;
-			}
-
-			if (!isLineValid(tle.tle1, 1)) {
-				throw TleException("Invalid TLE line 1", TleException::InvalidTle1);
+			const bool checksum1 = inspectLine(tle1, '1', TleException::InvalidTle1);
+			const bool checksum2 = inspectLine(tle2, '2', TleException::InvalidTle2);
+			m_checksum_valid = checksum1 && checksum2;
+			if (!m_checksum_valid && checksum == TleChecksum::Verify) {
+				throw TleException("Checksum mismatch", TleException::InvalidChecksum);
 			}
 
-			if (!isLineValid(tle.tle2, 2)) {
-				throw TleException("Invalid TLE line 2", TleException::InvalidTle2);
-			}
+			m_tle_line_field.assign(name, tle1, tle2);
 		}
 
 		/* カタログ番号 */
 		{
-			if (!isSameCatalogNumber(tle, m_catalog_number)) {
+			const auto tle1_cat_num = tle1.substr(tle1_pos_catalog_number, tle1_len_catalog_number);
+			const auto tle2_cat_num = tle2.substr(tle2_pos_catalog_number, tle2_len_catalog_number);
+			if (tle1_cat_num != tle2_cat_num) {
 				throw TleException("Unmatched catalog number", TleException::UnmatchedCatalogNumber);
 			}
+			m_catalog_number = toCatalogNumber(tle1_cat_num);
 		}
 
 		/* 機密区分 */
-		{ m_classification = tle.tle1[tle1_pos_classification]; }
+		{ m_classification = tle1[tle1_pos_classification]; }
 
 		/* 国際設計識別符号 */
-		{ m_international_designator = tle.tle1.substr(tle1_pos_international_designator, tle1_len_international_designator); }
+		{ m_international_designator = tle1.substr(tle1_pos_international_designator, tle1_len_international_designator); }
 
 		/* オブジェクト名 */
 		{
-			if (!tle.name.empty()) {
-				m_name = tle.name;
+			if (!m_tle_line_field.name.empty()) {
+				m_name = m_tle_line_field.name;
 			} else {
-				m_name = tle.tle1.substr(tle1_pos_catalog_number, tle1_len_catalog_number); // オブジェクト名がない場合はカタログ番号を代用
+				m_name = tle1.substr(tle1_pos_catalog_number, tle1_len_catalog_number); // オブジェクト名がない場合はカタログ番号を代用
 			}
 		}
 
 		/* 軌道要素UTC元期 */
-		{ m_epoch = toDateTime(tle.tle1.substr(tle1_pos_epoch, tle1_len_epoch)); }
+		{ m_epoch = toDateTime(tle1.substr(tle1_pos_epoch, tle1_len_epoch)); }
 
 		/* 平均運動一次微分係数 (1/2) [rev/day^2] */
-		{ m_mean_motion_d2 = toDouble(tle.tle1.substr(tle1_pos_mean_motion_d2, tle1_len_mean_motion_d2)); }
+		{ m_mean_motion_d2 = toDouble(tle1.substr(tle1_pos_mean_motion_d2, tle1_len_mean_motion_d2)); }
 
 		/* 平均運動微二次分係数 (1/6) [rev/day^3] */
-		{ m_mean_motion_dd6 = toDouble(tle.tle1.substr(tle1_pos_mean_motion_dd6, tle1_len_mean_motion_dd6)); }
+		{ m_mean_motion_dd6 = toDouble(tle1.substr(tle1_pos_mean_motion_dd6, tle1_len_mean_motion_dd6)); }
 
 		/* B*係数 (SGP4弾道係数) */
-		{ m_bstar = toDouble(tle.tle1.substr(tle1_pos_bstar, tle1_len_bstar)); }
+		{ m_bstar = toDouble(tle1.substr(tle1_pos_bstar, tle1_len_bstar)); }
 
 		/* 軌道モデル (not used) */
-		{ m_ephemeris_type = toInteger(tle.tle1.substr(tle1_pos_ephemeris_type, tle1_len_ephemeris_type)); }
+		{ m_ephemeris_type = toInteger(tle1.substr(tle1_pos_ephemeris_type, tle1_len_ephemeris_type)); }
 
 		/* 要素番号 (not used) */
-		{ m_element_number = toInteger(tle.tle1.substr(tle1_pos_element_number, tle1_len_element_number)); }
+		{ m_element_number = toInteger(tle1.substr(tle1_pos_element_number, tle1_len_element_number)); }
 
 		/* 軌道傾斜角 [deg] */
-		{ m_inclination = toDouble(tle.tle2.substr(tle2_pos_inclination, tle2_len_inclination)); }
+		{ m_inclination = toDouble(tle2.substr(tle2_pos_inclination, tle2_len_inclination)); }
 
 		/* 昇交点赤経 [deg] */
-		{ m_right_ascension = toDouble(tle.tle2.substr(tle2_pos_right_ascension, tle2_len_right_ascension)); }
+		{ m_right_ascension = toDouble(tle2.substr(tle2_pos_right_ascension, tle2_len_right_ascension)); }
 
-		/* 離心率 */
-		{ m_eccentricity = toDouble("0." + tle.tle2.substr(tle2_pos_eccentricity, tle2_len_eccentricity)); }
+		/* 離心率 (小数点を省略した7桁) */
+		{ m_eccentricity = toImpliedDecimal(tle2.substr(tle2_pos_eccentricity, tle2_len_eccentricity)); }
 
 		/* 近地点引数 [deg] */
-		{ m_argument_perigee = toDouble(tle.tle2.substr(tle2_pos_argument_perigee, tle2_len_argument_perigee)); }
+		{ m_argument_perigee = toDouble(tle2.substr(tle2_pos_argument_perigee, tle2_len_argument_perigee)); }
 
 		/* 平均近点角 [deg] */
-		{ m_mean_anomaly = toDouble(tle.tle2.substr(tle2_pos_mean_anomaly, tle2_len_mean_anomaly)); }
+		{ m_mean_anomaly = toDouble(tle2.substr(tle2_pos_mean_anomaly, tle2_len_mean_anomaly)); }
 
 		/* 平均運動 [rev/day] */
-		{ m_mean_motion = toDouble(tle.tle2.substr(tle2_pos_mean_motion, tle2_len_mean_motion)); }
+		{ m_mean_motion = toDouble(tle2.substr(tle2_pos_mean_motion, tle2_len_mean_motion)); }
 
 		/* 軌道回数 (not used) */
-		{ m_revolution_number = toInteger(tle.tle2.substr(tle2_pos_revolution_number, tle2_len_revolution_number)); }
+		{ m_revolution_number = toInteger(tle2.substr(tle2_pos_revolution_number, tle2_len_revolution_number)); }
 	}
 
-	auto toInteger(const std::string& str) -> int {
+	static auto toInteger(std::string_view str) -> int {
 		int result = 0;
 		bool in_progress = false;
 		for (const auto& c : str) {
-			if (std::isdigit(c)) {
+			if (isDigit(c)) {
 				result *= 10;
 				result += c - '0';
 				in_progress = true;
@@ -422,104 +516,83 @@ class Tle {
 		}
 	}
 
-	auto toDouble(const std::string& str) -> double {
-		int sign_part = 1;
-		int integer_part = 0;
-		int decimal_part = 0;
-		int exponent_part = 0;
-		int divider = 1;
-		int pointer = 0;
-
-		enum { SpacePart, SignPart, IntegerPart, DecimalPart, FractionPart, ExponentialPart } state = SpacePart;
-
-		while (pointer < (int)str.length()) {
-			const auto c = str[pointer];
-
-			switch (state) {
-				case SpacePart:
-					if (c == ' ') {
-						pointer++;
-					} else {
-						state = SignPart;
-					}
-					break;
-
-				case SignPart:
-					if (c == '-') {
-						sign_part = -1;
-						pointer++;
-					} else if (c == '+' || c == ' ') {
-						sign_part = 1;
-						pointer++;
-					}
-					state = FractionPart;
-					break;
+	/**
+	 * @brief 小数点を省略した小数 (例: "0002146" -> 0.0002146) を変換する
+	 *
+	 */
+	static auto toImpliedDecimal(std::string_view str) -> double {
+		if (str.length() > max_integer_digits) {
+			throw TleException("Too many digits", TleException::InvalidIntegerString);
+		}
+		return toInteger(str) / power_of_ten[str.length()];
+	}
 
-				case IntegerPart:
-					if (std::isdigit(c)) {
-						integer_part *= 10;
-						integer_part += c - '0';
-						divider *= 10;
-						pointer++;
-					} else if (c == '.') {
-						state = DecimalPart;
-						divider = 1;
-						pointer++;
-					} else if (c == '-' || c == '+') {
-						state = ExponentialPart;
-						decimal_part = integer_part;
-						exponent_part = (c == '-') ? -1 : 1;
-						integer_part = 0;
-						pointer++;
-					} else {
-						throw TleException("Invalid integer part string", TleException::InvalidDoubleString);
-					}
-					break;
+	/**
+	 * @brief 数値文字列 (例: " 97.6430", "-.00002182", " 15105-3") を変換する
+	 * @note 仮数部を整数として読み込み, 10のべき乗の表で1回だけ除算する. 指数表記は小数点を省略した仮数部と1桁の指数とする
+	 *
+	 */
+	static auto toDouble(std::string_view str) -> double {
+		std::size_t pos = 0;
+		while (pos < str.length() && str[pos] == ' ') pos++;
+
+		double sign = 1.0;
+		if (pos < str.length() && (str[pos] == '-' || str[pos] == '+')) {
+			sign = str[pos] == '-' ? -1.0 : 1.0;
+			pos++;
+		}
 
-				case DecimalPart:
-					if (std::isdigit(c)) {
-						decimal_part *= 10;
-						decimal_part += c - '0';
-						divider *= 10;
-						pointer++;
-					} else {
-						throw TleException("Invalid decimal part string", TleException::InvalidDoubleString);
-					}
-					break;
+		std::int64_t mantissa = 0;
+		int digits = 0;
+		int integer_digits = -1; // 小数点より前の桁数 (小数点がない場合は -1)
+		for (; pos < str.length(); pos++) {
+			const char c = str[pos];
+			if (isDigit(c)) {
+				mantissa = mantissa * 10 + (c - '0');
+				digits++;
+			} else if (c == '.' && integer_digits < 0) {
+				integer_digits = digits;
+			} else if ((c == '-' || c == '+') && integer_digits < 0) {
+				break;
+			} else {
+				throw TleException("Invalid decimal string", TleException::InvalidDoubleString);
+			}
+		}
 
-				case FractionPart:
-					if (c == '.') {
-						state = DecimalPart;
-						pointer++;
-					} else {
-						state = IntegerPart;
-					}
-					break;
+		if (digits > max_mantissa_digits) {
+			throw TleException("Too many digits", TleException::InvalidDoubleString);
+		}
 
-				case ExponentialPart:
-					if (std::isdigit(c)) {
-						exponent_part *= (c - '0');
-						pointer++;
-					} else {
-						throw TleException("Invalid exponential part string", TleException::InvalidDoubleString);
-					}
-					break;
+		if (pos == str.length()) {
+			return sign * static_cast<double>(mantissa) / power_of_ten[integer_digits < 0 ? 0 : digits - integer_digits];
+		}
+		integer_digits = digits;
 
-				default: throw TleException("Invalid state", TleException::InvalidDoubleString);
+		/* 指数部 */
+		const int exponent_sign = str[pos] == '-' ? -1 : 1;
+		if (++pos == str.length()) {
+			throw TleException("Invalid exponential part string", TleException::InvalidExponentString);
+		}
+		int exponent = 0;
+		for (; pos < str.length(); pos++) {
+			if (!isDigit(str[pos]) || exponent * 10 + (str[pos] - '0') > max_exponent) {
+				throw TleException("Invalid exponential part string", TleException::InvalidExponentString);
 			}
+			exponent = exponent * 10 + (str[pos] - '0');
 		}
+		exponent *= exponent_sign;
 
-		if (state == ExponentialPart) {
-			return sign_part * (double)decimal_part / divider * std::pow(10.0, (double)exponent_part);
+		const int scale = integer_digits - exponent; // 仮数部は 0.XXXXX として扱う
+		if (scale >= 0) {
+			return sign * static_cast<double>(mantissa) / power_of_ten[scale];
 		} else {
-			return sign_part * ((double)integer_part + (double)decimal_part / (double)divider);
+			return sign * static_cast<double>(mantissa) * power_of_ten[-scale];
 		}
 	}
 
-
-	DateTime toDateTime(const std::string& str) {
+	static auto toDateTime(std::string_view str) -> DateTime {
 		std::int32_t year;
-		std::int32_t year_digit2 = std::stoi(str.substr(0, tle1_len_epoch_year));
+		std::int32_t year_digit2 = toInteger(str.substr(0, tle1_len_epoch_year));
 		double days = toDouble(str.substr(2, tle1_len_epoch_day));
 
 		// 2桁の年数を4桁に変換
@@ -531,6 +604,31 @@ class Tle {
 
 		return DateTime(year, days);
 	}
+
+	static auto isDigit(char c) -> bool { return c >= '0' && c <= '9'; }
+
+	/* Alpha-5 の上位桁に使用する英字 (10 ~ 33, 数字と紛らわしい I と O を除く) */
+	static constexpr char alpha5_letters[] = "ABCDEFGHJKLMNPQRSTUVWXYZ";
+
+	static auto isAlpha5Letter(char c) -> bool { return c >= 'A' && c <= 'Z' && c != 'I' && c != 'O'; }
+
+	static auto alpha5LetterValue(char c) -> int { return 10 + (c - 'A') - (c > 'I') - (c > 'O'); }
+
+	/* チェックサムの重み (数字はその値, '-' は1, その他は0) */
+	static constexpr auto checksum_weight = [] {
+		std::array<std::uint8_t, 256> weight{};
+		for (char c = '0'; c <= '9'; c++) {
+			weight[static_cast<unsigned char>(c)] = static_cast<std::uint8_t>(c - '0');
+		}
+		weight[static_cast<unsigned char>('-')] = 1;
+		return weight;
+	}();
+
+	static constexpr int max_mantissa_digits = 18;
+	static constexpr int max_exponent = 9;
+	static constexpr std::size_t max_integer_digits = 9;
+	static constexpr double power_of_ten[] = {1e0,	1e1,  1e2,	1e3,  1e4,	1e5,  1e6,	1e7,  1e8,	1e9,  1e10, 1e11, 1e12, 1e13,
+											  1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22, 1e23, 1e24, 1e25, 1e26, 1e27};
 };
 
 SATFIND_NAMESPACE_END
@@ -0,0 +1,233 @@
+/**
+ * @file TleCatalogReader.hpp
+ * @author fugu133
+ * @brief 複数の TLE を含むカタログファイルの読み込み
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Essential.hpp"
+#include "MappedFile.hpp"
+#include "Tle.hpp"
+#include "Tracing.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief カタログ中の不正なレコード
+ *
+ */
+struct TleCatalogError {
+	std::size_t line_number; // レコード先頭の行番号 (1始まり)
+	int error_code;			 // TleException のエラーコード
+	std::string message;	 // エラーメッセージ
+};
+
+/**
+ * @brief 複数の TLE を含むカタログの読み込み
+ * @note 2行形式 (2LE) と名前行付きの3行形式 (3LE) が混在したカタログを読み込む. 名前行の "0 " 接頭辞 (Space-Track の 3LE) と
+ *       末尾の空白は取り除く. ファイルはメモリマップして行を複製せずに解析する
+ * @remark 不正なレコード (チェックサムの不一致を含む) は読み飛ばして errors() に記録し, 読み込みを中断しない
+ */
+class TleCatalogReader {
+  public:
+	/**
+	 * @brief Construct a new Tle Catalog Reader object
+	 *
+	 * @param checksum チェックサムの扱い
+	 */
+	explicit TleCatalogReader(TleChecksum checksum = TleChecksum::Verify) : m_checksum(checksum) {}
+
+	/**
+	 * @brief Construct a new Tle Catalog Reader object
+	 *
+	 * @param path カタログファイルのパス
+	 * @param checksum チェックサムの扱い
+	 */
+	explicit TleCatalogReader(const std::string& path, TleChecksum checksum = TleChecksum::Verify) : m_checksum(checksum) {
+		readFile(path);
+	}
+
+	/**
+	 * @brief カタログファイルを読み込む
+	 * @note 読み込んだ TLE は elements() の末尾に追加する
+	 *
+	 * @param path カタログファイルのパス
+	 * @return std::size_t 読み込んだ TLE の数
+	 */
+	auto readFile(const std::string& path) -> std::size_t {
+		const MappedFile file(path);
+		return read(file.view());
+	}
+
+	/**
+	 * @brief カタログ文字列を読み込む
+	 * @note 読み込んだ TLE は elements() の末尾に追加する
+	 *
+	 * @param text カタログの内容
+	 * @return std::size_t 読み込んだ TLE の数
+	 */
+	auto read(std::string_view text) -> std::size_t {
+		Tracing::Span span("catalog", "TleCatalogReader::read", "bytes", static_cast<std::int64_t>(text.size()));
+		const std::size_t first = m_elements.size();
+		m_elements.reserve(first + text.size() / record_size_hint);
+
+		forEachRecord(
+		  text,
+		  [this](std::size_t line_number, std::string_view name, std::string_view tle1, std::string_view tle2) {
+			  try {
+				  m_elements.push_back(Tle::parse(name, tle1, tle2, m_checksum));
+			  } catch (const TleException& e) {
+				  m_errors.push_back({line_number, e.getReturnCode(), e.what()});
+			  } catch (const DateTimeException& e) {
+				  m_errors.push_back({line_number, TleException::InvalidTle1, e.what()});
+			  }
+		  },
+		  [this](std::size_t line_number, int error_code, const char* message) { m_errors.push_back({line_number, error_code, message}); });
+
+		return m_elements.size() - first;
+	}
+
+	/**
+	 * @brief 読み込んだ TLE を取得する
+	 *
+	 */
+	auto elements() const -> const std::vector<Tle>& { return m_elements; }
+
+	/**
+	 * @brief 読み込んだ TLE を取り出す
+	 * @note 取り出した後は elements() は空になる
+	 *
+	 */
+	auto takeElements() -> std::vector<Tle> { return std::move(m_elements); }
+
+	/**
+	 * @brief 読み飛ばした不正なレコードを取得する
+	 *
+	 */
+	auto errors() const -> const std::vector<TleCatalogError>& { return m_errors; }
+
+	auto clear() -> void {
+		m_elements.clear();
+		m_errors.clear();
+	}
+
+	/**
+	 * @brief カタログ中のレコードの境界を判定し, レコードごとに関数を呼び出す
+	 * @note 各行は text の部分文字列として渡す. 1行目は "1 ", 2行目は "2 " で始まり名前行より長い行とし, それ以外の空でない行を名前行とする
+	 *
+	 * @param text カタログの内容
+	 * @param record record(先頭行番号, 名前 (2LE の場合は空), 1行目, 2行目)
+	 * @param error error(行番号, TleException のエラーコード, メッセージ)
+	 */
+	template <class RecordFunction, class ErrorFunction>
+	static auto forEachRecord(std::string_view text, RecordFunction&& record, ErrorFunction&& error) -> void {
+		std::string_view name;
+		std::string_view tle1;
+		std::size_t name_line = 0;
+		std::size_t tle1_line = 0;
+		std::size_t line_number = 0;
+
+		const auto flushName = [&] {
+			if (name_line != 0) {
+				error(name_line, TleException::InvalidTleLine, "Name line without element lines");
+				name_line = 0;
+			}
+		};
+		const auto flushLine1 = [&] {
+			if (tle1_line != 0) {
+				error(name_line != 0 ? name_line : tle1_line, TleException::InvalidTle2, "Missing TLE line 2");
+				name_line = 0;
+				tle1_line = 0;
+			}
+		};
+
+		std::size_t pos = 0;
+		while (pos < text.size()) {
+			const char* begin = text.data() + pos;
+			const char* newline = static_cast<const char*>(std::memchr(begin, '\n', text.size() - pos));
+			const std::size_t length = newline != nullptr ? static_cast<std::size_t>(newline - begin) : text.size() - pos;
+			pos += length + 1;
+			line_number++;
+
+			const std::string_view line = trimRight(std::string_view(begin, length));
+			if (line.empty()) {
+				continue;
+			}
+
+			switch (classify(line)) {
+				case LineKind::Line1:
+					flushLine1();
+					tle1 = line;
+					tle1_line = line_number;
+					break;
+
+				case LineKind::Line2:
+					if (tle1_line == 0) {
+						flushName();
+						error(line_number, TleException::InvalidTle1, "TLE line 2 without line 1");
+						break;
+					}
+					record(name_line != 0 ? name_line : tle1_line, name_line != 0 ? name : std::string_view(), tle1, line);
+					name_line = 0;
+					tle1_line = 0;
+					break;
+
+				case LineKind::Name:
+					flushLine1();
+					flushName();
+					name = line.substr(0, 2) == "0 " ? trimLeft(line.substr(2)) : line;
+					name_line = line_number;
+					break;
+			}
+		}
+
+		flushLine1();
+		flushName();
+	}
+
+  private:
+	std::vector<Tle> m_elements;		   // 読み込んだ TLE
+	std::vector<TleCatalogError> m_errors; // 読み飛ばしたレコード
+	TleChecksum m_checksum;				   // チェックサムの扱い
+
+	// 2LE の1レコードのバイト数 (要素数の見積もりに使用)
+	static constexpr std::size_t record_size_hint = TleLineField::tle_line1_length + TleLineField::tle_line2_length + 2;
+
+	enum class LineKind { Name, Line1, Line2 };
+
+	static auto classify(std::string_view line) -> LineKind {
+		if (line.size() > TleLineField::name_line_length && line[1] == ' ') {
+			if (line[0] == '1') {
+				return LineKind::Line1;
+			} else if (line[0] == '2') {
+				return LineKind::Line2;
+			}
+		}
+		return LineKind::Name;
+	}
+
+	static auto trimRight(std::string_view str) -> std::string_view {
+		std::size_t n = str.size();
+		while (n > 0 && (str[n - 1] == ' ' || str[n - 1] == '\t' || str[n - 1] == '\r')) n--;
+		return str.substr(0, n);
+	}
+
+	static auto trimLeft(std::string_view str) -> std::string_view {
+		std::size_t n = 0;
+		while (n < str.size() && (str[n] == ' ' || str[n] == '\t')) n++;
+		return str.substr(n);
+	}
+};
+
+SATFIND_NAMESPACE_END
@@ -0,0 +1,382 @@
+/**
+ * @file TleWriter.hpp
+ * @author fugu133
+ * @brief 軌道要素の TLE 形式への書き出し
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "AngleHelper.hpp"
+#include "DateTime.hpp"
+#include "Essential.hpp"
+#include "FixedString.hpp"
+#include "OmmReader.hpp"
+#include "OrbitalElements.hpp"
+#include "Tle.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief TLE に書き出す軌道要素以外の項目
+ * @note OrbitalElements が持たない識別情報と, SGP4 では使用しない平均運動の微分係数を保持する
+ */
+struct TleMetadata {
+	int catalog_number;		   // カタログ番号 (Alpha-5 形式で 339999 まで)
+	char classification;	   // 機密区分
+	FixedString<8> designator; // 国際識別符号 (TLE 形式, 例: 98067A)
+	int ephemeris_type;		   // 軌道モデル
+	int element_number;		   // 要素セット番号 (下位4桁を書き出す)
+	int revolution_number;	   // 元期における周回数 (下位5桁を書き出す)
+	double mean_motion_d2;	   // 平均運動の1次微分 / 2 [rev/day^2]
+	double mean_motion_dd6;	   // 平均運動の2次微分 / 6 [rev/day^3]
+
+	TleMetadata()
+	  : catalog_number(0),
+		classification('U'),
+		designator(),
+		ephemeris_type(0),
+		element_number(0),
+		revolution_number(0),
+		mean_motion_d2(0.0),
+		mean_motion_dd6(0.0) {}
+
+	static auto fromTle(const Tle& tle) -> TleMetadata {
+		TleMetadata m;
+		m.catalog_number = tle.catalogNumber();
+		m.classification = tle.classification();
+		m.designator = trimDesignator(tle.internationalDesignator());
+		m.ephemeris_type = tle.ephemerisType();
+		m.element_number = tle.elementNumber();
+		m.revolution_number = tle.revolutionNumber();
+		m.mean_motion_d2 = tle.meanMotionD2();
+		m.mean_motion_dd6 = tle.meanMotionDd6();
+		return m;
+	}
+
+	/**
+	 * @brief OMM レコードから項目を取得する
+	 * @note 国際識別符号は OMM 形式 (1998-067A) から TLE 形式 (98067A) に変換する
+	 *
+	 * @param record OMM レコード
+	 * @return TleMetadata
+	 */
+	static auto fromOmm(const OmmRecord& record) -> TleMetadata {
+		TleMetadata m;
+		m.catalog_number = record.norad_cat_id;
+		m.classification = record.classification;
+		std::string_view id = record.object_id.view();
+		if (id.size() > 5 && id[4] == '-') {
+			char buf[8];
+			const std::size_t n = std::min<std::size_t>(id.size() - 3, sizeof(buf));
+			buf[0] = id[2];
+			buf[1] = id[3];
+			std::memcpy(buf + 2, id.data() + 5, n - 2);
+			m.designator = std::string_view(buf, n);
+		} else {
+			m.designator = trimDesignator(id);
+		}
+		m.ephemeris_type = record.ephemeris_type;
+		m.element_number = record.element_set_no;
+		m.revolution_number = static_cast<int>(record.rev_at_epoch % 100000);
+		m.mean_motion_d2 = record.mean_motion_dot;
+		m.mean_motion_dd6 = record.mean_motion_ddot;
+		return m;
+	}
+
+  private:
+	static auto trimDesignator(std::string_view str) -> std::string_view {
+		while (!str.empty() && str.back() == ' ') str.remove_suffix(1);
+		return str.substr(0, 8);
+	}
+};
+
+/**
+ * @brief 軌道要素を TLE 形式で書き出す
+ * @note 呼び出し側のバッファに各欄を桁位置どおりに直接書き込むため, 文字列の連結やメモリ確保を行わない.
+ *       角度や平均運動は TLE の桁数に丸める. 指数欄 (B*, 平均運動の微分係数) は仮数5桁と指数1桁の小数点省略形式で書き出す
+ */
+class TleWriter {
+  public:
+	static constexpr std::size_t line_length = 69;											  // 1行目・2行目の長さ
+	static constexpr std::size_t name_length = TleLineField::name_line_length;				  // オブジェクト名の長さ
+	static constexpr std::size_t max_record_length = name_length + 1 + 2 * (line_length + 1); // 3LE 1件の最大長 (改行を含む)
+
+	/**
+	 * @brief 1行目と2行目を書き出す
+	 * @exception TleException カタログ番号や各欄の値が TLE で表せない場合
+	 *
+	 * @param elements 軌道要素
+	 * @param metadata 軌道要素以外の項目
+	 * @param line1 1行目の出力先 (line_length 文字, 終端文字は付加しない)
+	 * @param line2 2行目の出力先 (line_length 文字, 終端文字は付加しない)
+	 */
+	static auto formatLines(const OrbitalElements& elements, const TleMetadata& metadata, char* line1, char* line2) -> void {
+		std::memset(line1, ' ', line_length);
+		std::memset(line2, ' ', line_length);
+
+		/* 1行目 */
+		line1[0] = '1';
+		Tle::formatCatalogNumber(metadata.catalog_number, line1 + 2);
+		line1[7] = metadata.classification;
+		std::memcpy(line1 + 9, metadata.designator.view().data(), std::min<std::size_t>(metadata.designator.size(), 8));
+		writeEpoch(line1 + 18, elements.epoch);
+		writeFirstDerivative(line1 + 33, metadata.mean_motion_d2);
+		writeExponent(line1 + 44, metadata.mean_motion_dd6);
+		writeExponent(line1 + 53, elements.b_star);
+		line1[62] = static_cast<char>('0' + metadata.ephemeris_type % 10);
+		writeUnsigned(line1 + 64, static_cast<std::uint64_t>(metadata.element_number % 10000), 4, ' ');
+		line1[68] = checksum(std::string_view(line1, line_length - 1));
+
+		/* 2行目 */
+		line2[0] = '2';
+		std::memcpy(line2 + 2, line1 + 2, 5);
+		writeAngle(line2 + 8, elements.inclination);
+		writeAngle(line2 + 17, elements.ascending_node);
+		writeFraction(line2 + 26, elements.eccentricity, 7);
+		writeAngle(line2 + 34, elements.argument_perigee);
+		writeAngle(line2 + 43, elements.mean_anomaly);
+		writeMeanMotion(line2 + 52, elements.mean_motion * constant::minutes_per_day / constant::pi2);
+		writeUnsigned(line2 + 63, static_cast<std::uint64_t>(metadata.revolution_number % 100000), 5, ' ');
+		line2[68] = checksum(std::string_view(line2, line_length - 1));
+	}
+
+	/**
+	 * @brief オブジェクト名と1行目・2行目を改行区切りで書き出す
+	 * @note オブジェクト名が空の場合は 2LE 形式 (名前行なし) で書き出す. 名前は name_length 文字に空白で埋める
+	 * @exception TleException オブジェクト名が name_length 文字を超える場合, または formatLines() が失敗した場合
+	 *
+	 * @param name オブジェクト名
+	 * @param elements 軌道要素
+	 * @param metadata 軌道要素以外の項目
+	 * @param out 出力先 (max_record_length 文字以上)
+	 * @return std::size_t 書き出した文字数
+	 */
+	static auto format(std::string_view name, const OrbitalElements& elements, const TleMetadata& metadata, char* out) -> std::size_t {
+		char* p = out;
+		if (!name.empty()) {
+			if (name.size() > name_length) {
+				throw TleException("Invalid TLE name", TleException::InvalidTleName);
+			}
+			std::memcpy(p, name.data(), name.size());
+			std::memset(p + name.size(), ' ', name_length - name.size());
+			p += name_length;
+			*p++ = '\n';
+		}
+		formatLines(elements, metadata, p, p + line_length + 1);
+		p[line_length] = '\n';
+		p[2 * line_length + 1] = '\n';
+		return static_cast<std::size_t>(p + 2 * (line_length + 1) - out);
+	}
+
+	/**
+	 * @brief 文字列の末尾に書き出す
+	 *
+	 * @param out 出力先
+	 * @param name オブジェクト名 (空の場合は 2LE 形式)
+	 * @param elements 軌道要素
+	 * @param metadata 軌道要素以外の項目
+	 */
+	static auto append(std::string& out, std::string_view name, const OrbitalElements& elements, const TleMetadata& metadata) -> void {
+		const std::size_t size = out.size();
+		out.resize(size + max_record_length);
+		out.resize(size + format(name, elements, metadata, out.data() + size));
+	}
+
+	/**
+	 * @brief TLE を構築する
+	 *
+	 * @param name オブジェクト名 (空の場合はカタログ番号を代用)
+	 * @param elements 軌道要素
+	 * @param metadata 軌道要素以外の項目
+	 * @return Tle
+	 */
+	static auto toTle(std::string_view name, const OrbitalElements& elements, const TleMetadata& metadata) -> Tle {
+		char line1[line_length];
+		char line2[line_length];
+		formatLines(elements, metadata, line1, line2);
+		return Tle::parse(name, std::string_view(line1, line_length), std::string_view(line2, line_length));
+	}
+
+	/**
+	 * @brief 行のチェックサム (数字の和と '-' の個数の mod 10)
+	 *
+	 * @param line チェックサムを除いた行
+	 * @return char チェックサムの数字
+	 */
+	static auto checksum(std::string_view line) -> char {
+		unsigned sum = 0;
+		for (const char c : line) {
+			sum += checksum_weight[static_cast<unsigned char>(c)];
+		}
+		return static_cast<char>('0' + sum % 10);
+	}
+
+  private:
+	static constexpr std::int64_t ticks_per_epoch_digit = constant::ticks_per_day / 100000000; // 元期の最小桁 (1e-8 日)
+
+	/**
+	 * @brief 固定桁の10進数を右詰めで書き込む
+	 * @note fill が '0' 以外の場合は上位の0を fill で置き換える (最下位桁は残す)
+	 * @exception TleException 値が桁数に収まらない場合
+	 */
+	static auto writeUnsigned(char* out, std::uint64_t value, int digits, char fill) -> void {
+		for (int i = digits - 1; i >= 0; i--) {
+			out[i] = static_cast<char>('0' + value % 10);
+			value /= 10;
+		}
+		if (value != 0) {
+			throw TleException("TLE field out of range", TleException::FieldOutOfRange);
+		}
+		for (int i = 0; i < digits - 1 && out[i] == '0'; i++) {
+			out[i] = fill;
+		}
+	}
+
+	/**
+	 * @brief 元期 (YYDDD.DDDDDDDD, 14文字)
+	 * @note 1e-8 日 (864 us) 単位に丸めてから年と通日を求めるため, 丸めで年をまたぐ場合も正しく書き出す
+	 */
+	static auto writeEpoch(char* out, const DateTime& epoch) -> void {
+		const std::int64_t ticks = (epoch.ticks() + ticks_per_epoch_digit / 2) / ticks_per_epoch_digit * ticks_per_epoch_digit;
+		const int year = DateTime(ticks).year();
+		if (year < 1957 || year > 2056) {
+			throw TleException("TLE epoch out of range", TleException::FieldOutOfRange);
+		}
+		const std::int64_t elapsed = ticks - DateTime(year, 1, 1, 0, 0, 0).ticks();
+		writeUnsigned(out, static_cast<std::uint64_t>(year % 100), 2, '0');
+		writeUnsigned(out + 2, static_cast<std::uint64_t>(elapsed / constant::ticks_per_day + 1), 3, '0');
+		out[5] = '.';
+		writeUnsigned(out + 6, static_cast<std::uint64_t>(elapsed % constant::ticks_per_day / ticks_per_epoch_digit), 8, '0');
+	}
+
+	/**
+	 * @brief 小数部のみの固定小数 (先頭の "0." を省略)
+	 *
+	 */
+	static auto writeFraction(char* out, double value, int digits) -> void {
+		const double scaled = std::round(value * power_of_ten[digits]);
+		if (!(scaled >= 0.0 && scaled < power_of_ten[digits])) {
+			throw TleException("TLE field out of range", TleException::FieldOutOfRange);
+		}
+		writeUnsigned(out, static_cast<std::uint64_t>(scaled), digits, '0');
+	}
+
+	/**
+	 * @brief 平均運動の1次微分係数 (符号と小数点付き8桁, 10文字)
+	 *
+	 */
+	static auto writeFirstDerivative(char* out, double value) -> void {
+		out[0] = std::signbit(value) ? '-' : ' ';
+		out[1] = '.';
+		writeFraction(out + 2, std::fabs(value), 8);
+	}
+
+	/**
+	 * @brief 小数点を省略した指数表記 (符号, 仮数5桁, 指数の符号と1桁, 8文字)
+	 * @note 値を 0.NNNNN x 10^e と表す. 例: 3.8757e-4 -> " 38757-3". 指数が -9 より小さい値は0とする
+	 */
+	static auto writeExponent(char* out, double value) -> void {
+		const double magnitude = std::fabs(value);
+		if (!(magnitude < 1e10)) {
+			throw TleException("TLE field out of range", TleException::FieldOutOfRange);
+		}
+		if (magnitude < 0.5e-14) {
+			std::memcpy(out, " 00000+0", 8);
+			return;
+		}
+		// 仮数 (5桁) が 10000 以上 100000 未満になるように指数を決める
+		int exponent = static_cast<int>(std::upper_bound(std::begin(exponent_threshold), std::end(exponent_threshold), magnitude) -
+										std::begin(exponent_threshold)) -
+					   15;
+		std::int64_t mantissa = scaleToMantissa(magnitude, exponent);
+		if (mantissa >= 100000) {
+			mantissa = scaleToMantissa(magnitude, ++exponent);
+		} else if (mantissa < 10000) {
+			mantissa = scaleToMantissa(magnitude, --exponent);
+		}
+		if (exponent < -9) {
+			std::memcpy(out, " 00000+0", 8);
+			return;
+		}
+		if (exponent > 9) {
+			throw TleException("TLE field out of range", TleException::FieldOutOfRange);
+		}
+		out[0] = value < 0.0 ? '-' : ' ';
+		writeUnsigned(out + 1, static_cast<std::uint64_t>(mantissa), 5, '0');
+		out[6] = exponent < 0 ? '-' : '+';
+		out[7] = static_cast<char>('0' + std::abs(exponent));
+	}
+
+	/**
+	 * @brief magnitude x 10^(5 - exponent) を整数に丸める
+	 *
+	 */
+	static auto scaleToMantissa(double magnitude, int exponent) -> std::int64_t {
+		const int scale = 5 - exponent;
+		return std::llround(scale >= 0 ? magnitude * power_of_ten[scale] : magnitude / power_of_ten[-scale]);
+	}
+
+	/**
+	 * @brief 角度 (NNN.NNNN, 8文字)
+	 * @note [0, 360) に正規化してから小数4桁に丸める
+	 */
+	static auto writeAngle(char* out, double radian) -> void {
+		constexpr std::int64_t full_circle = 3600000;
+		std::int64_t units = std::llround(AngleHelper::radianToDegree(radian) * 1e4) % full_circle;
+		if (units < 0) {
+			units += full_circle;
+		}
+		writeUnsigned(out, static_cast<std::uint64_t>(units / 10000), 3, ' ');
+		out[3] = '.';
+		writeUnsigned(out + 4, static_cast<std::uint64_t>(units % 10000), 4, '0');
+	}
+
+	/**
+	 * @brief 平均運動 [rev/day] (NN.NNNNNNNN, 11文字)
+	 *
+	 */
+	static auto writeMeanMotion(char* out, double rev_per_day) -> void {
+		const double units = std::round(rev_per_day * 1e8);
+		if (!(units >= 0.0 && units < 1e10)) {
+			throw TleException("TLE field out of range", TleException::FieldOutOfRange);
+		}
+		const auto u = static_cast<std::uint64_t>(units);
+		writeUnsigned(out, u / 100000000, 2, ' ');
+		out[2] = '.';
+		writeUnsigned(out + 3, u % 100000000, 8, '0');
+	}
+
+	/* チェックサムの重み (数字はその値, '-' は1, その他は0) */
+	static constexpr auto checksum_weight = [] {
+		std::array<std::uint8_t, 256> weight{};
+		for (char c = '0'; c <= '9'; c++) {
+			weight[static_cast<unsigned char>(c)] = static_cast<std::uint8_t>(c - '0');
+		}
+		weight[static_cast<unsigned char>('-')] = 1;
+		return weight;
+	}();
+
+	/* 指数の境界 (10^-15 ~ 10^9). 境界以上の要素数から指数の概算値を求める */
+	static constexpr double exponent_threshold[] = {1e-15, 1e-14, 1e-13, 1e-12, 1e-11, 1e-10, 1e-9, 1e-8, 1e-7,
+													1e-6,  1e-5,  1e-4,  1e-3,  1e-2,  1e-1,  1e0,	1e1,  1e2,
+													1e3,   1e4,	  1e5,	 1e6,	1e7,   1e8,	  1e9};
+
+	static constexpr double power_of_ten[] = {1e0,	1e1,  1e2,	1e3,  1e4,	1e5,  1e6,	1e7,  1e8,	1e9,  1e10,
+											  1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20};
+};
+
+SATFIND_NAMESPACE_END
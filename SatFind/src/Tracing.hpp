@@ -0,0 +1,272 @@
+/**
+ * @file Tracing.hpp
+ * @author fugu133
+ * @brief 処理区間のトレース
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Essential.hpp"
+
+SATFIND_NAMESPACE_BEGIN
+
+/**
+ * @brief トレースの1イベント (区間の開始または終了)
+ */
+struct TraceEvent {
+	const char* category;	// 分類 ("catalog", "propagation", "pass", "io")
+	const char* name;		// 区間の名前
+	std::int64_t timestamp; // std::chrono::steady_clock の時刻 [ns]
+	std::uint32_t thread;	// スレッドの番号 (Tracing::threadId())
+	const char* arg_name;	// 引数の名前 (なければ nullptr)
+	std::int64_t arg;		// 引数の値 (件数, バイト数など)
+};
+
+/**
+ * @brief トレースの出力先
+ * @note 区間の開始と終了は同じスレッドから入れ子の順に通知される. 複数のスレッドから同時に呼び出されるため, 実装はスレッド安全に
+ *       すること
+ */
+class TraceSink {
+  public:
+	virtual ~TraceSink() = default;
+
+	/**
+	 * @brief 区間の開始
+	 *
+	 * @param event イベント
+	 */
+	virtual auto begin(const TraceEvent& event) -> void = 0;
+
+	/**
+	 * @brief 区間の終了
+	 * @note 引数は終了時に設定したもの (Tracing::Span::setArg())
+	 *
+	 * @param event イベント
+	 */
+	virtual auto end(const TraceEvent& event) -> void = 0;
+};
+
+/**
+ * @brief カタログ読み込み, 伝搬, パス探索, ファイル書き込みの区間をトレースする
+ * @note SATFIND_ENABLE_TRACING を定義してビルドした場合のみ出力先を呼び出す. 未定義の場合は Span が空のクラスになり,
+ *       呼び出し箇所に命令は生成されない. 定義した場合も, 出力先を設定していなければ区間ごとの処理は原子変数の読み込み1回のみ
+ * @remark SATFIND_ENABLE_TRACING はすべての翻訳単位で同じように定義すること
+ */
+class Tracing {
+  public:
+#if defined(SATFIND_ENABLE_TRACING)
+	static constexpr bool enabled = true;
+#else
+	static constexpr bool enabled = false;
+#endif
+
+	/**
+	 * @brief 出力先を設定する
+	 * @note 出力先の寿命は呼び出し側が管理する. 区間の途中で出力先を変更した場合, 区間の終了は開始時の出力先に通知する.
+	 *       出力先を破棄する前に nullptr を設定し, 実行中の区間がないことを確認すること
+	 *
+	 * @param sink 出力先 (nullptr で無効)
+	 * @return TraceSink* 以前の出力先
+	 */
+	static auto setSink([[maybe_unused]] TraceSink* sink) -> TraceSink* {
+#if defined(SATFIND_ENABLE_TRACING)
+		return currentSink().exchange(sink, std::memory_order_acq_rel);
+#else
+		return nullptr;
+#endif
+	}
+
+	/**
+	 * @brief 現在の出力先を取得する
+	 *
+	 * @return TraceSink* 出力先 (未設定または無効の場合は nullptr)
+	 */
+	static auto sink() -> TraceSink* {
+#if defined(SATFIND_ENABLE_TRACING)
+		return currentSink().load(std::memory_order_acquire);
+#else
+		return nullptr;
+#endif
+	}
+
+	/**
+	 * @brief 呼び出したスレッドの番号を取得する
+	 * @note 最初に呼び出した順に 1 から振る
+	 *
+	 * @return std::uint32_t スレッドの番号
+	 */
+	static auto threadId() -> std::uint32_t {
+		static std::atomic<std::uint32_t> next{1};
+		thread_local const std::uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+		return id;
+	}
+
+	static auto now() -> std::int64_t {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	/**
+	 * @brief 構築から破棄までの区間
+	 * @note 例外で抜けた場合も終了を通知する
+	 */
+	class Span {
+	  public:
+#if defined(SATFIND_ENABLE_TRACING)
+		Span(const char* category, const char* name) : Span(category, name, nullptr, 0) {}
+
+		Span(const char* category, const char* name, const char* arg_name, std::int64_t arg)
+		  : m_sink(Tracing::sink()), m_event{category, name, 0, 0, arg_name, arg} {
+			if (m_sink) {
+				m_event.thread = threadId();
+				m_event.timestamp = now();
+				m_sink->begin(m_event);
+			}
+		}
+
+		~Span() {
+			if (m_sink) {
+				m_event.timestamp = now();
+				m_sink->end(m_event);
+			}
+		}
+
+		/**
+		 * @brief 終了時に通知する引数を設定する
+		 *
+		 * @param arg_name 引数の名前 (静的な文字列)
+		 * @param arg 引数の値
+		 */
+		auto setArg(const char* arg_name, std::int64_t arg) -> void {
+			m_event.arg_name = arg_name;
+			m_event.arg = arg;
+		}
+
+	  private:
+		TraceSink* m_sink;
+		TraceEvent m_event;
+#else
+		Span(const char*, const char*) {}
+
+		Span(const char*, const char*, const char*, std::int64_t) {}
+
+		auto setArg(const char*, std::int64_t) -> void {}
+#endif
+	  public:
+		Span(const Span&) = delete;
+		auto operator=(const Span&) -> Span& = delete;
+	};
+
+  private:
+#if defined(SATFIND_ENABLE_TRACING)
+	static auto currentSink() -> std::atomic<TraceSink*>& {
+		static std::atomic<TraceSink*> sink{nullptr};
+		return sink;
+	}
+#endif
+};
+
+/**
+ * @brief Chrome のトレースイベント形式 (JSON) で出力する出力先
+ * @note イベントをメモリに蓄え, write() でまとめて書き出す. chrome://tracing や Perfetto で読み込める.
+ *       イベントの追加は mutex で保護する
+ */
+class ChromeTraceSink : public TraceSink {
+  public:
+	ChromeTraceSink() : m_origin(Tracing::now()) {}
+
+	auto begin(const TraceEvent& event) -> void override { push('B', event); }
+
+	auto end(const TraceEvent& event) -> void override { push('E', event); }
+
+	/**
+	 * @brief 蓄えたイベントの数を取得する
+	 *
+	 * @return std::size_t イベントの数
+	 */
+	auto size() const -> std::size_t {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_events.size();
+	}
+
+	/**
+	 * @brief 蓄えたイベントを破棄する
+	 */
+	auto clear() -> void {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_events.clear();
+	}
+
+	/**
+	 * @brief トレースイベント形式で書き出す
+	 * @note 時刻は出力先を構築した時刻からの経過時間 [us]
+	 *
+	 * @param os 出力先
+	 */
+	auto write(std::ostream& os) const -> void {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		os << "{\"traceEvents\":[";
+		char ts[32];
+		for (std::size_t i = 0; i < m_events.size(); i++) {
+			const auto& r = m_events[i];
+			const auto& e = r.event;
+			std::snprintf(ts, sizeof(ts), "%.3f", static_cast<double>(e.timestamp - m_origin) * 1e-3);
+			os << (i == 0 ? "\n" : ",\n") << "{\"name\":\"" << e.name << "\",\"cat\":\"" << e.category << "\",\"ph\":\"" << r.phase
+			   << "\",\"ts\":" << ts << ",\"pid\":1,\"tid\":" << e.thread;
+			if (e.arg_name) {
+				os << ",\"args\":{\"" << e.arg_name << "\":" << e.arg << "}";
+			}
+			os << "}";
+		}
+		os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+	}
+
+	/**
+	 * @brief トレースイベント形式でファイルに書き出す
+	 * @exception IoException ファイルを開けない, または書き込めない場合
+	 *
+	 * @param path 出力先のパス
+	 */
+	auto write(const std::string& path) const -> void {
+		std::ofstream ofs(path, std::ios::trunc);
+		if (!ofs) {
+			throw IoException("Cannot open file: " + path, IoException::FileOpenError);
+		}
+		write(ofs);
+		if (!ofs) {
+			throw IoException("Cannot write file: " + path, IoException::FileWriteError);
+		}
+	}
+
+  private:
+	struct Record {
+		char phase; // 'B' (開始) または 'E' (終了)
+		TraceEvent event;
+	};
+
+	mutable std::mutex m_mutex;	  // m_events の保護
+	std::vector<Record> m_events; // 蓄えたイベント
+	std::int64_t m_origin;		  // 時刻の基準 [ns]
+
+	auto push(char phase, const TraceEvent& event) -> void {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_events.push_back(Record{phase, event});
+	}
+};
+
+SATFIND_NAMESPACE_END
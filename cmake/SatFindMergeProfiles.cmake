@@ -0,0 +1,12 @@
+# Clang の PGO 学習で出力された *.profraw を satfind.profdata にまとめる
+# cmake -DPROFDATA=<llvm-profdata> -DPROFILE_DIR=<dir> -P SatFindMergeProfiles.cmake
+
+file(GLOB raw_profiles "${PROFILE_DIR}/*.profraw")
+if(NOT raw_profiles)
+	message(FATAL_ERROR "No *.profraw files in ${PROFILE_DIR}; run the training workloads first")
+endif()
+
+execute_process(COMMAND "${PROFDATA}" merge -output=${PROFILE_DIR}/satfind.profdata ${raw_profiles} RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "llvm-profdata merge failed (${result})")
+endif()
@@ -0,0 +1,66 @@
+# 最適化ビルドの設定 (CMakePresets.json の native / lto / pgo-* から使用する)
+#
+# satfind_build_options: satfind と例・ベンチマークにのみ適用するコンパイル・リンクオプション.
+# install/export には含めないため, インストールしたライブラリの利用者には伝播しない
+
+option(SATFIND_NATIVE_ARCH "Compile for the host CPU (-march=native)" OFF)
+option(SATFIND_ENABLE_LTO "Enable link-time optimization" OFF)
+set(SATFIND_PGO "" CACHE STRING "Profile-guided optimization phase (empty, GENERATE or USE)")
+set_property(CACHE SATFIND_PGO PROPERTY STRINGS "" GENERATE USE)
+set(SATFIND_PGO_DIR "${PROJECT_BINARY_DIR}/pgo-profile" CACHE PATH "Directory for the PGO profiles")
+
+add_library(satfind_build_options INTERFACE)
+
+if(SATFIND_NATIVE_ARCH)
+	if(CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+		target_compile_options(satfind_build_options INTERFACE -march=native)
+	else()
+		message(WARNING "SATFIND_NATIVE_ARCH is only supported with GCC and Clang")
+	endif()
+endif()
+
+if(SATFIND_ENABLE_LTO)
+	include(CheckIPOSupported)
+	check_ipo_supported(RESULT satfind_ipo_supported OUTPUT satfind_ipo_output LANGUAGES CXX)
+	if(satfind_ipo_supported)
+		set(SATFIND_LTO_ENABLED ON)
+	else()
+		message(WARNING "SATFIND_ENABLE_LTO: link-time optimization is not supported: ${satfind_ipo_output}")
+	endif()
+endif()
+
+if(SATFIND_PGO STREQUAL "GENERATE")
+	file(MAKE_DIRECTORY "${SATFIND_PGO_DIR}")
+	if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+		# 複数スレッドで伝搬するベンチマークでもカウンタが壊れないように, 可能な場合は原子的に更新する
+		set(satfind_pgo_flags -fprofile-generate -fprofile-update=prefer-atomic "-fprofile-dir=${SATFIND_PGO_DIR}")
+	elseif(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+		set(satfind_pgo_flags "-fprofile-generate=${SATFIND_PGO_DIR}")
+	endif()
+elseif(SATFIND_PGO STREQUAL "USE")
+	if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+		# 学習で実行されなかった関数は通常どおり最適化する (-fprofile-partial-training)
+		set(satfind_pgo_flags -fprofile-use -fprofile-partial-training -fprofile-correction -Wno-missing-profile
+							  "-fprofile-dir=${SATFIND_PGO_DIR}")
+	elseif(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+		set(satfind_pgo_flags "-fprofile-use=${SATFIND_PGO_DIR}/satfind.profdata" -Wno-profile-instr-unprofiled)
+	endif()
+elseif(NOT SATFIND_PGO STREQUAL "")
+	message(FATAL_ERROR "SATFIND_PGO must be empty, GENERATE or USE (got '${SATFIND_PGO}')")
+endif()
+
+if(NOT SATFIND_PGO STREQUAL "")
+	if(NOT satfind_pgo_flags)
+		message(WARNING "SATFIND_PGO is only supported with GCC and Clang")
+	endif()
+	target_compile_options(satfind_build_options INTERFACE ${satfind_pgo_flags})
+	target_link_options(satfind_build_options INTERFACE ${satfind_pgo_flags})
+endif()
+
+# target に最適化の設定を適用する
+function(satfind_apply_build_options target)
+	target_link_libraries(${target} PRIVATE $<BUILD_INTERFACE:satfind_build_options>)
+	if(SATFIND_LTO_ENABLED)
+		set_target_properties(${target} PROPERTIES INTERPROCEDURAL_OPTIMIZATION ON)
+	endif()
+endfunction()